@@ -0,0 +1,567 @@
+///////////////////////
+//
+// This compact linked list code provides the same functions as the
+// unrolled list, declared in LinkedList.h, and is used in place of
+// DoubleLinkedList.c when the list is built with LL_COMPACT defined.
+//
+// WHY?... On a 64 bit build a double linked list Node spends 16 bytes
+// on its next and prev pointers to carry a 4 byte int.  The compact
+// list shrinks the linkage in two ways:
+//
+//      - Nodes live in one array that grows by doubling, so a node is
+//        named by a 32 bit index instead of a 64 bit address, and
+//        there is no malloc (or malloc overhead) per node.
+//      - Each node keeps one link, the index of the node before it
+//        XOR'd with the index of the node after it.  Walking forwards
+//        we know where we came from, so
+//              next = Link ^ prev
+//        and walking backwards
+//              prev = Link ^ next
+//        The Head has no node before it (index 0), so its Link is just
+//        the index of the node after it, and the same for the Tail.
+//
+// Nodes are handed out from the array in order and given back to a
+// free chain that is used again first, so the nodes of a list stay
+// close together in memory.  When the list empties the whole array is
+// free again and is handed out from the start.
+//
+// Because a node does not know its neighbours on its own, a walk always
+// carries two indices, the node it is at and the node before it.
+// Anything that keeps a node's index for later (the Finger) keeps both.
+//
+// NOTE:: the array moves when it grows, so the code only ever holds
+// indices across a call that may add a node, never node addresses.
+//
+///////////////////////
+
+// stdlib provides the definition of NULL and the declarations for
+// malloc(), realloc() and free()
+#include <stdlib.h>
+// assert is used to check the calls are valid
+#include <assert.h>
+// The list needs UserData to know what each node holds
+#include "UserData.h"
+// LinkedList.h declares the functions callable for a linked list and,
+// with LL_COMPACT defined, pulls in the node array layout from CompactList.h
+#include "LinkedList.h"
+
+// locally called function declarations follow..
+//
+// TakeSlot is called to get an unused entry of the node array and returns its index
+static LLIndex TakeSlot (LLInfoPtr LLI_Ptr);
+
+// GiveBackSlot puts an entry that is no longer in the list on the free chain
+static void GiveBackSlot (LLInfoPtr LLI_Ptr, LLIndex Slot);
+
+// ReserveSlots makes sure the node array has room for Count more nodes
+static void ReserveSlots (LLInfoPtr LLI_Ptr, int Count);
+
+// GetSlotAtIndex is used to return the array index of the node at a list index
+static LLIndex GetSlotAtIndex (LLInfoPtr LLI_Ptr, int FetchIndex);
+
+// Externally callable functions for a user of the Linked List
+// follow
+
+/////////////
+// LL_Init is used to allocate and initialize a LinkedList
+// Information structure.  The node array is not allocated until the
+// first node is added.  It will update the memory account to reflect
+// the malloc of the struct and return the pointer to the struct for the
+// caller to use when calling any other function in the linked list
+/////////////
+LLInfoPtr LL_Init()
+{
+    // Allocate a Linked List Information structure
+    LLInfoPtr LLI_Ptr = (LLInfoPtr) malloc (sizeof (LLInfo));
+    assert (LLI_Ptr != NULL);
+    // Initialize the data in the struct just allocated.  Entry 0 of
+    // the array is never handed out, so Used starts at 1
+    LLI_Ptr->Nodes = NULL;
+    LLI_Ptr->Capacity = 0;
+    LLI_Ptr->Used = 1;
+    LLI_Ptr->FreeSlots = 0;
+    LLI_Ptr->Head = 0;
+    LLI_Ptr->Tail = 0;
+    LLI_Ptr->NumNodesInList = 0;
+    LLI_Ptr->Finger = 0;
+    LLI_Ptr->FingerPrev = 0;
+    LLI_Ptr->FingerIndex = 0;
+    // update the memory account to reflect the malloc
+    MA_Allocated (MA_LL_INFO, sizeof (LLInfo));
+    // return the pointer to the allocated struct to the caller
+    return LLI_Ptr;
+}
+
+/////////////
+// LL_Delete is called to delete the Linked List identified by LL_Ptr.
+// All the nodes are in the one array, so it is freed with a single
+// call, then the LinkedList information struct is freed and the
+// memory account updated to reflect the memory release.
+/////////////
+LLInfoPtr LL_Delete(LLInfoPtr LLI_Ptr)
+{
+    // We should not have been called if the Linked List
+    // Information structure does not exist
+    assert (LLI_Ptr != NULL);
+    if (LLI_Ptr->Nodes != NULL) {
+        free (LLI_Ptr->Nodes);
+        MA_Released (MA_LIST_NODE, LLI_Ptr->Capacity * sizeof (CompactNode));
+    }
+    free(LLI_Ptr);
+    LLI_Ptr = NULL;
+    MA_Released (MA_LL_INFO, sizeof (LLInfo));
+    // return a NULL because the list structure no longer exists
+    return NULL;
+}
+
+/////////////
+// LL_AddAtFront is called to add the UserData to the front of the list.
+// The new node has no node before it, so its Link is the old Head.  The
+// old Head's Link had 0 for the node before it and now has the new node,
+// which XORing in the new node's index does.
+/////////////
+void LL_AddAtFront (LLInfoPtr LLI_Ptr, UserData theData)
+{
+    *LL_EmplaceFront (LLI_Ptr) = theData;
+}
+
+/////////////
+// LL_EmplaceFront links a new node in at the front of the list, just
+// as LL_AddAtFront does, and returns the address of its UserData for
+// the caller to fill in place.
+/////////////
+UserData *LL_EmplaceFront (LLInfoPtr LLI_Ptr)
+{
+    // We should not have been called if the Linked List
+    // Information structure does not exist
+    assert (LLI_Ptr != NULL);
+    LLIndex NewNode = TakeSlot (LLI_Ptr);
+    CompactNodePtr Nodes = LLI_Ptr->Nodes;
+    Nodes[NewNode].Link = LLI_Ptr->Head;
+    if (LLI_Ptr->Head != 0)
+        Nodes[LLI_Ptr->Head].Link ^= NewNode;
+    else
+        LLI_Ptr->Tail = NewNode;
+    // the Finger keeps the node before it, which changes if it was the Head
+    if (LLI_Ptr->Finger != 0 && LLI_Ptr->Finger == LLI_Ptr->Head)
+        LLI_Ptr->FingerPrev = NewNode;
+    LLI_Ptr->Head = NewNode;
+    // every node already in the list is now one index further along
+    LLI_Ptr->FingerIndex++;
+    LLI_Ptr->NumNodesInList++;
+    return &Nodes[NewNode].Data;
+}
+
+/////////////
+// LL_AddAtEnd is called to add the UserData to the end of the list.
+// It is LL_AddAtFront from the other end: the new node's Link is the
+// old Tail and the old Tail gains the new node as the node after it.
+/////////////
+void LL_AddAtEnd (LLInfoPtr LLI_Ptr, UserData theData)
+{
+    *LL_EmplaceEnd (LLI_Ptr) = theData;
+}
+
+/////////////
+// LL_EmplaceEnd links a new node in at the end of the list, just as
+// LL_AddAtEnd does, and returns the address of its UserData for the
+// caller to fill in place.
+/////////////
+UserData *LL_EmplaceEnd (LLInfoPtr LLI_Ptr)
+{
+    // We should not have been called if the Linked List
+    // Information structure does not exist
+    assert (LLI_Ptr != NULL);
+    LLIndex NewNode = TakeSlot (LLI_Ptr);
+    CompactNodePtr Nodes = LLI_Ptr->Nodes;
+    Nodes[NewNode].Link = LLI_Ptr->Tail;
+    if (LLI_Ptr->Tail != 0)
+        Nodes[LLI_Ptr->Tail].Link ^= NewNode;
+    else
+        LLI_Ptr->Head = NewNode;
+    LLI_Ptr->Tail = NewNode;
+    LLI_Ptr->NumNodesInList++;
+    return &Nodes[NewNode].Data;
+}
+
+/////////////
+// LL_GetFront returns the UserData at the front of the list.  When
+// asked to delete it, the node after the Head becomes the Head (its Link
+// loses the old Head) and the old Head's entry goes on the free chain.
+/////////////
+UserData LL_GetFront (LLInfoPtr LLI_Ptr, ShouldDelete Choice)
+{
+    // We should not have been called if the Linked List
+    // Information structure does not exist or if the list is empty
+    assert (LLI_Ptr != NULL);
+    assert (LLI_Ptr->NumNodesInList > 0);
+    assert ((Choice == DELETE_NODE) || (Choice == RETAIN_NODE));
+    CompactNodePtr Nodes = LLI_Ptr->Nodes;
+    LLIndex OldHead = LLI_Ptr->Head;
+    UserData theData = Nodes[OldHead].Data;
+    if (Choice == DELETE_NODE) {
+        // the Head has no node before it, so its Link is the node after it
+        LLIndex NewHead = Nodes[OldHead].Link;
+        if (NewHead != 0)
+            Nodes[NewHead].Link ^= OldHead;
+        else
+            LLI_Ptr->Tail = 0;
+        LLI_Ptr->Head = NewHead;
+        // forget the Finger if it was the node removed, otherwise it
+        // is one index closer to the front
+        if (LLI_Ptr->Finger == OldHead)
+            LLI_Ptr->Finger = 0;
+        else if (LLI_Ptr->FingerPrev == OldHead)
+            LLI_Ptr->FingerPrev = 0;
+        LLI_Ptr->FingerIndex--;
+        LLI_Ptr->NumNodesInList--;
+        GiveBackSlot (LLI_Ptr, OldHead);
+    }
+    return theData;
+}
+
+/////////////
+// LL_Length returns the number of nodes in the underlying LL.
+// It allows calls to be made even if the underlying LL does not
+// exist, returning a count of zero under this condition
+/////////////
+int  LL_Length  (LLInfoPtr LLI_Ptr)
+{
+    return (LLI_Ptr == NULL) ? 0 : LLI_Ptr->NumNodesInList;
+}
+
+/////////////
+// LL_GetAtIndex returns the UserData at the index (0 is the front)
+/////////////
+UserData  LL_GetAtIndex (LLInfoPtr LLI_Ptr, int FetchIndex)
+{
+    return LLI_Ptr->Nodes[GetSlotAtIndex (LLI_Ptr, FetchIndex)].Data;
+}
+
+/////////////
+// LL_SetAtIndex updates the UserData at the index (0 is the front)
+/////////////
+void  LL_SetAtIndex (LLInfoPtr LLI_Ptr, UserData D, int UpdateIndex)
+{
+    LLI_Ptr->Nodes[GetSlotAtIndex (LLI_Ptr, UpdateIndex)].Data = D;
+}
+
+/////////////
+// LL_Swap swaps the UserData at the two indices.  Finding the second
+// one cannot add a node, so the first index found stays good.
+/////////////
+void  LL_Swap (LLInfoPtr LLI_Ptr, int Index1, int Index2)
+{
+    LLIndex Slot1 = GetSlotAtIndex (LLI_Ptr, Index1);
+    LLIndex Slot2 = GetSlotAtIndex (LLI_Ptr, Index2);
+    UserData Temp = LLI_Ptr->Nodes[Slot1].Data;
+    LLI_Ptr->Nodes[Slot1].Data = LLI_Ptr->Nodes[Slot2].Data;
+    LLI_Ptr->Nodes[Slot2].Data = Temp;
+}
+
+/////////////
+// LL_InsertAtIndex adds theData so that it ends up at InsertIndex,
+// moving the nodes from there on one index along.  InsertIndex may be
+// the length of the list, which adds at the end.
+// Finding the node now at InsertIndex also gives the node before it,
+// and the new node goes between the two: its Link is the pair of them,
+// and in each of their Links the other is swapped for the new node.
+// The new node becomes the Finger.
+/////////////
+void LL_InsertAtIndex (LLInfoPtr LLI_Ptr, UserData theData, int InsertIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((InsertIndex >= 0) && (InsertIndex <= LLI_Ptr->NumNodesInList) );
+    // the ends of the list are already handled, including an empty list
+    if (InsertIndex == 0) {
+        LL_AddAtFront (LLI_Ptr, theData);
+        return;
+    }
+    if (InsertIndex == LLI_Ptr->NumNodesInList) {
+        LL_AddAtEnd (LLI_Ptr, theData);
+        return;
+    }
+    LLIndex After = GetSlotAtIndex (LLI_Ptr, InsertIndex);
+    LLIndex Before = LLI_Ptr->FingerPrev;
+    // taking a slot may move the array, so only look at it afterwards
+    LLIndex NewNode = TakeSlot (LLI_Ptr);
+    CompactNodePtr Nodes = LLI_Ptr->Nodes;
+    Nodes[NewNode].Data = theData;
+    Nodes[NewNode].Link = Before ^ After;
+    Nodes[Before].Link ^= After ^ NewNode;
+    Nodes[After].Link ^= Before ^ NewNode;
+    LLI_Ptr->Finger = NewNode;
+    LLI_Ptr->FingerPrev = Before;
+    LLI_Ptr->NumNodesInList++;
+}
+
+/////////////
+// LL_RemoveAtIndex removes the node at RemoveIndex, moving the nodes
+// after it one index closer to the front, and returns its UserData.
+// The nodes either side of it swap it for each other in their Links
+// (the Tail moves back if there is none after it), and the node that
+// followed it becomes the Finger.
+/////////////
+UserData LL_RemoveAtIndex (LLInfoPtr LLI_Ptr, int RemoveIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((RemoveIndex >= 0) && (RemoveIndex < LLI_Ptr->NumNodesInList) );
+    // the front is already handled, including the last node
+    if (RemoveIndex == 0)
+        return LL_GetFront (LLI_Ptr, DELETE_NODE);
+    LLIndex OldNode = GetSlotAtIndex (LLI_Ptr, RemoveIndex);
+    LLIndex Before = LLI_Ptr->FingerPrev;
+    CompactNodePtr Nodes = LLI_Ptr->Nodes;
+    LLIndex After = Nodes[OldNode].Link ^ Before;
+    UserData theData = Nodes[OldNode].Data;
+    Nodes[Before].Link ^= OldNode ^ After;
+    if (After != 0)
+        Nodes[After].Link ^= OldNode ^ Before;
+    else
+        LLI_Ptr->Tail = Before;
+    // the node after takes over the removed node's index
+    LLI_Ptr->Finger = After;
+    LLI_Ptr->FingerPrev = Before;
+    LLI_Ptr->NumNodesInList--;
+    GiveBackSlot (LLI_Ptr, OldNode);
+    return theData;
+}
+
+/////////////
+// LL_PeekFrontPtr returns the address of the UserData at the front of
+// the list instead of a copy of it
+/////////////
+UserData *LL_PeekFrontPtr (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    assert (LLI_Ptr->NumNodesInList > 0);
+    return &LLI_Ptr->Nodes[LLI_Ptr->Head].Data;
+}
+
+/////////////
+// LL_AtIndexPtr returns the address of the UserData at the index
+// instead of a copy of it
+/////////////
+UserData *LL_AtIndexPtr (LLInfoPtr LLI_Ptr, int FetchIndex)
+{
+    return &LLI_Ptr->Nodes[GetSlotAtIndex (LLI_Ptr, FetchIndex)].Data;
+}
+
+/////////////
+// LL_AddAtEndBatch is called to add Count UserData from the array
+// Data to the end of the list, in array order.  The node array is grown
+// once for all of them, so they are handed out side by side.
+/////////////
+void LL_AddAtEndBatch (LLInfoPtr LLI_Ptr, const UserData *Data, int Count)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Count >= 0 && (Data != NULL || Count == 0));
+    ReserveSlots (LLI_Ptr, Count);
+    for (int i = 0; i < Count; i++)
+        LL_AddAtEnd (LLI_Ptr, Data[i]);
+}
+
+/////////////
+// LL_AddAtFrontBatch is called to add Count UserData from the array
+// Data to the front of the list.  The result is the same as calling
+// LL_AddAtFront for Data[0] up to Data[Count-1], so the array ends up
+// reversed: Data[Count-1] becomes the first UserData in the list.
+/////////////
+void LL_AddAtFrontBatch (LLInfoPtr LLI_Ptr, const UserData *Data, int Count)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Count >= 0 && (Data != NULL || Count == 0));
+    ReserveSlots (LLI_Ptr, Count);
+    for (int i = 0; i < Count; i++)
+        LL_AddAtFront (LLI_Ptr, Data[i]);
+}
+
+/////////////
+// LL_DrainFront is called to remove up to MaxCount UserData from the
+// front of the list, copying them into Out in list order.
+// It returns the number of UserData removed.
+/////////////
+int LL_DrainFront (LLInfoPtr LLI_Ptr, UserData *Out, int MaxCount)
+{
+    assert (LLI_Ptr != NULL);
+    assert (MaxCount >= 0 && (Out != NULL || MaxCount == 0));
+    int Drained = 0;
+    while (Drained < MaxCount && LLI_Ptr->NumNodesInList > 0)
+        Out[Drained++] = LL_GetFront (LLI_Ptr, DELETE_NODE);
+    return Drained;
+}
+
+/////////////
+// LL_ToArray copies up to MaxCount UserData, starting at the front of
+// the list, into Out.  The list is not changed.
+// It returns the number of UserData copied.
+/////////////
+int LL_ToArray (LLInfoPtr LLI_Ptr, UserData *Out, int MaxCount)
+{
+    assert (LLI_Ptr != NULL);
+    assert (MaxCount >= 0 && (Out != NULL || MaxCount == 0));
+    CompactNodePtr Nodes = LLI_Ptr->Nodes;
+    int Copied = 0;
+    LLIndex prev = 0;
+    LLIndex curr = LLI_Ptr->Head;
+    while (curr != 0 && Copied < MaxCount) {
+        Out[Copied++] = Nodes[curr].Data;
+        LLIndex nextNode = Nodes[curr].Link ^ prev;
+        prev = curr;
+        curr = nextNode;
+    }
+    return Copied;
+}
+
+/////////////
+// LL_FromArray makes a new list holding the Count UserData in the
+// array Data, in array order.  The caller deletes it with LL_Delete
+// just like a list made by LL_Init.
+/////////////
+LLInfoPtr LL_FromArray (const UserData *Data, int Count)
+{
+    LLInfoPtr LLI_Ptr = LL_Init();
+    LL_AddAtEndBatch (LLI_Ptr, Data, Count);
+    return LLI_Ptr;
+}
+
+/////////////
+// LL_ForEach calls Visit for each UserData from the Head to the Tail,
+// passing its address and the caller's Context.  Visit may update the
+// UserData but must not add or delete any.
+/////////////
+void LL_ForEach (LLInfoPtr LLI_Ptr, LLVisitor Visit, void *Context)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Visit != NULL);
+    CompactNodePtr Nodes = LLI_Ptr->Nodes;
+    LLIndex prev = 0;
+    LLIndex curr = LLI_Ptr->Head;
+    while (curr != 0) {
+        Visit (&Nodes[curr].Data, Context);
+        LLIndex nextNode = Nodes[curr].Link ^ prev;
+        prev = curr;
+        curr = nextNode;
+    }
+}
+
+/////////////
+// Local function TakeSlot hands out an entry of the node array.  An
+// entry from the free chain is used first; otherwise the next never
+// used entry is, doubling the array first if it is full.
+// The caller sets the entry's Data and Link.
+/////////////
+LLIndex TakeSlot (LLInfoPtr LLI_Ptr)
+{
+    LLIndex Slot = LLI_Ptr->FreeSlots;
+    if (Slot != 0)
+        LLI_Ptr->FreeSlots = LLI_Ptr->Nodes[Slot].Link;
+    else {
+        ReserveSlots (LLI_Ptr, 1);
+        Slot = LLI_Ptr->Used++;
+    }
+    return Slot;
+}
+
+/////////////
+// Local function GiveBackSlot puts an entry that has been unlinked from
+// the list on the free chain.  Once the list is empty every entry is
+// free, so the chain is dropped and the array is handed out from the
+// start again, keeping the next nodes side by side.
+/////////////
+void GiveBackSlot (LLInfoPtr LLI_Ptr, LLIndex Slot)
+{
+    if (LLI_Ptr->NumNodesInList == 0) {
+        LLI_Ptr->Used = 1;
+        LLI_Ptr->FreeSlots = 0;
+        LLI_Ptr->Finger = 0;
+        return;
+    }
+    LLI_Ptr->Nodes[Slot].Link = LLI_Ptr->FreeSlots;
+    LLI_Ptr->FreeSlots = Slot;
+}
+
+/////////////
+// Local function ReserveSlots makes sure Count more entries can be
+// handed out after the last one used without growing the array, by
+// doubling its size until they fit.  The first array is malloc'd
+// (counted as one list node allocation); growing it is a realloc.
+/////////////
+void ReserveSlots (LLInfoPtr LLI_Ptr, int Count)
+{
+    assert (Count >= 0);
+    uint64_t Needed = (uint64_t) LLI_Ptr->Used + (uint64_t) Count;
+    if (Needed <= LLI_Ptr->Capacity)
+        return;
+    uint64_t NewCapacity = (LLI_Ptr->Capacity != 0) ? LLI_Ptr->Capacity : COMPACT_INITIAL_CAPACITY;
+    while (NewCapacity < Needed)
+        NewCapacity *= 2;
+    // every index has to fit in an LLIndex
+    assert (NewCapacity <= UINT32_MAX);
+    CompactNodePtr NewNodes = (CompactNodePtr) realloc (LLI_Ptr->Nodes, NewCapacity * sizeof (CompactNode));
+    assert (NewNodes != NULL);
+    if (LLI_Ptr->Nodes == NULL)
+        MA_Allocated (MA_LIST_NODE, NewCapacity * sizeof (CompactNode));
+    else
+        MA_Resized (MA_LIST_NODE, LLI_Ptr->Capacity * sizeof (CompactNode), NewCapacity * sizeof (CompactNode));
+    LLI_Ptr->Nodes = NewNodes;
+    LLI_Ptr->Capacity = (LLIndex) NewCapacity;
+}
+
+/////////////
+// GetSlotAtIndex is a utility function that will locate the node at
+// FetchIndex and return its index in the node array.
+// It starts from whichever of the Head, the Tail or the Finger is
+// closest.  Wherever it is, it knows the node it is at (curr) and the
+// node before it (prev):
+//      stepping forwards   next = Link[curr] ^ prev, then prev = curr, curr = next
+//      stepping backwards  the new curr is prev and its prev is Link[prev] ^ curr
+// The node found becomes the new Finger, with the node before it.
+/////////////
+LLIndex GetSlotAtIndex (LLInfoPtr LLI_Ptr, int FetchIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((FetchIndex >= 0) && (FetchIndex < LLI_Ptr->NumNodesInList) );
+    CompactNodePtr Nodes = LLI_Ptr->Nodes;
+
+    // Start by assuming the Head or Tail is closest.  The Tail has no
+    // node after it, so the node before it is its Link.
+    LLIndex curr = LLI_Ptr->Head;
+    LLIndex prev = 0;
+    int at = 0;
+    int distance = FetchIndex;
+    if (LLI_Ptr->NumNodesInList - 1 - FetchIndex < distance) {
+        curr = LLI_Ptr->Tail;
+        prev = Nodes[curr].Link;
+        at = LLI_Ptr->NumNodesInList - 1;
+        distance = at - FetchIndex;
+    }
+    // then see if the Finger is closer still
+    if (LLI_Ptr->Finger != 0) {
+        int FingerDistance = abs (FetchIndex - LLI_Ptr->FingerIndex);
+        if (FingerDistance < distance) {
+            curr = LLI_Ptr->Finger;
+            prev = LLI_Ptr->FingerPrev;
+            at = LLI_Ptr->FingerIndex;
+        }
+    }
+    while (at < FetchIndex) {
+        LLIndex nextNode = Nodes[curr].Link ^ prev;
+        prev = curr;
+        curr = nextNode;
+        at++;
+    }
+    while (at > FetchIndex) {
+        LLIndex prevPrev = Nodes[prev].Link ^ curr;
+        curr = prev;
+        prev = prevPrev;
+        at--;
+    }
+    LLI_Ptr->Finger = curr;
+    LLI_Ptr->FingerPrev = prev;
+    LLI_Ptr->FingerIndex = FetchIndex;
+    return curr;
+}
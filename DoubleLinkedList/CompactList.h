@@ -0,0 +1,58 @@
+#ifndef COMPACTLIST_H_INCLUDED
+#define COMPACTLIST_H_INCLUDED
+
+// CompactList.h is included by LinkedList.h when the list is built
+// with LL_COMPACT defined.  It describes how the compact list stores
+// UserData; the functions used to work with the list are still the ones
+// declared in LinkedList.h
+
+// The compact list uses UserData
+#include "UserData.h"
+// LLIndex is a 32 bit unsigned number
+#include <stdint.h>
+
+// COMPACT_INITIAL_CAPACITY is the number of nodes the node array first
+// has room for; it doubles each time it fills.  It can be changed at
+// build time with -DCOMPACT_INITIAL_CAPACITY=n
+#ifndef COMPACT_INITIAL_CAPACITY
+#define COMPACT_INITIAL_CAPACITY 16
+#endif
+
+// The nodes of the compact list live in one array and are found by their
+// index in it rather than by address.  Index 0 is never used for a node,
+// so 0 means "no node", the way NULL does in the double linked list.
+typedef uint32_t LLIndex;
+
+// A compact node keeps a single link: the index of the node before it
+// XOR'd with the index of the node after it.  Knowing either neighbour
+// gives the other, so walking from either end needs no more than this.
+// On a 64 bit build with an int payload this is 8 bytes instead of the
+// 24 bytes of a double linked list Node.
+typedef struct
+{
+    UserData Data;
+    LLIndex  Link;
+} CompactNode, *CompactNodePtr;
+
+// A LL Information block holds the node array and the indices of the
+// Head and Tail nodes with the running count of nodes in the list.
+// Capacity is the number of entries in Nodes and Used is one past the
+// highest entry ever handed out.  Entries between that were given back
+// are chained through their Link starting at FreeSlots.
+// Finger remembers the node last located by index, FingerPrev the node
+// before it (needed to walk on from an XOR link) and FingerIndex its
+// index.  Finger is 0 when there is no remembered node.
+typedef struct {
+    CompactNodePtr Nodes;
+    LLIndex        Capacity;
+    LLIndex        Used;
+    LLIndex        FreeSlots;
+    LLIndex        Head;
+    LLIndex        Tail;
+    int            NumNodesInList;
+    LLIndex        Finger;
+    LLIndex        FingerPrev;
+    int            FingerIndex;
+    } LLInfo, *LLInfoPtr;
+
+#endif // COMPACTLIST_H_INCLUDED
@@ -0,0 +1,298 @@
+///////////////////////
+//
+// This concurrent list code is the doubly linked list with a lock in
+// every node, so that threads working at different places in the list
+// do not wait for each other.
+//
+// The list always has a Head and a Tail sentinel, so adding or removing
+// a real node never changes the LLInfo itself and every real node has a
+// node on each side of it to lock.  To change links, a call locks each
+// node whose next or prev it changes.  So that no two threads can each
+// hold a lock the other is waiting for:
+//      - locks are only waited for in list order, Head towards Tail, and
+//      - a lock wanted against that order (the node before the Tail when
+//        adding or removing at the end) is only tried.  If it is busy,
+//        every lock held is let go and the call starts over.
+// A node is only reached by holding the lock of a node next to it, so
+// once a removed node is unlocked no other thread can be about to lock
+// it, and it can be freed at once.
+//
+///////////////////////
+
+// stdlib provides malloc and free
+#include <stdlib.h>
+// assert checks the arguments, like the rest of the list code
+#include <assert.h>
+// sched_yield lets the thread holding a lock run before a retry
+#include <sched.h>
+// ConcurrentList.h defines CNode and CLLInfo and declares the functions
+#include "ConcurrentList.h"
+
+// locally called function declarations follow..
+//
+// MakeCNode allocates a node holding theData with its lock ready
+static CNodePtr MakeCNode (UserData theData);
+
+// FreeCNode frees a node that is unlocked and in no list
+static void FreeCNode (CNodePtr theNode);
+
+// LockEnd locks the Tail and the node before it, which it returns
+static CNodePtr LockEnd (CLLInfoPtr CLLI_Ptr);
+
+// LockAtIndex walks hand over hand to the node at the index and returns
+// it locked, or returns NULL if the list is not that long
+static CNodePtr LockAtIndex (CLLInfoPtr CLLI_Ptr, int Index);
+
+/////////////
+// CLL_Init allocates a concurrent LinkedList Information structure
+// and links its Head and Tail sentinels to each other.  It updates the
+// memory account to reflect the malloc.
+/////////////
+CLLInfoPtr CLL_Init ()
+{
+    CLLInfoPtr CLLI_Ptr = (CLLInfoPtr) malloc (sizeof (CLLInfo));
+    assert (CLLI_Ptr != NULL);
+    CLLI_Ptr->Head.prev = NULL;
+    CLLI_Ptr->Head.next = &CLLI_Ptr->Tail;
+    CLLI_Ptr->Tail.prev = &CLLI_Ptr->Head;
+    CLLI_Ptr->Tail.next = NULL;
+    pthread_mutex_init (&CLLI_Ptr->Head.Lock, NULL);
+    pthread_mutex_init (&CLLI_Ptr->Tail.Lock, NULL);
+    atomic_init (&CLLI_Ptr->NumNodesInList, 0);
+    MA_Allocated (MA_LL_INFO, sizeof (CLLInfo));
+    return CLLI_Ptr;
+}
+
+/////////////
+// CLL_Delete frees every node between the sentinels and then the
+// information structure.  No other thread can be using the list, so
+// nothing is locked.
+/////////////
+CLLInfoPtr CLL_Delete (CLLInfoPtr CLLI_Ptr)
+{
+    assert (CLLI_Ptr != NULL);
+    CNodePtr curr = CLLI_Ptr->Head.next;
+    while (curr != &CLLI_Ptr->Tail) {
+        CNodePtr nextNode = curr->next;
+        FreeCNode (curr);
+        curr = nextNode;
+    }
+    pthread_mutex_destroy (&CLLI_Ptr->Head.Lock);
+    pthread_mutex_destroy (&CLLI_Ptr->Tail.Lock);
+    free (CLLI_Ptr);
+    MA_Released (MA_LL_INFO, sizeof (CLLInfo));
+    return NULL;
+}
+
+/////////////
+// CLL_AddAtFront links a new node between the Head and the first node.
+// Only the head lock and the first node (or the Tail) are locked.
+/////////////
+void CLL_AddAtFront (CLLInfoPtr CLLI_Ptr, UserData theData)
+{
+    assert (CLLI_Ptr != NULL);
+    CNodePtr NewNode = MakeCNode (theData);
+    pthread_mutex_lock (&CLLI_Ptr->Head.Lock);
+    // Head.next only changes under the head lock, so it cannot go away
+    CNodePtr First = CLLI_Ptr->Head.next;
+    pthread_mutex_lock (&First->Lock);
+    NewNode->prev = &CLLI_Ptr->Head;
+    NewNode->next = First;
+    First->prev = NewNode;
+    CLLI_Ptr->Head.next = NewNode;
+    atomic_fetch_add (&CLLI_Ptr->NumNodesInList, 1);
+    pthread_mutex_unlock (&First->Lock);
+    pthread_mutex_unlock (&CLLI_Ptr->Head.Lock);
+}
+
+/////////////
+// CLL_AddAtEnd links a new node between the last node and the Tail.
+// Only the tail lock and the last node (or the Head) are locked.
+/////////////
+void CLL_AddAtEnd (CLLInfoPtr CLLI_Ptr, UserData theData)
+{
+    assert (CLLI_Ptr != NULL);
+    CNodePtr NewNode = MakeCNode (theData);
+    CNodePtr Last = LockEnd (CLLI_Ptr);
+    NewNode->prev = Last;
+    NewNode->next = &CLLI_Ptr->Tail;
+    Last->next = NewNode;
+    CLLI_Ptr->Tail.prev = NewNode;
+    atomic_fetch_add (&CLLI_Ptr->NumNodesInList, 1);
+    pthread_mutex_unlock (&Last->Lock);
+    pthread_mutex_unlock (&CLLI_Ptr->Tail.Lock);
+}
+
+/////////////
+// CLL_GetFront locks the Head, the first node and the node after it,
+// unlinks the first node and frees it once the locks are let go
+/////////////
+bool CLL_GetFront (CLLInfoPtr CLLI_Ptr, UserData *Data)
+{
+    assert (CLLI_Ptr != NULL);
+    assert (Data != NULL);
+    pthread_mutex_lock (&CLLI_Ptr->Head.Lock);
+    CNodePtr First = CLLI_Ptr->Head.next;
+    if (First == &CLLI_Ptr->Tail) {
+        pthread_mutex_unlock (&CLLI_Ptr->Head.Lock);
+        return false;
+    }
+    pthread_mutex_lock (&First->Lock);
+    // First->next only changes under First's lock, which we hold
+    CNodePtr Second = First->next;
+    pthread_mutex_lock (&Second->Lock);
+    CLLI_Ptr->Head.next = Second;
+    Second->prev = &CLLI_Ptr->Head;
+    atomic_fetch_sub (&CLLI_Ptr->NumNodesInList, 1);
+    pthread_mutex_unlock (&Second->Lock);
+    pthread_mutex_unlock (&First->Lock);
+    pthread_mutex_unlock (&CLLI_Ptr->Head.Lock);
+    *Data = First->Data;
+    FreeCNode (First);
+    return true;
+}
+
+/////////////
+// CLL_GetEnd locks the Tail, the last node and the node before it,
+// unlinks the last node and frees it once the locks are let go.  The
+// node before the last is against list order, so it is only tried and
+// everything is let go and retried if it is busy.
+/////////////
+bool CLL_GetEnd (CLLInfoPtr CLLI_Ptr, UserData *Data)
+{
+    assert (CLLI_Ptr != NULL);
+    assert (Data != NULL);
+    for (;;) {
+        CNodePtr Last = LockEnd (CLLI_Ptr);
+        if (Last == &CLLI_Ptr->Head) {
+            pthread_mutex_unlock (&Last->Lock);
+            pthread_mutex_unlock (&CLLI_Ptr->Tail.Lock);
+            return false;
+        }
+        // Last->prev only changes under Last's lock, which we hold
+        CNodePtr Before = Last->prev;
+        if (pthread_mutex_trylock (&Before->Lock) == 0) {
+            Before->next = &CLLI_Ptr->Tail;
+            CLLI_Ptr->Tail.prev = Before;
+            atomic_fetch_sub (&CLLI_Ptr->NumNodesInList, 1);
+            pthread_mutex_unlock (&Before->Lock);
+            pthread_mutex_unlock (&Last->Lock);
+            pthread_mutex_unlock (&CLLI_Ptr->Tail.Lock);
+            *Data = Last->Data;
+            FreeCNode (Last);
+            return true;
+        }
+        pthread_mutex_unlock (&Last->Lock);
+        pthread_mutex_unlock (&CLLI_Ptr->Tail.Lock);
+        sched_yield ();
+    }
+}
+
+/////////////
+// CLL_GetAtIndex walks hand over hand to the node at the index and
+// copies its UserData while the node is locked
+/////////////
+bool CLL_GetAtIndex (CLLInfoPtr CLLI_Ptr, int FetchIndex, UserData *Data)
+{
+    assert (CLLI_Ptr != NULL);
+    assert (Data != NULL);
+    CNodePtr theNode = LockAtIndex (CLLI_Ptr, FetchIndex);
+    if (theNode == NULL)
+        return false;
+    *Data = theNode->Data;
+    pthread_mutex_unlock (&theNode->Lock);
+    return true;
+}
+
+/////////////
+// CLL_SetAtIndex walks hand over hand to the node at the index and
+// replaces its UserData while the node is locked
+/////////////
+bool CLL_SetAtIndex (CLLInfoPtr CLLI_Ptr, UserData theData, int UpdateIndex)
+{
+    assert (CLLI_Ptr != NULL);
+    CNodePtr theNode = LockAtIndex (CLLI_Ptr, UpdateIndex);
+    if (theNode == NULL)
+        return false;
+    theNode->Data = theData;
+    pthread_mutex_unlock (&theNode->Lock);
+    return true;
+}
+
+/////////////
+// CLL_Length returns the running count of nodes in the list
+/////////////
+int CLL_Length (CLLInfoPtr CLLI_Ptr)
+{
+    assert (CLLI_Ptr != NULL);
+    return atomic_load (&CLLI_Ptr->NumNodesInList);
+}
+
+/////////////
+// Local function MakeCNode allocates a node, copies theData into it
+// and readies its lock.  The node is not linked until it is in a list.
+/////////////
+CNodePtr MakeCNode (UserData theData)
+{
+    CNodePtr NewNode = (CNodePtr) malloc (sizeof (CNode));
+    assert (NewNode != NULL);
+    NewNode->Data = theData;
+    NewNode->next = NULL;
+    NewNode->prev = NULL;
+    pthread_mutex_init (&NewNode->Lock, NULL);
+    MA_Allocated (MA_LIST_NODE, sizeof (CNode));
+    return NewNode;
+}
+
+/////////////
+// Local function FreeCNode destroys the node's lock and frees it
+/////////////
+void FreeCNode (CNodePtr theNode)
+{
+    pthread_mutex_destroy (&theNode->Lock);
+    free (theNode);
+    MA_Released (MA_LIST_NODE, sizeof (CNode));
+}
+
+/////////////
+// Local function LockEnd locks the Tail and then tries the node before
+// it, which is the Head when the list is empty.  Tail.prev only changes
+// under the tail lock, so the node cannot be removed while it is tried.
+// If it is busy the tail lock is let go, so that a thread holding that
+// node and waiting for the Tail can finish, and it is all tried again.
+/////////////
+CNodePtr LockEnd (CLLInfoPtr CLLI_Ptr)
+{
+    for (;;) {
+        pthread_mutex_lock (&CLLI_Ptr->Tail.Lock);
+        CNodePtr Last = CLLI_Ptr->Tail.prev;
+        if (pthread_mutex_trylock (&Last->Lock) == 0)
+            return Last;
+        pthread_mutex_unlock (&CLLI_Ptr->Tail.Lock);
+        sched_yield ();
+    }
+}
+
+/////////////
+// Local function LockAtIndex starts with the head lock and locks each
+// next node before letting go of the one it holds, until it holds the
+// node at the index.  If it reaches the Tail first it lets go and
+// returns NULL.
+/////////////
+CNodePtr LockAtIndex (CLLInfoPtr CLLI_Ptr, int Index)
+{
+    assert (Index >= 0);
+    CNodePtr curr = &CLLI_Ptr->Head;
+    pthread_mutex_lock (&curr->Lock);
+    for (int loop = 0; loop <= Index; loop++) {
+        CNodePtr nextNode = curr->next;
+        if (nextNode == &CLLI_Ptr->Tail) {
+            pthread_mutex_unlock (&curr->Lock);
+            return NULL;
+        }
+        pthread_mutex_lock (&nextNode->Lock);
+        pthread_mutex_unlock (&curr->Lock);
+        curr = nextNode;
+    }
+    return curr;
+}
@@ -0,0 +1,83 @@
+#ifndef CONCURRENTLIST_H_INCLUDED
+#define CONCURRENTLIST_H_INCLUDED
+
+// ConcurrentList.h is the concurrent variant of LinkedList.h.  Any number
+// of threads may call the CLL_ functions on the same list at once; the
+// list does its own locking, so the caller does not wrap the calls in a
+// mutex of its own.
+//
+// Every node has a lock, and the list starts and ends with a sentinel
+// node whose lock is the head lock or the tail lock.  A call only locks
+// the few nodes it changes, so on a list of 3 or more nodes
+// CLL_AddAtEnd (tail lock and last node) and CLL_GetFront (head lock and
+// first two nodes) never wait for each other.  CLL_GetAtIndex and
+// CLL_SetAtIndex walk from the head hand over hand: they lock the next
+// node before letting go of the one they hold, so a walk only ever
+// blocks the nodes right around it.
+//
+// CLL_Init and CLL_Delete are not called concurrently with anything else
+// on the same list.
+
+// The concurrent list uses UserData
+#include "UserData.h"
+#include <stdbool.h>
+// the node and list locks are pthread mutexes
+#include <pthread.h>
+// the node count is read without a lock
+#include <stdatomic.h>
+// the list nodes and information blocks are on the memory account
+#include "MemoryAccount.h"
+
+// A concurrent node is a Node with a lock.  Whoever changes a node's
+// next, prev or Data holds its lock.
+typedef struct cnode
+{
+    UserData         Data;
+    struct cnode    *next;
+    struct cnode    *prev;
+    pthread_mutex_t  Lock;
+} CNode, *CNodePtr;
+
+// A concurrent LL Information block holds the Head and Tail sentinels,
+// which are never removed, and the running count of nodes between them.
+// Head.Lock is the head lock and Tail.Lock the tail lock.
+typedef struct {
+    CNode      Head;
+    CNode      Tail;
+    atomic_int NumNodesInList;
+    } CLLInfo, *CLLInfoPtr;
+
+// CLL_Init allocates and initializes an empty concurrent LL
+CLLInfoPtr  CLL_Init        ();
+
+// CLL_Delete frees the LL and all of its nodes.  No other thread may be
+// using the LL.  It returns NULL
+CLLInfoPtr  CLL_Delete      (CLLInfoPtr CLLI_Ptr);
+
+// CLL_AddAtFront adds a node holding the UserData at the front of the LL
+void        CLL_AddAtFront  (CLLInfoPtr CLLI_Ptr, UserData theData);
+
+// CLL_AddAtEnd adds a node holding the UserData at the end of the LL
+void        CLL_AddAtEnd    (CLLInfoPtr CLLI_Ptr, UserData theData);
+
+// CLL_GetFront removes the front node, copies its UserData to Data and
+// returns true, or returns false if the LL was empty
+bool        CLL_GetFront    (CLLInfoPtr CLLI_Ptr, UserData *Data);
+
+// CLL_GetEnd removes the end node, copies its UserData to Data and
+// returns true, or returns false if the LL was empty
+bool        CLL_GetEnd      (CLLInfoPtr CLLI_Ptr, UserData *Data);
+
+// CLL_GetAtIndex copies the UserData at the index starting at 0 to Data
+// and returns true, or returns false if the LL is not that long
+bool        CLL_GetAtIndex  (CLLInfoPtr CLLI_Ptr, int FetchIndex, UserData *Data);
+
+// CLL_SetAtIndex replaces the UserData at the index starting at 0 and
+// returns true, or returns false if the LL is not that long
+bool        CLL_SetAtIndex  (CLLInfoPtr CLLI_Ptr, UserData theData, int UpdateIndex);
+
+// CLL_Length returns the number of nodes in the LL.  Other threads may
+// change it as soon as it is read
+int         CLL_Length      (CLLInfoPtr CLLI_Ptr);
+
+#endif // CONCURRENTLIST_H_INCLUDED
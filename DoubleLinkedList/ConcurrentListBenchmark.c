@@ -0,0 +1,128 @@
+//
+//  ConcurrentListBenchmark
+//
+//  This program times a queue-like workload on one list shared by a
+//  growing number of threads: half the threads add items at the end and
+//  the other half take them from the front.  It is run against
+//      the concurrent list    - CLL_AddAtEnd() and CLL_GetFront(), which
+//                               lock only the end of the list they change
+//      the doubly linked list - LL_AddAtEnd() and LL_GetFront() with one
+//                               mutex around every call
+//  The list starts with PREFILL items so that its two ends are far
+//  apart, and the run reports how many adds and takes a second each way
+//  manages.  With the single mutex every call waits for every other;
+//  with the concurrent list the adders and takers only wait for their
+//  own kind.
+
+// we use printf from stdio.h
+#include <stdio.h>
+// we use clock_gettime from time.h to time the runs by the wall clock
+#include <time.h>
+// the workers are pthreads
+#include <pthread.h>
+// we use both lists, so include the functions that we can call
+#include "LinkedList.h"
+#include "ConcurrentList.h"
+
+// The items in the list to start with and the adds or takes per thread
+#define PREFILL            1000
+#define OPS_PER_THREAD     200000
+#define MAX_THREADS        8
+
+// ListKind says which list a run uses
+typedef enum { CONCURRENT, ONE_MUTEX } ListKind;
+
+// The lists and the mutex used by the threads of a run
+static CLLInfoPtr      TheCLL;
+static LLInfoPtr       TheLL;
+static pthread_mutex_t TheLLMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// A Worker's argument says which list it uses and whether it adds or takes
+typedef struct {
+    ListKind Kind;
+    bool     Adds;
+} WorkerArg;
+
+// Worker does OPS_PER_THREAD adds at the end or takes from the front
+static void *Worker (void *Arg);
+
+// TimeRun returns the adds and takes per second for NumThreads threads
+static double TimeRun (ListKind Kind, int NumThreads);
+
+int main(int argc, const char * argv[]) {
+    printf ("%8s %22s %22s\n", "threads", "concurrent ops/s", "one mutex ops/s");
+    for (int NumThreads = 2; NumThreads <= MAX_THREADS; NumThreads *= 2)
+        printf ("%8d %22.0f %22.0f\n", NumThreads,
+                TimeRun (CONCURRENT, NumThreads), TimeRun (ONE_MUTEX, NumThreads));
+    printf ("The allocation count is now %d\n", AllocationCount);
+    return 0;
+}
+
+// function TimeRun fills a list with PREFILL items, starts the threads,
+// half adding and half taking, and times them until they all finish
+double TimeRun (ListKind Kind, int NumThreads)
+{
+    pthread_t Threads[MAX_THREADS];
+    WorkerArg Args[MAX_THREADS];
+    UserData D = {0};
+    if (Kind == CONCURRENT) {
+        TheCLL = CLL_Init();
+        for (int loop = 0; loop < PREFILL; loop++)
+            CLL_AddAtEnd (TheCLL, D);
+    }
+    else {
+        TheLL = LL_Init();
+        for (int loop = 0; loop < PREFILL; loop++)
+            LL_AddAtEnd (TheLL, D);
+    }
+    struct timespec Start, End;
+    clock_gettime (CLOCK_MONOTONIC, &Start);
+    for (int loop = 0; loop < NumThreads; loop++) {
+        Args[loop].Kind = Kind;
+        Args[loop].Adds = (loop % 2 == 0);
+        pthread_create (&Threads[loop], NULL, Worker, &Args[loop]);
+    }
+    for (int loop = 0; loop < NumThreads; loop++)
+        pthread_join (Threads[loop], NULL);
+    clock_gettime (CLOCK_MONOTONIC, &End);
+    if (Kind == CONCURRENT)
+        TheCLL = CLL_Delete (TheCLL);
+    else
+        TheLL = LL_Delete (TheLL);
+    double Seconds = (End.tv_sec - Start.tv_sec) + (End.tv_nsec - Start.tv_nsec) / 1e9;
+    return (double) NumThreads * OPS_PER_THREAD / Seconds;
+}
+
+// function Worker adds or takes OPS_PER_THREAD items.  A taker that
+// finds the list empty tries again, since the adders make as many items
+// as the takers take.
+void *Worker (void *Arg)
+{
+    WorkerArg *Work = (WorkerArg *) Arg;
+    UserData D = {0};
+    for (int loop = 0; loop < OPS_PER_THREAD; loop++) {
+        if (Work->Kind == CONCURRENT) {
+            if (Work->Adds)
+                CLL_AddAtEnd (TheCLL, D);
+            else
+                while (!CLL_GetFront (TheCLL, &D))
+                    ;
+        }
+        else {
+            bool Done = false;
+            while (!Done) {
+                pthread_mutex_lock (&TheLLMutex);
+                if (Work->Adds) {
+                    LL_AddAtEnd (TheLL, D);
+                    Done = true;
+                }
+                else if (LL_Length (TheLL) > 0) {
+                    D = LL_GetFront (TheLL, DELETE_NODE);
+                    Done = true;
+                }
+                pthread_mutex_unlock (&TheLLMutex);
+            }
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,201 @@
+//
+//  ConcurrentListTester
+//
+//  This is a stress test of the concurrent list functions, run from
+//  several threads at once on one list.  It checks that:
+//      Items added at both ends by producer threads - CLL_AddAtFront()
+//          and CLL_AddAtEnd() - are each taken off exactly once by
+//          consumer threads - CLL_GetFront() and CLL_GetEnd()
+//      Threads walking the list at the same time - CLL_GetAtIndex() -
+//          only ever see items that were added
+//      Threads updating disjoint indices - CLL_SetAtIndex() - while
+//          others read them leave every item with its own update
+//      Nothing is left allocated when the list is deleted
+//  The threads add up what went wrong - an item taken twice or never,
+//  a walk that read an item nobody added, an item holding another
+//  thread's update - and main prints the total.  The exit status is
+//  non-zero if that total, or the allocation count, is not 0.
+
+// we use printf from stdio.h
+#include <stdio.h>
+// we use calloc and free from stdlib.h for the seen counts
+#include <stdlib.h>
+// the workers are pthreads
+#include <pthread.h>
+// we use the concurrent list, so include its functions that we can call
+#include "ConcurrentList.h"
+
+// The number of threads of each kind and the items each producer adds
+#define NUM_PRODUCERS      4
+#define NUM_CONSUMERS      4
+#define NUM_WALKERS        2
+#define ITEMS_PER_PRODUCER 50000
+#define NUM_ITEMS          (NUM_PRODUCERS * ITEMS_PER_PRODUCER)
+
+// The number of nodes and updating threads in the update test
+#define NUM_UPDATE_NODES   2000
+#define NUM_UPDATERS       4
+
+// The list and counts shared by the threads of a test
+static CLLInfoPtr TheList;
+static atomic_int *Seen;
+static atomic_int ItemsTaken;
+static atomic_int ProducersDone;
+static atomic_int Errors;
+
+// Producer adds its ITEMS_PER_PRODUCER items, each num used once,
+// alternating between the front and the end
+static void *Producer (void *Arg);
+
+// Consumer takes items off either end until every item has been taken,
+// counting how often each num is seen
+static void *Consumer (void *Arg);
+
+// Walker reads items by index until the producers are done
+static void *Walker (void *Arg);
+
+// Updater sets every NUM_UPDATERS'th index, starting at its own, to
+// the index; UpdateReader checks what it reads meanwhile
+static void *Updater (void *Arg);
+static void *UpdateReader (void *Arg);
+
+int main(int argc, const char * argv[]) {
+    pthread_t Threads[NUM_PRODUCERS + NUM_CONSUMERS + NUM_WALKERS];
+    long ThreadNum[NUM_PRODUCERS + NUM_CONSUMERS + NUM_WALKERS];
+    int NumThreads = 0;
+
+    // the add and take test: producers, consumers and walkers at once
+    printf ("%d producers add %d items while %d consumers take them and %d walkers read\n",
+            NUM_PRODUCERS, NUM_ITEMS, NUM_CONSUMERS, NUM_WALKERS);
+    TheList = CLL_Init();
+    Seen = calloc (NUM_ITEMS, sizeof (atomic_int));
+    for (long loop = 0; loop < NUM_PRODUCERS; loop++, NumThreads++) {
+        ThreadNum[NumThreads] = loop;
+        pthread_create (&Threads[NumThreads], NULL, Producer, &ThreadNum[NumThreads]);
+    }
+    for (long loop = 0; loop < NUM_CONSUMERS; loop++, NumThreads++) {
+        ThreadNum[NumThreads] = loop;
+        pthread_create (&Threads[NumThreads], NULL, Consumer, &ThreadNum[NumThreads]);
+    }
+    for (long loop = 0; loop < NUM_WALKERS; loop++, NumThreads++) {
+        ThreadNum[NumThreads] = loop;
+        pthread_create (&Threads[NumThreads], NULL, Walker, &ThreadNum[NumThreads]);
+    }
+    for (int loop = 0; loop < NumThreads; loop++)
+        pthread_join (Threads[loop], NULL);
+    int Missed = 0;
+    for (int loop = 0; loop < NUM_ITEMS; loop++)
+        if (atomic_load (&Seen[loop]) != 1)
+            Missed++;
+    printf ("Items not taken exactly once: %d, items left in the list: %d\n",
+            Missed, CLL_Length (TheList));
+    Errors += Missed + CLL_Length (TheList);
+    free (Seen);
+    TheList = CLL_Delete (TheList);
+
+    // the update test: updaters and readers at once
+    printf ("%d updaters set %d items while as many readers read them\n",
+            NUM_UPDATERS, NUM_UPDATE_NODES);
+    TheList = CLL_Init();
+    for (int loop = 0; loop < NUM_UPDATE_NODES; loop++) {
+        UserData D = { -1 };
+        CLL_AddAtEnd (TheList, D);
+    }
+    NumThreads = 0;
+    for (long loop = 0; loop < NUM_UPDATERS; loop++, NumThreads++) {
+        ThreadNum[NumThreads] = loop;
+        pthread_create (&Threads[NumThreads], NULL, Updater, &ThreadNum[NumThreads]);
+    }
+    for (long loop = 0; loop < NUM_UPDATERS; loop++, NumThreads++) {
+        ThreadNum[NumThreads] = loop;
+        pthread_create (&Threads[NumThreads], NULL, UpdateReader, &ThreadNum[NumThreads]);
+    }
+    for (int loop = 0; loop < NumThreads; loop++)
+        pthread_join (Threads[loop], NULL);
+    int NotUpdated = 0;
+    for (int loop = 0; loop < NUM_UPDATE_NODES; loop++) {
+        UserData D;
+        if (!CLL_GetAtIndex (TheList, loop, &D) || D.num != loop)
+            NotUpdated++;
+    }
+    printf ("Items without their update: %d\n", NotUpdated);
+    Errors += NotUpdated;
+    TheList = CLL_Delete (TheList);
+
+    printf ("Errors: %d, the allocation count is now %d\n", atomic_load (&Errors), AllocationCount);
+    return (Errors == 0 && AllocationCount == 0) ? 0 : 1;
+}
+
+// function Producer adds the nums Which * ITEMS_PER_PRODUCER onwards
+void *Producer (void *Arg)
+{
+    int Which = (int) *(long *) Arg;
+    for (int loop = 0; loop < ITEMS_PER_PRODUCER; loop++) {
+        UserData D = { Which * ITEMS_PER_PRODUCER + loop };
+        if (loop % 2 == 0)
+            CLL_AddAtEnd (TheList, D);
+        else
+            CLL_AddAtFront (TheList, D);
+    }
+    atomic_fetch_add (&ProducersDone, 1);
+    return NULL;
+}
+
+// function Consumer takes from the front on even tries and the end on
+// odd ones, until every item has been taken by some consumer
+void *Consumer (void *Arg)
+{
+    int Which = (int) *(long *) Arg;
+    for (int tries = Which; atomic_load (&ItemsTaken) < NUM_ITEMS; tries++) {
+        UserData D;
+        bool Got = (tries % 2 == 0) ? CLL_GetFront (TheList, &D) : CLL_GetEnd (TheList, &D);
+        if (!Got)
+            continue;
+        if (D.num < 0 || D.num >= NUM_ITEMS)
+            atomic_fetch_add (&Errors, 1);
+        else
+            atomic_fetch_add (&Seen[D.num], 1);
+        atomic_fetch_add (&ItemsTaken, 1);
+    }
+    return NULL;
+}
+
+// function Walker reads the first few items over and over while items
+// are being added, checking that each is a num a producer could add
+void *Walker (void *Arg)
+{
+    while (atomic_load (&ProducersDone) < NUM_PRODUCERS) {
+        for (int loop = 0; loop < 64; loop++) {
+            UserData D;
+            if (!CLL_GetAtIndex (TheList, loop, &D))
+                break;
+            if (D.num < 0 || D.num >= NUM_ITEMS)
+                atomic_fetch_add (&Errors, 1);
+        }
+    }
+    return NULL;
+}
+
+// function Updater sets each of its indices to the index itself
+void *Updater (void *Arg)
+{
+    int Which = (int) *(long *) Arg;
+    for (int loop = Which; loop < NUM_UPDATE_NODES; loop += NUM_UPDATERS) {
+        UserData D = { loop };
+        if (!CLL_SetAtIndex (TheList, D, loop))
+            atomic_fetch_add (&Errors, 1);
+    }
+    return NULL;
+}
+
+// function UpdateReader reads every index once, each of which must
+// still be -1 or already be updated to the index
+void *UpdateReader (void *Arg)
+{
+    for (int loop = 0; loop < NUM_UPDATE_NODES; loop++) {
+        UserData D;
+        if (!CLL_GetAtIndex (TheList, loop, &D) || (D.num != -1 && D.num != loop))
+            atomic_fetch_add (&Errors, 1);
+    }
+    return NULL;
+}
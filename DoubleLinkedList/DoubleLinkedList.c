@@ -46,6 +46,10 @@
 // the check failed.  It comes in very handy to add error checking
 // without typing in a bunch of print statements
 #include <assert.h>
+// stdint provides uintptr_t, for finding the slab a node is in
+#include <stdint.h>
+// the node pool is guarded by a pthread mutex
+#include <pthread.h>
 // The linked list needs UserData to get the definition of what the
 // structure containing the user's data in a node is.  The code needs
 // the information only to be able to allocate a node and copy
@@ -66,11 +70,48 @@
 //      2. It declares the functions callable for a linked list.
 #include "LinkedList.h"
 
-// To make sure we are allocating and deallocating dynamic memory,
-// variable AllocationCount is declared within the LinkedList code
-// and is referenced by any other code that does dynamic memory
-// allocation and deallocation
-int AllocationCount = 0;
+// Nodes are not malloc'd one at a time.  They are carved out of
+// "slabs" of SLAB_BYTES, and each slab keeps its own free nodes
+// (linked through their "next") and the count of its nodes InUse.
+// Slabs are allocated on a SLAB_BYTES boundary, so the slab a node
+// belongs to is found by clearing the low bits of its address.
+// Partial links the slabs that have a free node, so MakeNode does
+// not call malloc until every slab is full.  A slab whose last node
+// is freed goes back to the heap, except that one is kept as the
+// Spare so that a list going back and forth across a slab boundary
+// does not malloc and free a slab every time; LL_Delete frees the
+// Spare too.
+// The memory account still counts one list node allocation for each
+// node in use, so AllocationCount reports the live nodes as it did when
+// each was malloc'd; the bytes it records are the slabs'.
+// The slab size can be changed at build time with -DSLAB_BYTES=n,
+// where n is a power of two with room for a few nodes
+#ifndef SLAB_BYTES
+#define SLAB_BYTES 4096
+#endif
+
+typedef struct slab
+{
+    struct slab *nextSlab;
+    struct slab *prevSlab;
+    NodePtr      FreeNodes;
+    int          InUse;
+    Node         Nodes[];
+} Slab, *SlabPtr;
+
+#define NODES_PER_SLAB ((int) ((SLAB_BYTES - sizeof (Slab)) / sizeof (Node)))
+_Static_assert ((SLAB_BYTES & (SLAB_BYTES - 1)) == 0, "SLAB_BYTES must be a power of two");
+_Static_assert (SLAB_BYTES >= sizeof (Slab) + 2 * sizeof (Node), "SLAB_BYTES must hold at least two nodes");
+
+// The pool is shared by every list, so that LL_Concat, LL_SpliceAt and
+// LL_SplitAt can move nodes from one list to another without caring
+// which slab they came from.  Threading: PoolLock guards the pool, so
+// threads may use different lists at the same time, as they could when
+// each node was malloc'd.  A list itself is not locked, so one list
+// must still only be used by one thread at a time.
+static pthread_mutex_t PoolLock = PTHREAD_MUTEX_INITIALIZER;
+static SlabPtr         Partial  = NULL;
+static SlabPtr         Spare    = NULL;
 
 // locally called function declarations follow..
 //
@@ -78,6 +119,34 @@ int AllocationCount = 0;
 // using the UserData
 static NodePtr MakeNode (UserData theData);
 
+// MakeEmptyNode is called to allocate a node whose UserData the caller fills in
+static NodePtr MakeEmptyNode (void);
+
+// TakeNode takes a free node from a slab.  It is called with PoolLock held
+static NodePtr TakeNode (void);
+
+// FreeNode returns a node that has been unlinked from a list to the pool
+static void FreeNode (NodePtr theNode);
+
+// FreeChain returns Count nodes linked through "next" from First to the pool
+static void FreeChain (NodePtr First, int Count);
+
+// PutNode puts a node back in its slab.  It is called with PoolLock held
+static void PutNode (NodePtr theNode);
+
+// ReleaseSpare frees the Spare slab, if there is one
+static void ReleaseSpare (void);
+
+// ReleaseSlab frees a slab, if there is one, and takes its bytes off the memory account
+static void ReleaseSlab (SlabPtr theSlab);
+
+// MakeChain makes Count nodes from UserData taken Step apart in the
+// array, linked to each other in that order, locking the pool once
+static NodePtr MakeChain (const UserData *Data, int Count, int Step, NodePtr *Last);
+
+// MergeRuns merges two sorted runs of nodes into one for LL_Sort
+static NodePtr MergeRuns (NodePtr First, NodePtr Second, LLComparison InOrder);
+
 // GetNodeAddress is used to return a pointer of an LL node, given an index
 // It will return the address of the node w/o changing its value
 static NodePtr GetNodeAddress (LLInfoPtr LLI_Ptr, int FetchIndex);
@@ -87,7 +156,7 @@ static NodePtr GetNodeAddress (LLInfoPtr LLI_Ptr, int FetchIndex);
 
 /////////////
 // LL_Init is used to allocate and initialize a LinkedList
-// Information structure.  It will update the AllocationCount
+// Information structure.  It will update the memory account
 // to reflect the malloc of the struct and return the pointer
 // to the struct for the caller to use when calling any
 // other function in the linked list
@@ -101,8 +170,10 @@ LLInfoPtr LL_Init()
     LLI_Ptr->Head = NULL;
     LLI_Ptr->Tail = NULL;
     LLI_Ptr->NumNodesInList = 0;
-    // update AllocationCount to reflect the malloc
-    AllocationCount++;
+    LLI_Ptr->Finger = NULL;
+    LLI_Ptr->FingerIndex = 0;
+    // update the memory account to reflect the malloc
+    MA_Allocated (MA_LL_INFO, sizeof (LLInfo));
     // return the pointer to the allocated struct to the caller
     return LLI_Ptr;
 }
@@ -110,10 +181,12 @@ LLInfoPtr LL_Init()
 /////////////
 // LL_Delete is called to delete all of the nodes in the Linked
 // List identified by LL_Ptr.
-// It does so by simply calling LL_GetFront to read
-// each node with a delete option.  Once all the nodes
-// have been deleted, it frees the memory associated with
-// the LinkedList information struct and updates the AllocationCount
+// The nodes are already chained together from Head to Tail through
+// "next", so the whole chain is handed back to the node pool under one
+// lock rather than calling LL_GetFront once per node.  Every slab that
+// this leaves with no node in use, the Spare included, is freed.
+// Once all the nodes have been deleted, it frees the memory associated with
+// the LinkedList information struct and updates the memory account
 // to reflect the memory release.
 /////////////
 LLInfoPtr LL_Delete(LLInfoPtr LLI_Ptr)
@@ -122,17 +195,23 @@ LLInfoPtr LL_Delete(LLInfoPtr LLI_Ptr)
     // Information structure does not exist, so make sure
     // it does and exit if not.
     assert (LLI_Ptr != NULL);
-    // To get rid of each node, simply read and delete each
-    // node using LL_GETFRONT
-    while (LLI_Ptr->NumNodesInList != 0)
-        LL_GetFront(LLI_Ptr, DELETE_NODE);
+    // To get rid of the nodes, hand the chain from Head to Tail
+    // back to the pool
+    if (LLI_Ptr->NumNodesInList != 0) {
+        FreeChain (LLI_Ptr->Head, LLI_Ptr->NumNodesInList);
+        LLI_Ptr->Head = LLI_Ptr->Tail = NULL;
+        LLI_Ptr->NumNodesInList = 0;
+        LLI_Ptr->Finger = NULL;
+    }
+    // the list is going, so do not keep a slab for it
+    ReleaseSpare();
     // Now that all the nodes are gone, delete the Information
     // structure itself
     free(LLI_Ptr);
     LLI_Ptr = NULL;
-    // Update the AllocationCount to reflect the
+    // Update the memory account to reflect the
     // dealloction of the Information structure
-    AllocationCount--;
+    MA_Released (MA_LL_INFO, sizeof (LLInfo));
     // return a NULL because the list structure no longer exists
     return NULL;
 
@@ -171,6 +250,8 @@ void LL_AddAtFront (LLInfoPtr LLI_Ptr, UserData theData)
         LLI_Ptr->Tail = NewNode;
     // The Node just allocated is now the Head of the LL
     LLI_Ptr->Head = NewNode;
+    // every node already in the list is now one index further along
+    LLI_Ptr->FingerIndex++;
     // update the number of nodes in the list to reflect
     // the addition of this node
     LLI_Ptr->NumNodesInList++;
@@ -240,11 +321,18 @@ UserData LL_GetFront (LLInfoPtr LLI_Ptr, ShouldDelete Choice)
     // new head information in the Information structure,
     // free the node just deleted and update the node count
     if (Choice == DELETE_NODE) {
-        // update Head to point to the next node and deallocate the
-        // current start of the LL
+        // update Head to point to the next node and return the
+        // current start of the LL to the node pool
         LLI_Ptr->Head = top->next;
-        top->prev = NULL;
-        free (top);
+        if (LLI_Ptr->Head != NULL)
+            LLI_Ptr->Head->prev = NULL;
+        // the remembered node either goes away with the Head or
+        // moves one index closer to the front
+        if (LLI_Ptr->Finger == top)
+            LLI_Ptr->Finger = NULL;
+        else
+            LLI_Ptr->FingerIndex--;
+        FreeNode (top);
         top = NULL;
         // because a node has been freed, update the
         // number of remaining nodes in the list
@@ -253,9 +341,6 @@ UserData LL_GetFront (LLInfoPtr LLI_Ptr, ShouldDelete Choice)
         // the last of the nodes in the list
         if (LLI_Ptr->NumNodesInList == 0)
             LLI_Ptr->Head = LLI_Ptr->Tail = NULL;
-        // because a node has been freed, update the
-        // allocation count in the list
-        AllocationCount--;
     }
     // return the user data that has been read from the start
     // of the linked list
@@ -339,38 +424,750 @@ void  LL_Swap (LLInfoPtr LLI_Ptr, int Index1, int Index2)
     return;
 }
 
+/////////////
+// LL_InsertAtIndex adds theData so that it ends up at InsertIndex,
+// moving the nodes from there on one index along.  InsertIndex may be
+// the length of the list, which adds at the end.
+// It locates the node now at InsertIndex and links the new node in
+// before it; the new node then becomes the Finger.
+/////////////
+void LL_InsertAtIndex (LLInfoPtr LLI_Ptr, UserData theData, int InsertIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((InsertIndex >= 0) && (InsertIndex <= LLI_Ptr->NumNodesInList) );
+    NodePtr Before = (InsertIndex == LLI_Ptr->NumNodesInList) ? NULL : GetNodeAddress (LLI_Ptr, InsertIndex);
+    LLI_Ptr->Finger = LL_InsertBefore (LLI_Ptr, Before, theData);
+    LLI_Ptr->FingerIndex = InsertIndex;
+}
+
+/////////////
+// LL_RemoveAtIndex removes the node at RemoveIndex, moving the nodes
+// after it one index closer to the front, and returns its UserData.
+// The node that followed it becomes the Finger.
+/////////////
+UserData LL_RemoveAtIndex (LLInfoPtr LLI_Ptr, int RemoveIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((RemoveIndex >= 0) && (RemoveIndex < LLI_Ptr->NumNodesInList) );
+    NodePtr toRemove = GetNodeAddress (LLI_Ptr, RemoveIndex);
+    UserData theData = toRemove->Data;
+    LLI_Ptr->Finger = LL_Erase (LLI_Ptr, toRemove);
+    LLI_Ptr->FingerIndex = RemoveIndex;
+    return theData;
+}
+
+/////////////
+// LL_PeekFrontPtr returns the address of the UserData at the front
+// of the LL instead of a copy of it, so a large UserData is not copied
+// just to be looked at.  The caller may read or update the UserData
+// through the address, which is good until that node is deleted.
+/////////////
+UserData *LL_PeekFrontPtr (LLInfoPtr LLI_Ptr)
+{
+    // Make sure the LL exists and has a node at the front
+    assert (LLI_Ptr != NULL);
+    assert (LLI_Ptr->Head != NULL);
+    return &LLI_Ptr->Head->Data;
+}
+
+/////////////
+// LL_AtIndexPtr returns the address of the UserData at the specified
+// index in the underlying LL, instead of a copy of it.  Like
+// LL_PeekFrontPtr, the address is good until that node is deleted.
+/////////////
+UserData *LL_AtIndexPtr (LLInfoPtr LLI_Ptr, int FetchIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((FetchIndex >= 0) && (FetchIndex < LLI_Ptr->NumNodesInList) );
+    return &GetNodeAddress(LLI_Ptr, FetchIndex)->Data;
+}
+
+/////////////
+// LL_EmplaceFront adds a node to the front of the LL, like
+// LL_AddAtFront, but rather than copying in UserData passed by value
+// it returns the address of the new node's UserData for the caller to
+// fill in place.  Until the caller does, the UserData holds whatever
+// was in the node's memory.
+/////////////
+UserData *LL_EmplaceFront (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    NodePtr NewNode = MakeEmptyNode();
+    NewNode->next = LLI_Ptr->Head;
+    if (LLI_Ptr->Head != NULL)
+        LLI_Ptr->Head->prev = NewNode;
+    else
+        LLI_Ptr->Tail = NewNode;
+    LLI_Ptr->Head = NewNode;
+    // every node already in the list is now one index further along
+    LLI_Ptr->FingerIndex++;
+    LLI_Ptr->NumNodesInList++;
+    return &NewNode->Data;
+}
+
+/////////////
+// LL_EmplaceEnd adds a node to the end of the LL, like LL_AddAtEnd,
+// and returns the address of its UserData for the caller to fill in
+/////////////
+UserData *LL_EmplaceEnd (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    NodePtr NewNode = MakeEmptyNode();
+    NewNode->prev = LLI_Ptr->Tail;
+    if (LLI_Ptr->Tail != NULL)
+        LLI_Ptr->Tail->next = NewNode;
+    else
+        LLI_Ptr->Head = NewNode;
+    LLI_Ptr->Tail = NewNode;
+    LLI_Ptr->NumNodesInList++;
+    return &NewNode->Data;
+}
+
+/////////////
+// LL_AddAtEndBatch is called to add Count UserData from the array
+// Data to the end of the list, in array order.
+// The new nodes are made and linked to each other first, then the
+// whole chain is linked to the current Tail at once.
+/////////////
+void LL_AddAtEndBatch (LLInfoPtr LLI_Ptr, const UserData *Data, int Count)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Count >= 0 && (Data != NULL || Count == 0));
+    if (Count == 0)
+        return;
+    NodePtr Last;
+    NodePtr First = MakeChain (Data, Count, 1, &Last);
+    // link the chain after the current Tail (if any)
+    if (LLI_Ptr->Tail != NULL) {
+        LLI_Ptr->Tail->next = First;
+        First->prev = LLI_Ptr->Tail;
+    } else
+        LLI_Ptr->Head = First;
+    LLI_Ptr->Tail = Last;
+    LLI_Ptr->NumNodesInList += Count;
+}
+
+/////////////
+// LL_AddAtFrontBatch is called to add Count UserData from the array
+// Data to the front of the list.  The result is the same as calling
+// LL_AddAtFront for Data[0] up to Data[Count-1], so the chain is made
+// from the array backwards and then linked in front of the current Head.
+/////////////
+void LL_AddAtFrontBatch (LLInfoPtr LLI_Ptr, const UserData *Data, int Count)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Count >= 0 && (Data != NULL || Count == 0));
+    if (Count == 0)
+        return;
+    NodePtr Last;
+    NodePtr First = MakeChain (&Data[Count - 1], Count, -1, &Last);
+    // link the chain before the current Head (if any)
+    if (LLI_Ptr->Head != NULL) {
+        LLI_Ptr->Head->prev = Last;
+        Last->next = LLI_Ptr->Head;
+    } else
+        LLI_Ptr->Tail = Last;
+    LLI_Ptr->Head = First;
+    LLI_Ptr->NumNodesInList += Count;
+    // every node already in the list is now Count indices further along
+    LLI_Ptr->FingerIndex += Count;
+}
+
+/////////////
+// LL_DrainFront is called to remove up to MaxCount UserData from the
+// front of the list, copying them into Out in list order.
+// The nodes are copied out in one walk and the run of nodes is then
+// handed back to the node pool under one lock.
+// It returns the number of UserData removed.
+/////////////
+int LL_DrainFront (LLInfoPtr LLI_Ptr, UserData *Out, int MaxCount)
+{
+    assert (LLI_Ptr != NULL);
+    assert (MaxCount >= 0 && (Out != NULL || MaxCount == 0));
+    int Count = (MaxCount < LLI_Ptr->NumNodesInList) ? MaxCount : LLI_Ptr->NumNodesInList;
+    if (Count == 0)
+        return 0;
+    // copy out the data, stopping on the last node to be removed
+    NodePtr First = LLI_Ptr->Head;
+    NodePtr Last = First;
+    Out[0] = First->Data;
+    for (int i = 1; i < Count; i++) {
+        Last = Last->next;
+        Out[i] = Last->Data;
+    }
+    // the node after the run is the new Head
+    LLI_Ptr->Head = Last->next;
+    if (LLI_Ptr->Head != NULL)
+        LLI_Ptr->Head->prev = NULL;
+    else
+        LLI_Ptr->Tail = NULL;
+    LLI_Ptr->NumNodesInList -= Count;
+    // the remembered node either went with the run or moved closer to the front
+    if (LLI_Ptr->FingerIndex < Count)
+        LLI_Ptr->Finger = NULL;
+    else
+        LLI_Ptr->FingerIndex -= Count;
+    // give the run back to the pool
+    FreeChain (First, Count);
+    return Count;
+}
+
+/////////////
+// LL_ToArray copies up to MaxCount UserData, starting at the front of
+// the list, into Out.  The list is not changed.
+// It returns the number of UserData copied.
+/////////////
+int LL_ToArray (LLInfoPtr LLI_Ptr, UserData *Out, int MaxCount)
+{
+    assert (LLI_Ptr != NULL);
+    assert (MaxCount >= 0 && (Out != NULL || MaxCount == 0));
+    int Count = 0;
+    for (NodePtr curr = LLI_Ptr->Head; curr != NULL && Count < MaxCount; curr = curr->next)
+        Out[Count++] = curr->Data;
+    return Count;
+}
+
+/////////////
+// LL_FromArray makes a new list holding the Count UserData in the
+// array Data, in array order.  The caller deletes it with LL_Delete
+// just like a list made by LL_Init.
+/////////////
+LLInfoPtr LL_FromArray (const UserData *Data, int Count)
+{
+    LLInfoPtr LLI_Ptr = LL_Init();
+    LL_AddAtEndBatch (LLI_Ptr, Data, Count);
+    return LLI_Ptr;
+}
+
+/////////////
+// LL_ForEach calls Visit for each node from the Head to the Tail,
+// passing the address of the node's UserData and the caller's Context.
+// Visit may update the UserData but must not add or delete nodes.
+/////////////
+void LL_ForEach (LLInfoPtr LLI_Ptr, LLVisitor Visit, void *Context)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Visit != NULL);
+    for (NodePtr curr = LLI_Ptr->Head; curr != NULL; curr = curr->next)
+        Visit (&curr->Data, Context);
+}
+
+/////////////
+// The cursor functions let a caller walk the list a node at a time and
+// change it where they are, instead of going through an index that has
+// to be found from the Head, Tail or Finger on every call.
+// A cursor is simply the address of a node, and LL_End is NULL.
+/////////////
+LLCursor LL_Begin (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    return LLI_Ptr->Head;
+}
+
+LLCursor LL_End (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    return NULL;
+}
+
+LLCursor LL_Next (LLInfoPtr LLI_Ptr, LLCursor Cursor)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Cursor != NULL);
+    return Cursor->next;
+}
+
+LLCursor LL_Prev (LLInfoPtr LLI_Ptr, LLCursor Cursor)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Cursor != LLI_Ptr->Head);
+    return (Cursor == NULL) ? LLI_Ptr->Tail : Cursor->prev;
+}
+
+UserData LL_GetAtCursor (LLInfoPtr LLI_Ptr, LLCursor Cursor)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Cursor != NULL);
+    return Cursor->Data;
+}
+
+void LL_SetAtCursor (LLInfoPtr LLI_Ptr, LLCursor Cursor, UserData D)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Cursor != NULL);
+    Cursor->Data = D;
+}
+
+/////////////
+// LL_InsertBefore makes a node for theData and links it in just before
+// the node at Cursor, or at the Tail if Cursor is LL_End.  The index of
+// every node after it changes, so the Finger is forgotten.
+// It returns the cursor at the new node.
+/////////////
+LLCursor LL_InsertBefore (LLInfoPtr LLI_Ptr, LLCursor Cursor, UserData theData)
+{
+    assert (LLI_Ptr != NULL);
+    // the ends of the list are already handled, including an empty list
+    if (Cursor == NULL) {
+        LL_AddAtEnd (LLI_Ptr, theData);
+        return LLI_Ptr->Tail;
+    }
+    if (Cursor == LLI_Ptr->Head) {
+        LL_AddAtFront (LLI_Ptr, theData);
+        return LLI_Ptr->Head;
+    }
+    // link the new node between Cursor and the node before it
+    NodePtr NewNode = MakeNode (theData);
+    NewNode->prev = Cursor->prev;
+    NewNode->next = Cursor;
+    Cursor->prev->next = NewNode;
+    Cursor->prev = NewNode;
+    LLI_Ptr->NumNodesInList++;
+    LLI_Ptr->Finger = NULL;
+    return NewNode;
+}
+
+/////////////
+// LL_Erase unlinks the node at Cursor, updating Head and Tail if it was
+// at either end, and returns it to the node pool.  The index of every
+// node after it changes, so the Finger is forgotten.
+// It returns the cursor at the node that followed the deleted one.
+/////////////
+LLCursor LL_Erase (LLInfoPtr LLI_Ptr, LLCursor Cursor)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Cursor != NULL);
+    NodePtr nextNode = Cursor->next;
+    if (Cursor->prev != NULL)
+        Cursor->prev->next = Cursor->next;
+    else
+        LLI_Ptr->Head = Cursor->next;
+    if (Cursor->next != NULL)
+        Cursor->next->prev = Cursor->prev;
+    else
+        LLI_Ptr->Tail = Cursor->prev;
+    FreeNode (Cursor);
+    LLI_Ptr->NumNodesInList--;
+    LLI_Ptr->Finger = NULL;
+    return nextNode;
+}
+
+//////////////
+// LL_SwapNodes swaps the nodes at the specified indices Index1 and Index2
+// in the underlying LL by relinking them: each node takes over the other's
+// prev and next (and its place as Head or Tail).  Unlike LL_Swap no
+// UserData is copied, so a swap costs the same however big UserData is.
+// Nodes that are next to each other are handled separately, because
+// there each node is the other's neighbour.
+/////////////
+void LL_SwapNodes (LLInfoPtr LLI_Ptr, int Index1, int Index2)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((Index1 >= 0) && (Index1 < LLI_Ptr->NumNodesInList) );
+    assert ((Index2 >= 0) && (Index2 < LLI_Ptr->NumNodesInList) );
+    // no need to do anything if the indices are the same
+    if (Index1 == Index2)
+        return;
+    // make A the node nearer the Head
+    if (Index1 > Index2) {
+        int temp = Index1;
+        Index1 = Index2;
+        Index2 = temp;
+    }
+    NodePtr A = GetNodeAddress(LLI_Ptr, Index1);
+    NodePtr B = GetNodeAddress(LLI_Ptr, Index2);
+    NodePtr APrev = A->prev;
+    NodePtr BNext = B->next;
+    if (A->next == B) {
+        // A and B are neighbours: the order becomes APrev, B, A, BNext
+        B->prev = APrev;
+        B->next = A;
+        A->prev = B;
+        A->next = BNext;
+    } else {
+        // the neighbours between A and B stay put and swap whom they link to
+        NodePtr ANext = A->next;
+        NodePtr BPrev = B->prev;
+        B->prev = APrev;
+        B->next = ANext;
+        ANext->prev = B;
+        A->prev = BPrev;
+        A->next = BNext;
+        BPrev->next = A;
+    }
+    // link the outside neighbours (or Head and Tail) to the swapped nodes
+    if (APrev != NULL)
+        APrev->next = B;
+    else
+        LLI_Ptr->Head = B;
+    if (BNext != NULL)
+        BNext->prev = A;
+    else
+        LLI_Ptr->Tail = A;
+    // the Finger was left on B, which is now at Index1
+    LLI_Ptr->FingerIndex = Index1;
+}
+
+/////////////
+// LL_Concat moves all of the nodes in Src to the end of Dst.
+// The Src chain is linked to the Dst Tail as it is, so no node is
+// copied or allocated, and Src is left as an empty list that the
+// caller still deletes with LL_Delete.
+/////////////
+void LL_Concat (LLInfoPtr Dst, LLInfoPtr Src)
+{
+    assert (Dst != NULL && Src != NULL);
+    assert (Dst != Src);
+    if (Src->NumNodesInList == 0)
+        return;
+    if (Dst->Tail != NULL) {
+        Dst->Tail->next = Src->Head;
+        Src->Head->prev = Dst->Tail;
+    } else
+        Dst->Head = Src->Head;
+    Dst->Tail = Src->Tail;
+    Dst->NumNodesInList += Src->NumNodesInList;
+    // Src no longer has any nodes
+    Src->Head = Src->Tail = NULL;
+    Src->NumNodesInList = 0;
+    Src->Finger = NULL;
+}
+
+/////////////
+// LL_SpliceAt moves all of the nodes in Src into Dst so that the
+// first of them ends up at Index.  Index may be LL_Length(Dst), which
+// is the same as LL_Concat.  The only walk is to find the node at
+// Index; the Src chain is then linked in front of it as it is.
+// Src is left as an empty list that the caller still deletes.
+/////////////
+void LL_SpliceAt (LLInfoPtr Dst, int Index, LLInfoPtr Src)
+{
+    assert (Dst != NULL && Src != NULL);
+    assert (Dst != Src);
+    assert ((Index >= 0) && (Index <= Dst->NumNodesInList) );
+    if (Src->NumNodesInList == 0)
+        return;
+    if (Index == Dst->NumNodesInList) {
+        LL_Concat (Dst, Src);
+        return;
+    }
+    // link the Src chain between the node at Index and the one before it
+    NodePtr After = GetNodeAddress (Dst, Index);
+    NodePtr Before = After->prev;
+    Src->Tail->next = After;
+    After->prev = Src->Tail;
+    Src->Head->prev = Before;
+    if (Before != NULL)
+        Before->next = Src->Head;
+    else
+        Dst->Head = Src->Head;
+    Dst->NumNodesInList += Src->NumNodesInList;
+    // the node at Index (the Finger) has moved along by the nodes spliced in
+    Dst->FingerIndex += Src->NumNodesInList;
+    // Src no longer has any nodes
+    Src->Head = Src->Tail = NULL;
+    Src->NumNodesInList = 0;
+    Src->Finger = NULL;
+}
+
+/////////////
+// LL_SplitAt cuts the list in two in front of the node at Index.
+// The nodes from Index to the Tail become a new list, made with LL_Init,
+// whose address is returned; the nodes before Index stay where they are.
+// Index may be 0 (everything moves) or LL_Length (nothing moves).
+/////////////
+LLInfoPtr LL_SplitAt (LLInfoPtr LLI_Ptr, int Index)
+{
+    assert (LLI_Ptr != NULL);
+    assert ((Index >= 0) && (Index <= LLI_Ptr->NumNodesInList) );
+    LLInfoPtr Rest = LL_Init();
+    if (Index == LLI_Ptr->NumNodesInList)
+        return Rest;
+    // the node at Index is the Head of the new list
+    NodePtr First = GetNodeAddress (LLI_Ptr, Index);
+    Rest->Head = First;
+    Rest->Tail = LLI_Ptr->Tail;
+    Rest->NumNodesInList = LLI_Ptr->NumNodesInList - Index;
+    // cut the link between the two lists
+    LLI_Ptr->Tail = First->prev;
+    if (First->prev != NULL)
+        First->prev->next = NULL;
+    else
+        LLI_Ptr->Head = NULL;
+    First->prev = NULL;
+    LLI_Ptr->NumNodesInList = Index;
+    // the Finger was left on First, which is now at index 0 of the new list
+    LLI_Ptr->Finger = NULL;
+    return Rest;
+}
+
+/////////////
+// LL_Sort sorts the list with a bottom-up merge sort that relinks the
+// nodes, so no UserData is copied and nothing is allocated.
+// Runs[i] is either empty or a sorted run of 2^i nodes.  The nodes are
+// taken off the list one at a time and each becomes a run of 1 that is
+// merged with Runs[0], then the result with Runs[1] and so on until an
+// empty entry is found to hold it, much like adding 1 to a binary number.
+// Merges therefore happen while the nodes involved were used recently,
+// instead of walking the whole list once for every doubling of the run
+// size.  At the end the remaining runs are merged together.
+// Runs only ever hold nodes that came before the ones being merged into
+// them, and MergeRuns keeps the earlier run first when nodes are equal,
+// so the sort is stable.
+// Only the "next" links are followed while merging; the "prev" links,
+// Tail and Head are rebuilt in one walk at the end, and the Finger is forgotten.
+/////////////
+void LL_Sort (LLInfoPtr LLI_Ptr, LLComparison InOrder)
+{
+    assert (LLI_Ptr != NULL);
+    assert (InOrder != NULL);
+    if (LLI_Ptr->NumNodesInList < 2)
+        return;
+    // a run of 2^i nodes fits in an int sized list for every i used
+    NodePtr Runs[sizeof (int) * 8] = {NULL};
+    int NumRuns = 0;
+    NodePtr curr = LLI_Ptr->Head;
+    while (curr != NULL) {
+        NodePtr nextNode = curr->next;
+        curr->next = NULL;
+        // merge the single node up through the runs until there is room for it
+        NodePtr carry = curr;
+        int i = 0;
+        for (; Runs[i] != NULL; i++) {
+            carry = MergeRuns (Runs[i], carry, InOrder);
+            Runs[i] = NULL;
+        }
+        Runs[i] = carry;
+        if (i >= NumRuns)
+            NumRuns = i + 1;
+        curr = nextNode;
+    }
+    // merge what is left, from the newest (smallest) run to the oldest
+    NodePtr list = NULL;
+    for (int i = 0; i < NumRuns; i++)
+        if (Runs[i] != NULL)
+            list = (list == NULL) ? Runs[i] : MergeRuns (Runs[i], list, InOrder);
+    // rebuild the prev links and Tail from the new order
+    LLI_Ptr->Head = list;
+    NodePtr prev = NULL;
+    for (curr = list; curr != NULL; curr = curr->next) {
+        curr->prev = prev;
+        prev = curr;
+    }
+    LLI_Ptr->Tail = prev;
+    LLI_Ptr->Finger = NULL;
+}
+
 /////////////
 // Local function MakeNode allocates and initializes a Node for placement
 // in the LL.  It copies over the user data into the allocated node and NULLs the
 // node's "next" link.
+// The node is taken from the free nodes of a Partial slab.  Only when
+// no slab has room is a new slab malloc'd and all of its nodes made free.
 /////////////
 NodePtr MakeNode (UserData theData)
 {
-    // allocate a node to contain the user's data
-    // and abort if the allocation fails
-    NodePtr NewNode = (NodePtr) malloc (sizeof (Node));
-    assert (NewNode != NULL);
-    // allocation worked, copy in the user data without
+    // get an unlinked node, then copy in the user data without
     // copying field by field.
+    NodePtr NewNode = MakeEmptyNode();
     NewNode->Data = theData;
-    // unless updated by the caller of MakeNode, the "next"
+    return NewNode;
+}
+
+/////////////
+// Local function MakeEmptyNode takes a Node for placement in the
+// LL and NULLs its "next" and "prev" links.  Its UserData is left for
+// the caller to fill in.
+/////////////
+NodePtr MakeEmptyNode (void)
+{
+    pthread_mutex_lock (&PoolLock);
+    NodePtr NewNode = TakeNode();
+    pthread_mutex_unlock (&PoolLock);
+    // unless updated by the caller, the "next"
     // and "prev" default to NULL
     NewNode->next = NULL;
     NewNode->prev = NULL;
-    // Update the number of allocations to reflect the malloc
-    AllocationCount++;
+    // Update the memory account to reflect the node now in use
+    MA_Allocated (MA_LIST_NODE, 0);
     // return the pointer to the node ready to link in
     return NewNode;
 }
 
+/////////////
+// Local function TakeNode takes the first free node of the first
+// Partial slab, and once that slab is full it is no longer Partial.
+// If no slab has a free node it uses the Spare or allocates a slab.
+/////////////
+NodePtr TakeNode (void)
+{
+    // if no slab has a free node, use the Spare or allocate a slab,
+    // aborting if the allocation fails
+    if (Partial == NULL) {
+        SlabPtr NewSlab = Spare;
+        Spare = NULL;
+        if (NewSlab == NULL) {
+            NewSlab = (SlabPtr) aligned_alloc (SLAB_BYTES, SLAB_BYTES);
+            assert (NewSlab != NULL);
+            // the slab's bytes go on the list node account without
+            // adding an allocation, so AllocationCount is unchanged
+            MA_Resized (MA_LIST_NODE, 0, SLAB_BYTES);
+            // chain the slab's nodes together to form its free nodes
+            for (int i = 0; i < NODES_PER_SLAB - 1; i++)
+                NewSlab->Nodes[i].next = &NewSlab->Nodes[i + 1];
+            NewSlab->Nodes[NODES_PER_SLAB - 1].next = NULL;
+            NewSlab->FreeNodes = &NewSlab->Nodes[0];
+            NewSlab->InUse = 0;
+        }
+        NewSlab->nextSlab = NewSlab->prevSlab = NULL;
+        Partial = NewSlab;
+    }
+    SlabPtr theSlab = Partial;
+    NodePtr NewNode = theSlab->FreeNodes;
+    theSlab->FreeNodes = NewNode->next;
+    theSlab->InUse++;
+    if (theSlab->FreeNodes == NULL) {
+        Partial = theSlab->nextSlab;
+        if (Partial != NULL)
+            Partial->prevSlab = NULL;
+    }
+    return NewNode;
+}
+
+/////////////
+// Local function FreeNode returns a node that is no longer linked
+// into any list to its slab, so that it is the next one MakeNode
+// hands out from there.
+/////////////
+void FreeNode (NodePtr theNode)
+{
+    assert (theNode != NULL);
+    pthread_mutex_lock (&PoolLock);
+    PutNode (theNode);
+    pthread_mutex_unlock (&PoolLock);
+    // Update the memory account to reflect the released node
+    MA_Released (MA_LIST_NODE, 0);
+}
+
+/////////////
+// Local function FreeChain returns a chain of Count nodes, no longer
+// linked into any list, to their slabs while holding the lock once.
+/////////////
+void FreeChain (NodePtr First, int Count)
+{
+    pthread_mutex_lock (&PoolLock);
+    for (int i = 0; i < Count; i++) {
+        NodePtr nextNode = First->next;
+        PutNode (First);
+        First = nextNode;
+    }
+    pthread_mutex_unlock (&PoolLock);
+    MA_ReleasedMany (MA_LIST_NODE, Count, 0);
+}
+
+/////////////
+// Local function PutNode puts a node on the free nodes of the slab it
+// is in.  A slab that was full has room again, so it goes on Partial;
+// a slab that now has no node in use comes off Partial and becomes
+// the Spare, freeing the Spare there was before.
+/////////////
+void PutNode (NodePtr theNode)
+{
+    SlabPtr theSlab = (SlabPtr) ((uintptr_t) theNode & ~((uintptr_t) SLAB_BYTES - 1));
+    assert (theSlab->InUse > 0);
+    if (theSlab->FreeNodes == NULL) {
+        theSlab->prevSlab = NULL;
+        theSlab->nextSlab = Partial;
+        if (Partial != NULL)
+            Partial->prevSlab = theSlab;
+        Partial = theSlab;
+    }
+    theNode->prev = NULL;
+    theNode->next = theSlab->FreeNodes;
+    theSlab->FreeNodes = theNode;
+    if (--theSlab->InUse > 0)
+        return;
+    if (theSlab->prevSlab != NULL)
+        theSlab->prevSlab->nextSlab = theSlab->nextSlab;
+    else
+        Partial = theSlab->nextSlab;
+    if (theSlab->nextSlab != NULL)
+        theSlab->nextSlab->prevSlab = theSlab->prevSlab;
+    ReleaseSlab (Spare);
+    Spare = theSlab;
+}
+
+/////////////
+// Local function MakeChain makes Count nodes holding Data[0], Data[Step],
+// Data[2*Step] and so on, linking each to the one made before it.
+// All Count nodes are taken from the slabs, filled and linked in one
+// walk while PoolLock is held, rather than locking once per node.
+// It returns the first node of the chain and sets Last to the last one.
+// The chain is not yet part of any list.
+/////////////
+NodePtr MakeChain (const UserData *Data, int Count, int Step, NodePtr *Last)
+{
+    assert (Count > 0);
+    NodePtr First = NULL;
+    NodePtr curr = NULL;
+    pthread_mutex_lock (&PoolLock);
+    for (int i = 0; i < Count; i++) {
+        NodePtr NewNode = TakeNode();
+        NewNode->Data = Data[i * Step];
+        NewNode->prev = curr;
+        NewNode->next = NULL;
+        if (curr != NULL)
+            curr->next = NewNode;
+        else
+            First = NewNode;
+        curr = NewNode;
+        MA_Allocated (MA_LIST_NODE, 0);
+    }
+    pthread_mutex_unlock (&PoolLock);
+    *Last = curr;
+    return First;
+}
+
+/////////////
+// Local function ReleaseSpare frees the Spare slab.  Its nodes are all
+// free, so nothing refers to it.
+/////////////
+void ReleaseSpare (void)
+{
+    pthread_mutex_lock (&PoolLock);
+    ReleaseSlab (Spare);
+    Spare = NULL;
+    pthread_mutex_unlock (&PoolLock);
+}
+
+/////////////
+// Local function ReleaseSlab frees a slab with no node in use.  The
+// memory account records the bytes of the slabs, as they are what is
+// malloc'd, so its live and peak bytes match the heap.  They are moved
+// with MA_Resized so that they add nothing to AllocationCount.
+/////////////
+void ReleaseSlab (SlabPtr theSlab)
+{
+    if (theSlab == NULL)
+        return;
+    assert (theSlab->InUse == 0);
+    free (theSlab);
+    MA_Resized (MA_LIST_NODE, SLAB_BYTES, 0);
+}
+
 /////////////
 // GetNodeAddress is a utility function that will locate
 // the node at Index and return its address.
-// The function first calculates the middle of the Linked List
-// then based on the given FetchIndex will either look for the node
-// forwards or backwards.
-// Once the position in the LL has been reached, the node address
-// is returned.
+// The function works out how far FetchIndex is from the Head, from the
+// Tail and from the Finger (the node found by the previous call), then
+// walks forwards or backwards from whichever of them is closest.
+// Once the position in the LL has been reached, the node becomes the new
+// Finger and its address is returned.  Walking the list by index one
+// step at a time therefore costs a single link per call.
 /////////////
 NodePtr GetNodeAddress (LLInfoPtr LLI_Ptr, int FetchIndex)
 {
@@ -378,31 +1175,60 @@ NodePtr GetNodeAddress (LLInfoPtr LLI_Ptr, int FetchIndex)
     assert (LLI_Ptr != NULL);
     assert ((FetchIndex >= 0) && (FetchIndex < LLI_Ptr->NumNodesInList) );
 
-    // Calculate the middle of the Linked List given the current node size
-    int middle = LLI_Ptr->NumNodesInList / 2;
-
-    // A variable to store the current node pointer
-    NodePtr curr;
-
-    // If the fetch index is less than or equal to the middle,
-    // Start searching from the Head and work your way up toward the middle.
-    // Stops once i == FetchIndex - 1, or i < FetchIndex, meaning curr now points to the correct node!
-    if (FetchIndex <= middle) {
-        // set curr to the Head of the list
-        curr = LLI_Ptr->Head;
-        for (int i = 0; i < FetchIndex; i++) {
-            curr = curr->next;
-        }
-    } else {
-        // Else, if the fetch index is greater than the middle,
-        // Start searching from the Tail and work your way down toward the middle.
+    // Start by assuming the Head or Tail is closest, just as
+    // if there were no Finger
+    NodePtr curr = LLI_Ptr->Head;
+    int currIndex = 0;
+    int distance = FetchIndex;
+    if (LLI_Ptr->NumNodesInList - 1 - FetchIndex < distance) {
         curr = LLI_Ptr->Tail;
-        for (int i = LLI_Ptr->NumNodesInList - 1; i > FetchIndex; i--) {
-            curr = curr->prev;
+        currIndex = LLI_Ptr->NumNodesInList - 1;
+        distance = currIndex - FetchIndex;
+    }
+    // Use the Finger instead if it is closer still
+    if (LLI_Ptr->Finger != NULL) {
+        int fingerDistance = abs (FetchIndex - LLI_Ptr->FingerIndex);
+        if (fingerDistance < distance) {
+            curr = LLI_Ptr->Finger;
+            currIndex = LLI_Ptr->FingerIndex;
         }
     }
 
-    // return its UserData
+    // walk forwards or backwards until curr is the node at FetchIndex
+    for (; currIndex < FetchIndex; currIndex++)
+        curr = curr->next;
+    for (; currIndex > FetchIndex; currIndex--)
+        curr = curr->prev;
+
+    // remember where we are for the next call
+    LLI_Ptr->Finger = curr;
+    LLI_Ptr->FingerIndex = FetchIndex;
+
+    // return its address
     return curr;
 }
 
+/////////////
+// Local function MergeRuns merges two sorted runs, each ending in a NULL
+// "next", into one sorted run and returns its first node.  First holds
+// the nodes that came earlier in the list, so on equal nodes it is taken
+// from First to keep the sort stable.
+/////////////
+NodePtr MergeRuns (NodePtr First, NodePtr Second, LLComparison InOrder)
+{
+    NodePtr Merged = NULL;
+    NodePtr *Link = &Merged;
+    while (First != NULL && Second != NULL) {
+        if (InOrder (&Second->Data, &First->Data)) {
+            *Link = Second;
+            Second = Second->next;
+        } else {
+            *Link = First;
+            First = First->next;
+        }
+        Link = &(*Link)->next;
+    }
+    // whatever is left of either run is already in order
+    *Link = (First != NULL) ? First : Second;
+    return Merged;
+}
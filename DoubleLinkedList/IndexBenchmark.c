@@ -0,0 +1,87 @@
+//
+//  IndexBenchmark
+//
+//  This program times the list functions that work by index, on lists
+//  of growing length:
+//      LL_GetAtIndex                      - reads the UserData at a random index
+//      LL_InsertAtIndex, LL_RemoveAtIndex - adds a UserData at a random index
+//                                           and removes one from another
+//  The double, unrolled and compact lists walk to the index, so each call
+//  costs more the longer the list is.  The skip list jumps most of the way
+//  along its higher levels, so its calls grow only with log n.
+//  CMake builds this program once for each list layout, so running them
+//  one after another shows the difference.
+//
+//  The indices are random so that the Finger kept by the walking layouts
+//  does not help them more than it would in real use.
+
+// we use printf from stdio.h
+#include <stdio.h>
+// we use rand and srand from stdlib.h to pick the indices, and malloc
+// and free for the array the list is made from
+#include <stdlib.h>
+// we use clock() from time.h to time the calls
+#include <time.h>
+// we use the linked list, so include its functions that we can call
+#include "LinkedList.h"
+
+// The longest list timed and the calls timed on each length
+#define MAX_NODES  1000000
+#define NUM_CALLS  2000
+
+// TimeGets returns the number of nanoseconds an LL_GetAtIndex takes on average
+static double TimeGets (LLInfoPtr LL);
+
+// TimeInsertRemoves returns the number of nanoseconds an LL_InsertAtIndex
+// and LL_RemoveAtIndex pair takes on average
+static double TimeInsertRemoves (LLInfoPtr LL);
+
+int main(int argc, const char * argv[]) {
+    UserData *Data = (UserData *) malloc (MAX_NODES * sizeof (UserData));
+    for (int loop = 0; loop < MAX_NODES; loop++) {
+        UserData D = {0};
+        D.num = loop;
+        Data[loop] = D;
+    }
+    srand (1);
+    printf ("%10s %16s %24s\n", "nodes", "get ns", "insert+remove ns");
+    for (int NumNodes = 1000; NumNodes <= MAX_NODES; NumNodes *= 10) {
+        LLInfoPtr LL = LL_FromArray (Data, NumNodes);
+        double GetTime = TimeGets (LL);
+        double InsertRemoveTime = TimeInsertRemoves (LL);
+        printf ("%10d %16.1f %24.1f\n", NumNodes, GetTime, InsertRemoveTime);
+        LL = LL_Delete (LL);
+    }
+    free (Data);
+    printf ("The allocation count is now %d\n", AllocationCount);
+    return 0;
+}
+
+// function TimeGets reads NUM_CALLS random indices.  The nums read are
+// added up so the reads cannot be left out.
+double TimeGets (LLInfoPtr LL)
+{
+    long Total = 0;
+    clock_t Start = clock();
+    for (int loop = 0; loop < NUM_CALLS; loop++)
+        Total += LL_GetAtIndex (LL, rand () % LL_Length (LL)).num;
+    clock_t End = clock();
+    if (Total < 0)
+        printf ("The nums read added up to less than zero\n");
+    return (double) (End - Start) / CLOCKS_PER_SEC * 1e9 / NUM_CALLS;
+}
+
+// function TimeInsertRemoves inserts at a random index and then removes
+// from another, NUM_CALLS times, so the list keeps its length
+double TimeInsertRemoves (LLInfoPtr LL)
+{
+    UserData D = {0};
+    D.num = -1;
+    clock_t Start = clock();
+    for (int loop = 0; loop < NUM_CALLS; loop++) {
+        LL_InsertAtIndex (LL, D, rand () % (LL_Length (LL) + 1));
+        LL_RemoveAtIndex (LL, rand () % LL_Length (LL));
+    }
+    clock_t End = clock();
+    return (double) (End - Start) / CLOCKS_PER_SEC * 1e9 / NUM_CALLS;
+}
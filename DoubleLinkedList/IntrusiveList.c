@@ -0,0 +1,167 @@
+///////////////////////
+//
+// This intrusive list code is the doubly linked list with the nodes
+// taken away.  The caller's own struct carries an LLLink, and the list
+// only changes the next and prev pointers inside those links, so:
+//      - nothing is allocated or freed, so there is no malloc, no
+//        copy of the caller's data and no extra pointer to follow
+//        to reach the data,
+//      - the caller decides where its structs live (an array, the
+//        stack, a pool) and how long they live, and
+//      - a struct with several LLLink fields can be in several lists
+//        at once, one list per link.
+//
+// The price is that the list cannot check a link is not already in
+// some list, and a struct must be unlinked from every list before the
+// caller frees it.
+//
+///////////////////////
+
+// stdlib provides the definition of NULL
+#include <stdlib.h>
+// assert checks the arguments, like the rest of the list code
+#include <assert.h>
+// IntrusiveList.h defines LLLink and LinkList and declares the functions
+#include "IntrusiveList.h"
+
+/////////////
+// LL_InitLinks readies an empty intrusive list.  The LinkList itself
+// is the caller's, so there is nothing to allocate.
+/////////////
+void LL_InitLinks (LinkListPtr List)
+{
+    assert (List != NULL);
+    List->Head = NULL;
+    List->Tail = NULL;
+    List->NumLinksInList = 0;
+}
+
+/////////////
+// LL_LinkFront puts Link at the front of the list
+/////////////
+void LL_LinkFront (LinkListPtr List, LLLinkPtr Link)
+{
+    assert (List != NULL);
+    assert (Link != NULL);
+    Link->prev = NULL;
+    Link->next = List->Head;
+    // the old first link, if any, now has Link before it; an empty
+    // list gets Link as its end too
+    if (List->Head != NULL)
+        List->Head->prev = Link;
+    else
+        List->Tail = Link;
+    List->Head = Link;
+    List->NumLinksInList++;
+}
+
+/////////////
+// LL_LinkEnd puts Link at the end of the list
+/////////////
+void LL_LinkEnd (LinkListPtr List, LLLinkPtr Link)
+{
+    assert (List != NULL);
+    assert (Link != NULL);
+    Link->next = NULL;
+    Link->prev = List->Tail;
+    if (List->Tail != NULL)
+        List->Tail->next = Link;
+    else
+        List->Head = Link;
+    List->Tail = Link;
+    List->NumLinksInList++;
+}
+
+/////////////
+// LL_LinkBefore puts Link just before Next, which is already in the list
+/////////////
+void LL_LinkBefore (LinkListPtr List, LLLinkPtr Next, LLLinkPtr Link)
+{
+    assert (List != NULL);
+    assert (Next != NULL);
+    assert (Link != NULL);
+    if (Next == List->Head) {
+        LL_LinkFront (List, Link);
+        return;
+    }
+    Link->next = Next;
+    Link->prev = Next->prev;
+    Next->prev->next = Link;
+    Next->prev = Link;
+    List->NumLinksInList++;
+}
+
+/////////////
+// LL_Unlink takes Link out of the list.  Its neighbours (or the list's
+// Head and Tail at the ends) are joined, and Link's own pointers are
+// cleared so a stale link is not followed by mistake.
+/////////////
+void LL_Unlink (LinkListPtr List, LLLinkPtr Link)
+{
+    assert (List != NULL);
+    assert (Link != NULL);
+    assert (List->NumLinksInList > 0);
+    if (Link->prev != NULL)
+        Link->prev->next = Link->next;
+    else {
+        assert (List->Head == Link);
+        List->Head = Link->next;
+    }
+    if (Link->next != NULL)
+        Link->next->prev = Link->prev;
+    else {
+        assert (List->Tail == Link);
+        List->Tail = Link->prev;
+    }
+    Link->next = NULL;
+    Link->prev = NULL;
+    List->NumLinksInList--;
+}
+
+/////////////
+// LL_FirstLink and LL_LastLink return the Head and Tail
+/////////////
+LLLinkPtr LL_FirstLink (LinkListPtr List)
+{
+    assert (List != NULL);
+    return List->Head;
+}
+
+LLLinkPtr LL_LastLink (LinkListPtr List)
+{
+    assert (List != NULL);
+    return List->Tail;
+}
+
+/////////////
+// LL_NextLink and LL_PrevLink follow the link's pointers
+/////////////
+LLLinkPtr LL_NextLink (LLLinkPtr Link)
+{
+    assert (Link != NULL);
+    return Link->next;
+}
+
+LLLinkPtr LL_PrevLink (LLLinkPtr Link)
+{
+    assert (Link != NULL);
+    return Link->prev;
+}
+
+/////////////
+// LL_LinkCount returns the number of links in the list
+/////////////
+int LL_LinkCount (LinkListPtr List)
+{
+    assert (List != NULL);
+    return List->NumLinksInList;
+}
+
+/////////////
+// LL_LinksEmpty is true when the list has no links
+/////////////
+bool LL_LinksEmpty (LinkListPtr List)
+{
+    assert (List != NULL);
+    return List->NumLinksInList == 0;
+}
@@ -0,0 +1,80 @@
+#ifndef INTRUSIVELIST_H_INCLUDED
+#define INTRUSIVELIST_H_INCLUDED
+
+// IntrusiveList.h is the intrusive variant of LinkedList.h.  Instead of
+// the list copying UserData into nodes that it allocates, the caller puts
+// an LLLink inside its own struct and the list only threads pointers
+// through those links.  The list never allocates or frees anything, so
+// there is no AllocationCount here, and an object with several LLLink
+// fields can be in several lists at the same time.
+//
+//      typedef struct {
+//          int    num;
+//          LLLink ByArrival;   // its place in one list
+//          LLLink ByPriority;  // its place in another
+//      } Job;
+//
+//      LinkList Arrivals;
+//      LL_InitLinks (&Arrivals);
+//      LL_LinkEnd (&Arrivals, &aJob.ByArrival);
+//      Job *first = LL_CONTAINER_OF (LL_FirstLink (&Arrivals), Job, ByArrival);
+
+// offsetof is used by LL_CONTAINER_OF
+#include <stddef.h>
+#include <stdbool.h>
+
+// An LLLink is the part of the caller's struct that the list threads.
+// While the struct is in a list the list owns the link; the rest of the
+// struct is left alone.
+typedef struct lllink
+{
+    struct lllink *next;
+    struct lllink *prev;
+} LLLink, *LLLinkPtr;
+
+// A LinkList holds Head and Tail pointers to the first and last links and
+// the running count of links in the list.  It is usually embedded or
+// declared by the caller too; LL_InitLinks readies it.
+typedef struct {
+    LLLinkPtr Head;
+    LLLinkPtr Tail;
+    int       NumLinksInList;
+    } LinkList, *LinkListPtr;
+
+// LL_CONTAINER_OF turns a link back into a pointer to the struct that
+// holds it, given the struct type and the name of the link field
+#define LL_CONTAINER_OF(LinkPtr, Type, Member) \
+    ((Type *) ((char *) (LinkPtr) - offsetof (Type, Member)))
+
+// LL_InitLinks readies an empty intrusive list
+void        LL_InitLinks    (LinkListPtr List);
+
+// LL_LinkFront puts a link that is not in any list at the front, O(1)
+void        LL_LinkFront    (LinkListPtr List, LLLinkPtr Link);
+
+// LL_LinkEnd puts a link that is not in any list at the end, O(1)
+void        LL_LinkEnd      (LinkListPtr List, LLLinkPtr Link);
+
+// LL_LinkBefore puts a link that is not in any list just before Next,
+// which must be in the list, O(1)
+void        LL_LinkBefore   (LinkListPtr List, LLLinkPtr Next, LLLinkPtr Link);
+
+// LL_Unlink takes a link out of the list it is in, O(1).  The struct
+// holding it is not touched otherwise and can be linked again.
+void        LL_Unlink       (LinkListPtr List, LLLinkPtr Link);
+
+// LL_FirstLink and LL_LastLink return the ends of the list, NULL if empty
+LLLinkPtr   LL_FirstLink    (LinkListPtr List);
+LLLinkPtr   LL_LastLink     (LinkListPtr List);
+
+// LL_NextLink and LL_PrevLink step from a link, NULL past either end
+LLLinkPtr   LL_NextLink     (LLLinkPtr Link);
+LLLinkPtr   LL_PrevLink     (LLLinkPtr Link);
+
+// LL_LinkCount returns the number of links in the list
+int         LL_LinkCount    (LinkListPtr List);
+
+// LL_LinksEmpty is true when the list has no links
+bool        LL_LinksEmpty   (LinkListPtr List);
+
+#endif // INTRUSIVELIST_H_INCLUDED
@@ -0,0 +1,92 @@
+//
+//  IntrusiveListTester
+//
+//  This is a simple demonstration of the intrusive list functions.
+//  It demos the abilities to:
+//      Embed links in our own struct so the list allocates nothing
+//      Add items to the front and end of a list - uses calls to
+//          LL_LinkFront() and LL_LinkEnd()
+//      Put the same item in two lists at once, one per link in the struct
+//      Take an item out of one list in O(1) without touching the other
+//          - uses call to LL_Unlink()
+//      Get back from a link to the struct holding it - uses LL_CONTAINER_OF
+//  The Jobs live in an ordinary array; the lists only point into it.
+
+// we use printf from stdio.h
+#include <stdio.h>
+// we use the intrusive list, so include its functions that we can call
+#include "IntrusiveList.h"
+
+// A Job is our own struct.  It is in the arrival order list through
+// ByArrival and, when urgent, in the urgent list through Urgent.
+typedef struct {
+    int    num;
+    LLLink ByArrival;
+    LLLink Urgent;
+} Job;
+
+// PrintArrivals and PrintUrgent print a message (msg) and then the nums of
+// the Jobs in a list, following the link the list is threaded through
+static void PrintArrivals (char msg[], LinkListPtr List);
+static void PrintUrgent (char msg[], LinkListPtr List);
+
+// The number of jobs used
+#define NUMJOBS 6
+
+int main(int argc, const char * argv[]) {
+    Job Jobs[NUMJOBS];
+    LinkList Arrivals;
+    LinkList UrgentJobs;
+    LL_InitLinks (&Arrivals);
+    LL_InitLinks (&UrgentJobs);
+
+    // every job arrives in order, and every third one is also urgent,
+    // with the newest urgent job first
+    for (int loop = 0; loop < NUMJOBS; loop++) {
+        Jobs[loop].num = 10 * (loop + 1);
+        LL_LinkEnd (&Arrivals, &Jobs[loop].ByArrival);
+        if (loop % 3 == 0)
+            LL_LinkFront (&UrgentJobs, &Jobs[loop].Urgent);
+    }
+    PrintArrivals ("All jobs by arrival", &Arrivals);
+    PrintUrgent ("Urgent jobs, newest first", &UrgentJobs);
+
+    // job 40 is done urgently: it leaves both lists, and nothing is freed
+    LL_Unlink (&UrgentJobs, &Jobs[3].Urgent);
+    LL_Unlink (&Arrivals, &Jobs[3].ByArrival);
+    PrintArrivals ("After job 40 is done, by arrival", &Arrivals);
+    PrintUrgent ("After job 40 is done, urgent", &UrgentJobs);
+
+    // job 20 becomes urgent and goes just before job 10 in the urgent list
+    LL_LinkBefore (&UrgentJobs, &Jobs[0].Urgent, &Jobs[1].Urgent);
+    PrintUrgent ("After job 20 becomes urgent", &UrgentJobs);
+
+    // the first arrival can be found from its link
+    Job *First = LL_CONTAINER_OF (LL_FirstLink (&Arrivals), Job, ByArrival);
+    printf ("The first job to arrive is %d\n", First->num);
+
+    // empty the lists; the Jobs array is the caller's and is not freed
+    while (!LL_LinksEmpty (&Arrivals))
+        LL_Unlink (&Arrivals, LL_FirstLink (&Arrivals));
+    while (!LL_LinksEmpty (&UrgentJobs))
+        LL_Unlink (&UrgentJobs, LL_LastLink (&UrgentJobs));
+    PrintArrivals ("After emptying, by arrival", &Arrivals);
+    PrintUrgent ("After emptying, urgent", &UrgentJobs);
+    return 0;
+}
+
+void PrintArrivals (char msg[], LinkListPtr List)
+{
+    printf ("%s (%d jobs):", msg, LL_LinkCount (List));
+    for (LLLinkPtr Link = LL_FirstLink (List); Link != NULL; Link = LL_NextLink (Link))
+        printf (" %d", LL_CONTAINER_OF (Link, Job, ByArrival)->num);
+    printf ("\n");
+}
+
+void PrintUrgent (char msg[], LinkListPtr List)
+{
+    printf ("%s (%d jobs):", msg, LL_LinkCount (List));
+    for (LLLinkPtr Link = LL_FirstLink (List); Link != NULL; Link = LL_NextLink (Link))
+        printf (" %d", LL_CONTAINER_OF (Link, Job, Urgent)->num);
+    printf ("\n");
+}
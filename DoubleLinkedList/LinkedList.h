@@ -3,6 +3,28 @@
 
 // The LL functions use UserData
 #include "UserData.h"
+// The comparison used to sort a LL returns a bool
+#include <stdbool.h>
+
+// Building with LL_UNROLLED defined selects the unrolled list, which
+// keeps many UserData in each block instead of one per node.  Its layout
+// is in UnrolledList.h.  Building with LL_COMPACT defined selects the
+// compact list, which keeps the nodes in one array linked by 32 bit
+// indices.  Its layout is in CompactList.h.  Building with LL_SKIPLIST
+// defined selects the skip list, whose extra levels of links find any
+// index in O(log n) steps.  Its layout is in SkipList.h.  Every function
+// declared below, up to the node only ones, works the same way with any
+// layout.
+#if defined (LL_UNROLLED)
+#include "UnrolledList.h"
+#elif defined (LL_COMPACT)
+#include "CompactList.h"
+#elif defined (LL_SKIPLIST)
+#include "SkipList.h"
+#else
+// LL_NODES is defined when the list is made of Nodes, which is what
+// the cursor, splice, node swap and sort functions work on
+#define LL_NODES
 
 // The Linked List needs the definition of what a Node is. A Node has
 // UserData and linkage information for both "next and "prev"
@@ -21,16 +43,22 @@ typedef struct node
 // currently in the LL started at Head and finishing at Tail.
 // Head is used when adding or removing from the LL front,
 // Tail is needed only when adding to the end of the LL
+// Finger remembers the last node located by index (and FingerIndex its
+// index) so that the next index lookup can start there when it is closer
+// than Head or Tail.  Finger is NULL when there is no remembered node.
 typedef struct {
     NodePtr Head;
     NodePtr Tail;
     int     NumNodesInList;
+    NodePtr Finger;
+    int     FingerIndex;
     } LLInfo, *LLInfoPtr;
+#endif // LL_UNROLLED, LL_COMPACT, LL_SKIPLIST
 
 // Verifying allocation / deallocation of dynamic memory is done through
-// AllocationCount.  The variable is declared in the LinkedList.c code and
-// is linked to through the extern
-extern int AllocationCount;
+// the memory account, which keeps the list nodes and LLInfo blocks apart
+// and still provides AllocationCount for reading
+#include "MemoryAccount.h"
 
 // ShouldDelete is an enum that has two valid values called DELETE_NODE
 // and RETAIN_NODE that are used in calling to get user data from the front
@@ -63,4 +91,100 @@ UserData        LL_GetAtIndex   (LLInfoPtr, int FetchIndex);
 void            LL_SetAtIndex   (LLInfoPtr LLI_Ptr, UserData D, int UpdateIndex);
 // LL_Swap swaps the nodes in the underlying LL specified by indices starting at 0
 void            LL_Swap         (LLInfoPtr LLI_Ptr, int Index1, int Index2);
+// LL_InsertAtIndex adds user data so that it is at the specified index starting at 0,
+// moving the nodes from there on one index along (the index may be the length of the LL)
+void            LL_InsertAtIndex (LLInfoPtr LLI_Ptr, UserData theData, int InsertIndex);
+// LL_RemoveAtIndex removes the node at the specified index starting at 0 and returns
+// its user data
+UserData        LL_RemoveAtIndex (LLInfoPtr LLI_Ptr, int RemoveIndex);
+
+// The functions below hand out the address of user data inside the LL rather than
+// a copy, so a large UserData is not copied.  An address is good until the user
+// data it points to is deleted or, with the unrolled or compact layout, until
+// anything is added to the LL or removed from it by index (which may move it).
+
+// LL_PeekFrontPtr returns the address of the user data at the Head of the underlying LL
+UserData       *LL_PeekFrontPtr    (LLInfoPtr LLI_Ptr);
+// LL_AtIndexPtr returns the address of the user data at the specified index starting at 0
+UserData       *LL_AtIndexPtr      (LLInfoPtr LLI_Ptr, int FetchIndex);
+// LL_EmplaceFront adds a node at the Head and returns the address of its user data for
+// the caller to fill in
+UserData       *LL_EmplaceFront    (LLInfoPtr LLI_Ptr);
+// LL_EmplaceEnd adds a node at the Tail and returns the address of its user data for
+// the caller to fill in
+UserData       *LL_EmplaceEnd      (LLInfoPtr LLI_Ptr);
+
+// The batch functions below move many UserData in a single call
+
+// LL_AddAtEndBatch adds Count user data from the array to the Tail, keeping their order
+void            LL_AddAtEndBatch   (LLInfoPtr LLI_Ptr, const UserData *Data, int Count);
+// LL_AddAtFrontBatch adds Count user data from the array to the Head, giving the same
+// list as calling LL_AddAtFront for each of them in turn (the last one ends up at the Head)
+void            LL_AddAtFrontBatch (LLInfoPtr LLI_Ptr, const UserData *Data, int Count);
+// LL_DrainFront removes up to MaxCount user data from the Head into Out, returning
+// how many were removed
+int             LL_DrainFront      (LLInfoPtr LLI_Ptr, UserData *Out, int MaxCount);
+// LL_ToArray copies up to MaxCount user data, starting at the Head, into Out without
+// changing the LL, returning how many were copied
+int             LL_ToArray         (LLInfoPtr LLI_Ptr, UserData *Out, int MaxCount);
+// LL_FromArray allocates a LL Information structure holding the Count user data of
+// the array in order, returning the address of the structure
+LLInfoPtr       LL_FromArray       (const UserData *Data, int Count);
+
+// LLVisitor is any function that, when called by LL_ForEach, receives the
+// address of a node's user data (which it may update) and the caller's Context
+typedef void (*LLVisitor) (UserData *Data, void *Context);
+
+// LL_ForEach calls Visit once for every node, from the Head to the Tail
+void            LL_ForEach         (LLInfoPtr LLI_Ptr, LLVisitor Visit, void *Context);
+
+#ifdef LL_NODES
+// A cursor marks one node in the underlying LL so that the LL can be walked and
+// changed at that node without counting from the Head.  LL_End is the position
+// just past the Tail (a NULL node).
+typedef NodePtr LLCursor;
+
+// LL_Begin returns a cursor at the Head (LL_End if the LL is empty)
+LLCursor        LL_Begin           (LLInfoPtr LLI_Ptr);
+// LL_End returns the cursor just past the Tail
+LLCursor        LL_End             (LLInfoPtr LLI_Ptr);
+// LL_Next returns the cursor at the node after Cursor
+LLCursor        LL_Next            (LLInfoPtr LLI_Ptr, LLCursor Cursor);
+// LL_Prev returns the cursor at the node before Cursor (the Tail when Cursor is LL_End)
+LLCursor        LL_Prev            (LLInfoPtr LLI_Ptr, LLCursor Cursor);
+// LL_GetAtCursor returns the user data at Cursor
+UserData        LL_GetAtCursor     (LLInfoPtr LLI_Ptr, LLCursor Cursor);
+// LL_SetAtCursor updates the user data at Cursor
+void            LL_SetAtCursor     (LLInfoPtr LLI_Ptr, LLCursor Cursor, UserData D);
+// LL_InsertBefore adds user data just before Cursor (at the Tail when Cursor is LL_End)
+// and returns the cursor at the new node
+LLCursor        LL_InsertBefore    (LLInfoPtr LLI_Ptr, LLCursor Cursor, UserData theData);
+// LL_Erase deletes the node at Cursor and returns the cursor at the node that followed it
+LLCursor        LL_Erase           (LLInfoPtr LLI_Ptr, LLCursor Cursor);
+
+// The functions below move nodes from one LL to another by relinking them,
+// without copying user data or allocating nodes
+
+// LL_Concat moves every node of Src to the Tail of Dst, leaving Src empty
+void            LL_Concat          (LLInfoPtr Dst, LLInfoPtr Src);
+// LL_SpliceAt moves every node of Src into Dst so that the first of them is at
+// Index (0 to LL_Length of Dst), leaving Src empty
+void            LL_SpliceAt        (LLInfoPtr Dst, int Index, LLInfoPtr Src);
+// LL_SplitAt moves the nodes from Index (0 to LL_Length) to the Tail into a newly
+// allocated LL Information structure and returns its address
+LLInfoPtr       LL_SplitAt         (LLInfoPtr LLI_Ptr, int Index);
+
+// LL_SwapNodes swaps the nodes at Index1 and Index2 by exchanging their places in
+// the LL rather than their user data, so its cost does not depend on the UserData size
+void            LL_SwapNodes       (LLInfoPtr LLI_Ptr, int Index1, int Index2);
+
+// LLComparison is any function that, when called by LL_Sort, receives the
+// addresses of two user data and returns true if the first has to come
+// before the second (false if they are equal or the second comes first)
+typedef bool (*LLComparison) (const UserData *first, const UserData *second);
+
+// LL_Sort puts the nodes in the order given by InOrder, keeping nodes that
+// compare equal in the order they were in
+void            LL_Sort            (LLInfoPtr LLI_Ptr, LLComparison InOrder);
+#endif // LL_NODES
 #endif // LINKEDLIST_H_INCLUDED
@@ -10,8 +10,12 @@
 //          - uses call to LL_GetFront with option to delete or retain the data
 //      Treat the list like an array, getting or an item by specifying the
 //          index of the item (0 is the front) - uses call to LL_GetAtIndex()
+//      Insert and remove items in the middle of the list by index - uses calls
+//          to LL_InsertAtIndex() and LL_RemoveAtIndex()
 //      Whenever we want to see how many items are inside the list, we call
 //          LL_Length() to return the item count.
+//      Make a linked list straight from an array - uses call to LL_FromArray()
+//      Remove several items from the front at once - uses call to LL_DrainFront()
 //  This code has been "overly documented" so that it serves as a learning
 //  piece of code.  Take the time to read and undersatand it!
 
@@ -27,14 +31,22 @@
 // it will also print out the number of things allocated
 static void PrintLL (char msg[], LLInfoPtr theLL);
 
+// PrintLLNode is a local function that LL_ForEach calls for each node while
+// PrintLL is printing the list.  The context is a PrintPosition that tracks
+// which node it is at.
+typedef struct {
+    int Index;
+    int Length;
+} PrintPosition;
+static void PrintLLNode (UserData *D, void *Context);
+
 // PrintLLitem is a local function that we can call to print out a message (msg) and
 // a UserData item.  So we can see how many things are allocated as we proceed,
 // it will also print out the number of things allocated
 static void PrintLLItem (char msg[], UserData D);
 
-// AllocationCount is declared for global use in the list code itself.  We extern it so that
+// AllocationCount comes from the memory account, through LinkedList.h, so that
 // we can see how the allocations are inceeasing or decreasing.
-extern int AllocationCount;
 
 // The array size used
 #define ARRAYSIZE 7
@@ -91,27 +103,58 @@ int main(int argc, const char * argv[]) {
         PrintLLItem ("A data item has been removed from the front of the LL.. ", D);
         }
     PrintLL ("After data has been removed from the LL..", LL);
+
+    // add an item in the middle of the LL, then take out the one after it
+    UserData Middle = { 5 };
+    LL_InsertAtIndex(LL, Middle, LL_Length(LL)/2);
+    PrintLL ("After a data item has been inserted in the middle of the LL..", LL);
+    UserData Removed = LL_RemoveAtIndex(LL, LL_Length(LL)/2 + 1);
+    PrintLLItem ("A data item has been removed from the middle of the LL.. ", Removed);
+    PrintLL ("After data has been removed from the middle of the LL..", LL);
+    LL = LL_Delete(LL);
+    PrintLL ("After the LL has been deleted...", LL);
+
+    // make a LL from the whole array in one call
+    LL = LL_FromArray(DemoData, NumDemoDataItems);
+    PrintLL ("After the LL has been made from the array...", LL);
+    // remove the first few items in one call, reusing the front of the array
+    int NumDrained = LL_DrainFront(LL, DemoData, 3);
+    for (int loop = 0; loop < NumDrained; loop++)
+        PrintLLItem ("A data item has been drained from the front of the LL.. ", DemoData[loop]);
+    PrintLL ("After data has been drained from the LL..", LL);
     LL = LL_Delete(LL);
     PrintLL ("After the LL has been deleted...", LL);
+
+    // show how much memory the list needed at its largest
+    MA_Report (stdout);
     return 0;
 }
 
 // function PrintLL is called to print out a message, followed by the contents of the list
-// To determine the items to print, it uses the LL_Length function to get the list size
-// and then calls the LL_GetAtIndex function to read the UserData for each node in the list.
+// It uses the LL_Length function to get the list size and then calls LL_ForEach to have
+// PrintLLNode print the UserData of each node in the list, in a single walk of the list.
 void PrintLL (char msg[], LLInfoPtr theLL)
 {
     printf ("%s\nThere are now %d items with an allocation count of %d\n",
             msg, LL_Length(theLL), AllocationCount);
-    for (int loop = 0; loop < LL_Length(theLL); loop++)
-    {
-        UserData D = LL_GetAtIndex(theLL, loop);
-        if (loop == 0)
-            printf  ("Head==> [%d] = %d\n", loop, D.num);
-        else if (loop == LL_Length(theLL)-1)
-            printf  ("Tail==> [%d] = %d\n", loop, D.num);
-        else printf ("        [%d] = %d\n", loop, D.num);
-    }
+    // a deleted LL has nothing to print
+    if (theLL == NULL)
+        return;
+    PrintPosition Position = {0, LL_Length(theLL)};
+    LL_ForEach (theLL, PrintLLNode, &Position);
+}
+
+// function PrintLLNode prints one node's UserData, marking the Head and the Tail.
+// Its context is the PrintPosition giving the index of the node and the list size.
+void PrintLLNode (UserData *D, void *Context)
+{
+    PrintPosition *Position = (PrintPosition *) Context;
+    int loop = Position->Index++;
+    if (loop == 0)
+        printf  ("Head==> [%d] = %d\n", loop, D->num);
+    else if (loop == Position->Length-1)
+        printf  ("Tail==> [%d] = %d\n", loop, D->num);
+    else printf ("        [%d] = %d\n", loop, D->num);
 }
 
 // function PrintLLItem is called to print out a message, followed by the contents of a
@@ -0,0 +1,539 @@
+///////////////////////
+//
+// This skip list code provides the same functions as the unrolled list,
+// declared in LinkedList.h, and is used in place of DoubleLinkedList.c
+// when the list is built with LL_SKIPLIST defined.
+//
+// WHY?... Every other layout finds the UserData at an index by walking
+// to it, so a list of millions of UserData used by index (or added to
+// and removed from in the middle) spends nearly all its time walking.
+// The skip list keeps the level 0 links of an ordinary singly linked
+// list and adds "express" levels above them:
+//
+//      - Each new node reaches level 1 with a chance of one in four,
+//        level 2 with a chance of one in sixteen and so on, so each
+//        level links about a quarter of the nodes of the level below.
+//      - Each link remembers its Span, the number of positions it
+//        jumps, so adding up the Spans followed gives the position
+//        reached without visiting the nodes skipped over.
+//      - Finding an index starts at the top level of the Header and
+//        follows links for as long as they do not overshoot, then drops
+//        a level, which takes O(log n) steps on average.
+//
+// Inserting or removing a node at an index finds the link before it on
+// every level on the way down (the Update links), relinks the levels
+// the node reaches and adds or takes one from the Span of the levels
+// above it that jump over it.
+//
+// Nodes are never moved once made, so the address of a UserData is
+// good until that UserData is removed.
+//
+///////////////////////
+
+// stdlib provides the definition of NULL and the declarations for
+// malloc() and free()
+#include <stdlib.h>
+// assert is used to check the calls are valid
+#include <assert.h>
+// The list needs UserData to know what each node holds
+#include "UserData.h"
+// LinkedList.h declares the functions callable for a linked list and,
+// with LL_SKIPLIST defined, pulls in the skip list layout from SkipList.h
+#include "LinkedList.h"
+
+// locally called function declarations follow..
+//
+// MakeNode is called to allocate an unlinked node with Levels skip links
+static SkipNodePtr MakeNode (int Levels);
+
+// FreeNode frees a node that has been unlinked from every level
+static void FreeNode (SkipNodePtr theNode);
+
+// RandomLevel draws the number of levels for a new node
+static int RandomLevel (LLInfoPtr LLI_Ptr);
+
+// FindPosition walks down to Position (0 is the Header), returning the
+// node there and, when Update is not NULL, the last link on each level
+// at or before Position and the position Rank it leaves from
+static SkipNodePtr FindPosition (LLInfoPtr LLI_Ptr, int Position, SkipLink *Update[], int Rank[]);
+
+// InsertNode links a new node in at InsertIndex and returns the address
+// of its UserData
+static UserData *InsertNode (LLInfoPtr LLI_Ptr, int InsertIndex);
+
+// RemoveNode unlinks and frees the node at RemoveIndex, returning its UserData
+static UserData RemoveNode (LLInfoPtr LLI_Ptr, int RemoveIndex);
+
+// Externally callable functions for a user of the Linked List
+// follow
+
+/////////////
+// LL_Init is used to allocate and initialize a LinkedList
+// Information structure.  The list starts with the single level 0,
+// whose Header link leads nowhere and spans to position 1, just past
+// the (empty) list.  It will update the memory account to reflect the
+// malloc of the struct and return the pointer to the struct for the
+// caller to use when calling any other function in the linked list
+/////////////
+LLInfoPtr LL_Init()
+{
+    // Allocate a Linked List Information structure
+    LLInfoPtr LLI_Ptr = (LLInfoPtr) malloc (sizeof (LLInfo));
+    assert (LLI_Ptr != NULL);
+    // Initialize the data in the struct just allocated
+    for (int level = 0; level < SKIP_MAX_LEVEL; level++) {
+        LLI_Ptr->Header[level].next = NULL;
+        LLI_Ptr->Header[level].Span = 1;
+    }
+    LLI_Ptr->Level = 1;
+    LLI_Ptr->NumNodesInList = 0;
+    // any non zero state will do; a fixed one makes runs repeatable
+    LLI_Ptr->Random = 2463534242u;
+    // update the memory account to reflect the malloc
+    MA_Allocated (MA_LL_INFO, sizeof (LLInfo));
+    // return the pointer to the allocated struct to the caller
+    return LLI_Ptr;
+}
+
+/////////////
+// LL_Delete is called to delete all of the nodes in the Linked
+// List identified by LL_Ptr.  Every node is on level 0, so the nodes
+// are freed in turn by following it.  Once all the nodes are gone, it
+// frees the LinkedList information struct and updates the memory
+// account to reflect the memory release.
+/////////////
+LLInfoPtr LL_Delete(LLInfoPtr LLI_Ptr)
+{
+    // We should not have been called if the Linked List
+    // Information structure does not exist
+    assert (LLI_Ptr != NULL);
+    // free every node along level 0
+    SkipNodePtr curr = LLI_Ptr->Header[0].next;
+    while (curr != NULL) {
+        SkipNodePtr nextNode = curr->Link[0].next;
+        FreeNode (curr);
+        curr = nextNode;
+    }
+    // Now that all the nodes are gone, delete the Information
+    // structure itself
+    free(LLI_Ptr);
+    LLI_Ptr = NULL;
+    MA_Released (MA_LL_INFO, sizeof (LLInfo));
+    // return a NULL because the list structure no longer exists
+    return NULL;
+}
+
+/////////////
+// LL_AddAtFront is called to add the UserData to the front of the list.
+// The Header is the link before the front on every level, so nothing
+// has to be walked.
+/////////////
+void LL_AddAtFront (LLInfoPtr LLI_Ptr, UserData theData)
+{
+    *LL_EmplaceFront (LLI_Ptr) = theData;
+}
+
+/////////////
+// LL_EmplaceFront links a new node in at the front of the list, just
+// as LL_AddAtFront does, and returns the address of its UserData for
+// the caller to fill in place.
+/////////////
+UserData *LL_EmplaceFront (LLInfoPtr LLI_Ptr)
+{
+    // We should not have been called if the Linked List
+    // Information structure does not exist
+    assert (LLI_Ptr != NULL);
+    return InsertNode (LLI_Ptr, 0);
+}
+
+/////////////
+// LL_AddAtEnd is called to add the UserData to the end of the list.
+// The last link on each level is found by walking down to the last
+// position, so this takes O(log n) steps.
+/////////////
+void LL_AddAtEnd (LLInfoPtr LLI_Ptr, UserData theData)
+{
+    *LL_EmplaceEnd (LLI_Ptr) = theData;
+}
+
+/////////////
+// LL_EmplaceEnd links a new node in at the end of the list, just as
+// LL_AddAtEnd does, and returns the address of its UserData for the
+// caller to fill in place.
+/////////////
+UserData *LL_EmplaceEnd (LLInfoPtr LLI_Ptr)
+{
+    // We should not have been called if the Linked List
+    // Information structure does not exist
+    assert (LLI_Ptr != NULL);
+    return InsertNode (LLI_Ptr, LLI_Ptr->NumNodesInList);
+}
+
+/////////////
+// LL_GetFront returns the UserData at the front of the list, which is
+// the node after the Header on level 0.  When asked to delete it, the
+// node is unlinked from every level it reaches.
+/////////////
+UserData LL_GetFront (LLInfoPtr LLI_Ptr, ShouldDelete Choice)
+{
+    // We should not have been called if the Linked List
+    // Information structure does not exist or if the list is empty
+    assert (LLI_Ptr != NULL);
+    assert (LLI_Ptr->NumNodesInList > 0);
+    assert ((Choice == DELETE_NODE) || (Choice == RETAIN_NODE));
+    if (Choice == DELETE_NODE)
+        return RemoveNode (LLI_Ptr, 0);
+    return LLI_Ptr->Header[0].next->Data;
+}
+
+/////////////
+// LL_Length returns the number of nodes in the underlying LL.
+// It allows calls to be made even if the underlying LL does not
+// exist, returning a count of zero under this condition
+/////////////
+int  LL_Length  (LLInfoPtr LLI_Ptr)
+{
+    return (LLI_Ptr == NULL) ? 0 : LLI_Ptr->NumNodesInList;
+}
+
+/////////////
+// LL_GetAtIndex returns the user data at the specified index
+// in the underlying LL.
+/////////////
+UserData  LL_GetAtIndex (LLInfoPtr LLI_Ptr, int FetchIndex)
+{
+    return *LL_AtIndexPtr (LLI_Ptr, FetchIndex);
+}
+
+/////////////
+// LL_SetAtIndex updates the UserData at the specified index
+// in the underlying LL to what was provided by the caller.
+/////////////
+void  LL_SetAtIndex (LLInfoPtr LLI_Ptr, UserData D, int UpdateIndex)
+{
+    *LL_AtIndexPtr (LLI_Ptr, UpdateIndex) = D;
+}
+
+//////////////
+// LL_Swap swaps the UserData at the specified indices Index1 and Index2
+// in the underlying LL.
+/////////////
+void  LL_Swap (LLInfoPtr LLI_Ptr, int Index1, int Index2)
+{
+    // no need to do anything if the indices are the same
+    if (Index1 == Index2)
+        return;
+    // nodes never move, so both addresses stay good while we swap
+    // through them
+    UserData *Data1 = LL_AtIndexPtr (LLI_Ptr, Index1);
+    UserData *Data2 = LL_AtIndexPtr (LLI_Ptr, Index2);
+    UserData temp = *Data1;
+    *Data1 = *Data2;
+    *Data2 = temp;
+}
+
+/////////////
+// LL_PeekFrontPtr returns the address of the UserData at the front
+// instead of a copy of it
+/////////////
+UserData *LL_PeekFrontPtr (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    assert (LLI_Ptr->NumNodesInList > 0);
+    return &LLI_Ptr->Header[0].next->Data;
+}
+
+/////////////
+// LL_AtIndexPtr returns the address of the UserData at the specified
+// index instead of a copy of it.  The node at index i is at position
+// i + 1, counting the Header as position 0.
+/////////////
+UserData *LL_AtIndexPtr (LLInfoPtr LLI_Ptr, int FetchIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((FetchIndex >= 0) && (FetchIndex < LLI_Ptr->NumNodesInList) );
+    return &FindPosition (LLI_Ptr, FetchIndex + 1, NULL, NULL)->Data;
+}
+
+/////////////
+// LL_InsertAtIndex adds theData so that it ends up at InsertIndex,
+// moving the UserData from there on one index along.  InsertIndex may
+// be the length of the list, which adds at the end.
+/////////////
+void LL_InsertAtIndex (LLInfoPtr LLI_Ptr, UserData theData, int InsertIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((InsertIndex >= 0) && (InsertIndex <= LLI_Ptr->NumNodesInList) );
+    *InsertNode (LLI_Ptr, InsertIndex) = theData;
+}
+
+/////////////
+// LL_RemoveAtIndex removes the UserData at RemoveIndex, moving the
+// UserData after it one index closer to the front, and returns it.
+/////////////
+UserData LL_RemoveAtIndex (LLInfoPtr LLI_Ptr, int RemoveIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((RemoveIndex >= 0) && (RemoveIndex < LLI_Ptr->NumNodesInList) );
+    return RemoveNode (LLI_Ptr, RemoveIndex);
+}
+
+/////////////
+// LL_AddAtEndBatch is called to add Count UserData from the array
+// Data to the end of the list, in array order.
+// The last link on each level is found once.  Each new node is then
+// linked after the last link of every level it reaches and becomes the
+// last link there, so the batch walks the list only once.  The links
+// at the end of each level only get their final Span once the whole
+// batch is in.
+/////////////
+void LL_AddAtEndBatch (LLInfoPtr LLI_Ptr, const UserData *Data, int Count)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Count >= 0 && (Data != NULL || Count == 0));
+    SkipLink *Update[SKIP_MAX_LEVEL];
+    int Rank[SKIP_MAX_LEVEL];
+    FindPosition (LLI_Ptr, LLI_Ptr->NumNodesInList, Update, Rank);
+    for (int loop = 0; loop < Count; loop++) {
+        int Levels = RandomLevel (LLI_Ptr);
+        for (int level = LLI_Ptr->Level; level < Levels; level++) {
+            LLI_Ptr->Header[level].next = NULL;
+            Update[level] = &LLI_Ptr->Header[level];
+            Rank[level] = 0;
+        }
+        if (Levels > LLI_Ptr->Level)
+            LLI_Ptr->Level = Levels;
+        // the new node is at the position just past the end
+        int Position = ++LLI_Ptr->NumNodesInList;
+        SkipNodePtr NewNode = MakeNode (Levels);
+        NewNode->Data = Data[loop];
+        for (int level = 0; level < Levels; level++) {
+            Update[level]->next = NewNode;
+            Update[level]->Span = Position - Rank[level];
+            NewNode->Link[level].next = NULL;
+            Update[level] = &NewNode->Link[level];
+            Rank[level] = Position;
+        }
+    }
+    // the last link on every level now spans to just past the end
+    for (int level = 0; level < LLI_Ptr->Level; level++)
+        Update[level]->Span = LLI_Ptr->NumNodesInList + 1 - Rank[level];
+}
+
+/////////////
+// LL_AddAtFrontBatch is called to add Count UserData from the array
+// Data to the front of the list.  The result is the same as calling
+// LL_AddAtFront for Data[0] up to Data[Count-1], so the array ends up
+// reversed: Data[Count-1] becomes the first UserData in the list.
+// Adding at the front walks nothing, so each is simply added in turn.
+/////////////
+void LL_AddAtFrontBatch (LLInfoPtr LLI_Ptr, const UserData *Data, int Count)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Count >= 0 && (Data != NULL || Count == 0));
+    for (int loop = 0; loop < Count; loop++)
+        *InsertNode (LLI_Ptr, 0) = Data[loop];
+}
+
+/////////////
+// LL_DrainFront is called to remove up to MaxCount UserData from the
+// front of the list, copying them into Out in list order.
+// It returns the number of UserData removed.
+/////////////
+int LL_DrainFront (LLInfoPtr LLI_Ptr, UserData *Out, int MaxCount)
+{
+    assert (LLI_Ptr != NULL);
+    assert (MaxCount >= 0 && (Out != NULL || MaxCount == 0));
+    int Drained = 0;
+    while (Drained < MaxCount && LLI_Ptr->NumNodesInList > 0)
+        Out[Drained++] = RemoveNode (LLI_Ptr, 0);
+    return Drained;
+}
+
+/////////////
+// LL_ToArray copies up to MaxCount UserData, starting at the front of
+// the list, into Out, following level 0.  The list is not changed.
+// It returns the number of UserData copied.
+/////////////
+int LL_ToArray (LLInfoPtr LLI_Ptr, UserData *Out, int MaxCount)
+{
+    assert (LLI_Ptr != NULL);
+    assert (MaxCount >= 0 && (Out != NULL || MaxCount == 0));
+    int Copied = 0;
+    for (SkipNodePtr curr = LLI_Ptr->Header[0].next; curr != NULL && Copied < MaxCount; curr = curr->Link[0].next)
+        Out[Copied++] = curr->Data;
+    return Copied;
+}
+
+/////////////
+// LL_FromArray makes a new list holding the Count UserData in the
+// array Data, in array order.  The caller deletes it with LL_Delete
+// just like a list made by LL_Init.
+/////////////
+LLInfoPtr LL_FromArray (const UserData *Data, int Count)
+{
+    LLInfoPtr LLI_Ptr = LL_Init();
+    LL_AddAtEndBatch (LLI_Ptr, Data, Count);
+    return LLI_Ptr;
+}
+
+/////////////
+// LL_ForEach calls Visit for each UserData from the Head to the Tail,
+// passing its address and the caller's Context.  Visit may update the
+// UserData but must not add or delete any.
+/////////////
+void LL_ForEach (LLInfoPtr LLI_Ptr, LLVisitor Visit, void *Context)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Visit != NULL);
+    for (SkipNodePtr curr = LLI_Ptr->Header[0].next; curr != NULL; curr = curr->Link[0].next)
+        Visit (&curr->Data, Context);
+}
+
+/////////////
+// Local function MakeNode allocates a node with room for Levels skip
+// links after its UserData.  The caller links it in.
+/////////////
+SkipNodePtr MakeNode (int Levels)
+{
+    SkipNodePtr NewNode = (SkipNodePtr) malloc (sizeof (SkipNode) + Levels * sizeof (SkipLink));
+    assert (NewNode != NULL);
+    NewNode->Levels = Levels;
+    // Update the memory account to reflect the malloc
+    MA_Allocated (MA_LIST_NODE, sizeof (SkipNode) + Levels * sizeof (SkipLink));
+    return NewNode;
+}
+
+/////////////
+// Local function FreeNode frees a node, working out its size from the
+// number of levels it has
+/////////////
+void FreeNode (SkipNodePtr theNode)
+{
+    size_t Bytes = sizeof (SkipNode) + theNode->Levels * sizeof (SkipLink);
+    free (theNode);
+    // Update the memory account to reflect the free
+    MA_Released (MA_LIST_NODE, Bytes);
+}
+
+/////////////
+// Local function RandomLevel gives a new node one level, then keeps
+// adding another with a chance of one in four, up to SKIP_MAX_LEVEL.
+// The draws come from a xorshift generator kept in the list, so lists
+// do not share any state.
+/////////////
+int RandomLevel (LLInfoPtr LLI_Ptr)
+{
+    int Levels = 1;
+    while (Levels < SKIP_MAX_LEVEL) {
+        uint32_t x = LLI_Ptr->Random;
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        LLI_Ptr->Random = x;
+        if ((x & 3) != 0)
+            break;
+        Levels++;
+    }
+    return Levels;
+}
+
+/////////////
+// FindPosition is a utility function that walks down from the top
+// level of the Header to Position.  On each level it follows links for
+// as long as the Span does not take it past Position, then drops to the
+// level below.  Level 0 has a Span of 1 everywhere, so the walk always
+// ends exactly at Position.
+// When Update is not NULL, Update[level] is left at the last link on
+// each level that starts at or before Position and Rank[level] at the
+// position of the node (or Header) that link belongs to.
+/////////////
+SkipNodePtr FindPosition (LLInfoPtr LLI_Ptr, int Position, SkipLink *Update[], int Rank[])
+{
+    SkipNodePtr curr = NULL;
+    SkipLink *Links = LLI_Ptr->Header;
+    int at = 0;
+    for (int level = LLI_Ptr->Level - 1; level >= 0; level--) {
+        while (Links[level].next != NULL && at + Links[level].Span <= Position) {
+            at += Links[level].Span;
+            curr = Links[level].next;
+            Links = curr->Link;
+        }
+        if (Update != NULL) {
+            Update[level] = &Links[level];
+            Rank[level] = at;
+        }
+    }
+    return curr;
+}
+
+/////////////
+// Local function InsertNode makes a node and links it in at position
+// InsertIndex + 1, just after position InsertIndex:
+//      on the levels it reaches, the Update link's Span is split between
+//          the Update link (up to the new node) and the new node (from
+//          it to where the Update link used to lead, now one further on)
+//      on the levels above, the Update link jumps over it, so its Span
+//          grows by one
+// A node reaching higher than any before it raises the list's Level;
+// the new levels start at the Header with nothing after it.
+/////////////
+UserData *InsertNode (LLInfoPtr LLI_Ptr, int InsertIndex)
+{
+    SkipLink *Update[SKIP_MAX_LEVEL];
+    int Rank[SKIP_MAX_LEVEL];
+    FindPosition (LLI_Ptr, InsertIndex, Update, Rank);
+    int Levels = RandomLevel (LLI_Ptr);
+    for (int level = LLI_Ptr->Level; level < Levels; level++) {
+        LLI_Ptr->Header[level].next = NULL;
+        LLI_Ptr->Header[level].Span = LLI_Ptr->NumNodesInList + 1;
+        Update[level] = &LLI_Ptr->Header[level];
+        Rank[level] = 0;
+    }
+    if (Levels > LLI_Ptr->Level)
+        LLI_Ptr->Level = Levels;
+    SkipNodePtr NewNode = MakeNode (Levels);
+    int level = 0;
+    for (; level < Levels; level++) {
+        NewNode->Link[level].next = Update[level]->next;
+        NewNode->Link[level].Span = Update[level]->Span - (InsertIndex - Rank[level]);
+        Update[level]->next = NewNode;
+        Update[level]->Span = InsertIndex - Rank[level] + 1;
+    }
+    for (; level < LLI_Ptr->Level; level++)
+        Update[level]->Span++;
+    LLI_Ptr->NumNodesInList++;
+    return &NewNode->Data;
+}
+
+/////////////
+// Local function RemoveNode unlinks the node at position RemoveIndex + 1.
+// On the levels it reaches, the Update link takes over its link and
+// Span (less the position removed); on the levels above, the Update
+// link's Span shrinks by one.  Levels left with nothing on them are
+// dropped from the top.
+/////////////
+UserData RemoveNode (LLInfoPtr LLI_Ptr, int RemoveIndex)
+{
+    SkipLink *Update[SKIP_MAX_LEVEL];
+    int Rank[SKIP_MAX_LEVEL];
+    FindPosition (LLI_Ptr, RemoveIndex, Update, Rank);
+    SkipNodePtr OldNode = Update[0]->next;
+    for (int level = 0; level < LLI_Ptr->Level; level++) {
+        if (Update[level]->next == OldNode) {
+            Update[level]->next = OldNode->Link[level].next;
+            Update[level]->Span += OldNode->Link[level].Span - 1;
+        }
+        else
+            Update[level]->Span--;
+    }
+    while (LLI_Ptr->Level > 1 && LLI_Ptr->Header[LLI_Ptr->Level - 1].next == NULL)
+        LLI_Ptr->Level--;
+    LLI_Ptr->NumNodesInList--;
+    UserData theData = OldNode->Data;
+    FreeNode (OldNode);
+    return theData;
+}
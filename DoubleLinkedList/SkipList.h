@@ -0,0 +1,52 @@
+#ifndef SKIPLIST_H_INCLUDED
+#define SKIPLIST_H_INCLUDED
+
+// SkipList.h is included by LinkedList.h when the list is built
+// with LL_SKIPLIST defined.  It describes how the skip list stores
+// UserData; the functions used to work with the list are still the ones
+// declared in LinkedList.h
+
+// The skip list uses UserData
+#include "UserData.h"
+// the random level is drawn from a 32 bit state
+#include <stdint.h>
+
+// SKIP_MAX_LEVEL is the most levels any node can have.  With a quarter
+// of the nodes of each level going up to the next, 32 levels are plenty
+// for any list an int can count.
+#define SKIP_MAX_LEVEL 32
+
+// A skip link is one level of a node's linkage: the node it leads to
+// and its Span, the number of positions that node is further along the
+// list.  Level 0 links every node to the one after it (a Span of 1);
+// each level above skips over the nodes that do not reach it.
+typedef struct skiplink
+{
+    struct skipnode *next;
+    int              Span;
+} SkipLink;
+
+// A skip node holds UserData and Levels skip links, one for each level
+// it reaches.  It is allocated with room for exactly that many links.
+typedef struct skipnode
+{
+    UserData Data;
+    int      Levels;
+    SkipLink Link[];
+} SkipNode, *SkipNodePtr;
+
+// A LL Information block holds the Header links, which lead to the first
+// node that reaches each level, and the running count of nodes in the
+// list.  Level is the number of levels in use.  Positions count the
+// Header as 0 and the node at index i as i + 1, and a link with no node
+// after it spans to position NumNodesInList + 1, so the Spans followed
+// from the Header always add up to the position reached.
+// Random is the state the levels of new nodes are drawn from.
+typedef struct {
+    SkipLink Header[SKIP_MAX_LEVEL];
+    int      Level;
+    int      NumNodesInList;
+    uint32_t Random;
+    } LLInfo, *LLInfoPtr;
+
+#endif // SKIPLIST_H_INCLUDED
@@ -0,0 +1,71 @@
+//
+//  SwapBenchmark
+//
+//  This program times the two ways the doubly linked list can swap nodes:
+//      LL_Swap      - copies the UserData of the two nodes through a temporary
+//      LL_SwapNodes - relinks the two nodes, leaving their UserData in place
+//  The cost of LL_Swap grows with sizeof(UserData) while LL_SwapNodes does
+//  not, so somewhere as UserData grows LL_SwapNodes becomes the faster one.
+//  CMake builds this program several times, each with USERDATA_PADDING
+//  adding a different number of bytes to UserData (see UserData.h), so
+//  running them one after another shows where that crossover is.
+//
+//  Each run fills a list and then does bubble-sort style passes of
+//  neighbouring swaps, like PriorityQueue's AdjustQueue, so that finding
+//  the nodes costs the same small amount for both swaps.
+
+// we use printf from stdio.h
+#include <stdio.h>
+// we use clock() from time.h to time the swaps
+#include <time.h>
+// we use the linked list, so include its functions that we can call
+#include "LinkedList.h"
+// we use UserData when we call the list functions
+#include "UserData.h"
+
+// The number of nodes in the list and the number of passes over it
+#define NUM_NODES  1000
+#define NUM_PASSES 2000
+
+// SwapFunction is either LL_Swap or LL_SwapNodes
+typedef void (*SwapFunction) (LLInfoPtr LLI_Ptr, int Index1, int Index2);
+
+// TimeSwaps returns the number of nanoseconds a swap takes on average
+static double TimeSwaps (SwapFunction Swap);
+
+int main(int argc, const char * argv[]) {
+    double CopyTime = TimeSwaps (LL_Swap);
+    double RelinkTime = TimeSwaps (LL_SwapNodes);
+    printf ("UserData of %4d bytes: LL_Swap %7.2f ns, LL_SwapNodes %7.2f ns -> %s is faster\n",
+            (int) sizeof (UserData), CopyTime, RelinkTime,
+            (CopyTime <= RelinkTime) ? "LL_Swap" : "LL_SwapNodes");
+    printf ("The allocation count is now %d\n", AllocationCount);
+    return 0;
+}
+
+// function TimeSwaps makes a list of NUM_NODES nodes and swaps every pair of
+// neighbours on each of NUM_PASSES passes with the Swap function given.
+// The list is deleted before returning the average time of a swap.
+double TimeSwaps (SwapFunction Swap)
+{
+    LLInfoPtr LL = LL_Init();
+    for (int loop = 0; loop < NUM_NODES; loop++)
+    {
+        UserData D = {0};
+        D.num = loop;
+        LL_AddAtEnd (LL, D);
+    }
+    clock_t Start = clock();
+    for (int pass = 0; pass < NUM_PASSES; pass++)
+        for (int loop = 0; loop < NUM_NODES - 1; loop++)
+            Swap (LL, loop, loop + 1);
+    clock_t End = clock();
+    // each pass carries the node at the Head to the Tail, so the list has
+    // been rotated one place per pass and node 0 has to be where this works out
+    int Expected = (NUM_NODES - NUM_PASSES % NUM_NODES) % NUM_NODES;
+    if (LL_GetAtIndex (LL, Expected).num != 0)
+        printf ("The swaps did not leave the list in the expected order\n");
+    LL = LL_Delete (LL);
+    double Swaps = (double) NUM_PASSES * (NUM_NODES - 1);
+    return (double) (End - Start) / CLOCKS_PER_SEC * 1e9 / Swaps;
+}
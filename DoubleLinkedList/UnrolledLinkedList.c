@@ -0,0 +1,632 @@
+///////////////////////
+//
+// This unrolled linked list code provides exactly the same functions
+// as DoubleLinkedList.c, declared in LinkedList.h, and is used in its
+// place when the list is built with LL_UNROLLED defined.
+//
+// WHY?... A node in the double linked list carries one UserData next
+// to two pointers, so for a small UserData most of every node is
+// linkage.  The unrolled list links "blocks" instead, where each block
+// holds up to BLOCK_CAPACITY UserData side by side in an array.
+//
+//      - Adding at the front or end fills the first or last block and
+//        only allocates a new block when that one is full.
+//      - Getting from the front empties the first block a UserData at
+//        a time and frees the block when nothing is left in it.
+//      - Finding the UserData at an index steps over whole blocks,
+//        using each block's count, so a walk touches one block for
+//        every BLOCK_CAPACITY UserData rather than one node for each.
+//
+// The UserData in a block are kept in Data[First] up to
+// Data[First + Count - 1].  A block made for the front of the list
+// starts with its UserData at the end of the array and one made for
+// the end of the list starts at the beginning, so neither a stack nor
+// a queue has to move UserData around inside a block.
+//
+///////////////////////
+
+// stdlib provides the definition of NULL and the declarations for
+// malloc() and free()
+#include <stdlib.h>
+// string provides memmove() and memcpy() used to move UserData in and out of blocks
+#include <string.h>
+// assert is used to check the calls are valid
+#include <assert.h>
+// The list needs UserData to know what each block holds
+#include "UserData.h"
+// LinkedList.h declares the functions callable for a linked list and,
+// with LL_UNROLLED defined, pulls in the block layout from UnrolledList.h
+#include "LinkedList.h"
+
+// locally called function declarations follow..
+//
+// MakeBlock is called to allocate an empty block whose first UserData
+// will go at Data[First]
+static BlockPtr MakeBlock (int First);
+
+// FreeBlock unlinks an empty block from the list and frees it
+static void FreeBlock (LLInfoPtr LLI_Ptr, BlockPtr theBlock);
+
+// GetDataAddress is used to return a pointer to the UserData at an index
+static UserData *GetDataAddress (LLInfoPtr LLI_Ptr, int FetchIndex);
+
+// Externally callable functions for a user of the Linked List
+// follow
+
+/////////////
+// LL_Init is used to allocate and initialize a LinkedList
+// Information structure.  It will update the memory account
+// to reflect the malloc of the struct and return the pointer
+// to the struct for the caller to use when calling any
+// other function in the linked list
+/////////////
+LLInfoPtr LL_Init()
+{
+    // Allocate a Linked List Information structure
+    LLInfoPtr LLI_Ptr = (LLInfoPtr) malloc (sizeof (LLInfo));
+    assert (LLI_Ptr != NULL);
+    // Initialize the data in the struct just allocated
+    LLI_Ptr->Head = NULL;
+    LLI_Ptr->Tail = NULL;
+    LLI_Ptr->NumNodesInList = 0;
+    LLI_Ptr->Finger = NULL;
+    LLI_Ptr->FingerStart = 0;
+    // update the memory account to reflect the malloc
+    MA_Allocated (MA_LL_INFO, sizeof (LLInfo));
+    // return the pointer to the allocated struct to the caller
+    return LLI_Ptr;
+}
+
+/////////////
+// LL_Delete is called to delete all of the blocks in the Linked
+// List identified by LL_Ptr.  There is no need to remove the UserData
+// one at a time, so each block is simply freed in turn.  Once all the
+// blocks are gone, it frees the LinkedList information struct and
+// updates the memory account to reflect the memory release.  The
+// blocks are counted as list nodes.
+/////////////
+LLInfoPtr LL_Delete(LLInfoPtr LLI_Ptr)
+{
+    // We should not have been called if the Linked List
+    // Information structure does not exist
+    assert (LLI_Ptr != NULL);
+    // free every block from the Head onwards
+    BlockPtr curr = LLI_Ptr->Head;
+    while (curr != NULL) {
+        BlockPtr nextBlock = curr->next;
+        free (curr);
+        MA_Released (MA_LIST_NODE, sizeof (Block));
+        curr = nextBlock;
+    }
+    // Now that all the blocks are gone, delete the Information
+    // structure itself
+    free(LLI_Ptr);
+    LLI_Ptr = NULL;
+    MA_Released (MA_LL_INFO, sizeof (LLInfo));
+    // return a NULL because the list structure no longer exists
+    return NULL;
+}
+
+/////////////
+// LL_AddAtFront is called to add the UserData to the front of the list.
+// The UserData goes just before the first UserData of the Head block.
+// If the Head block has no room before its first UserData but is not
+// full, its UserData are moved to the end of its array to make room.
+// If it is full (or there is no block), a new Head block is made.
+/////////////
+void LL_AddAtFront (LLInfoPtr LLI_Ptr, UserData theData)
+{
+    *LL_EmplaceFront (LLI_Ptr) = theData;
+}
+
+/////////////
+// LL_EmplaceFront makes room for a UserData at the front of the list,
+// just as LL_AddAtFront does, and returns its address for the caller
+// to fill in place.
+/////////////
+UserData *LL_EmplaceFront (LLInfoPtr LLI_Ptr)
+{
+    // We should not have been called if the Linked List
+    // Information structure does not exist
+    assert (LLI_Ptr != NULL);
+    BlockPtr B = LLI_Ptr->Head;
+    if (B == NULL || B->First == 0) {
+        if (B != NULL && B->Count < BLOCK_CAPACITY) {
+            // slide the UserData up to the end of the block
+            memmove (&B->Data[BLOCK_CAPACITY - B->Count], &B->Data[B->First],
+                     B->Count * sizeof (UserData));
+            B->First = BLOCK_CAPACITY - B->Count;
+        } else {
+            // make an empty block that fills from its end and link it
+            // in front of the current Head
+            B = MakeBlock (BLOCK_CAPACITY);
+            B->next = LLI_Ptr->Head;
+            if (LLI_Ptr->Head != NULL)
+                LLI_Ptr->Head->prev = B;
+            else
+                LLI_Ptr->Tail = B;
+            LLI_Ptr->Head = B;
+        }
+    }
+    // the new UserData goes just before the block's first UserData
+    B->First--;
+    B->Count++;
+    LLI_Ptr->NumNodesInList++;
+    // every block after the Head now starts one index further along
+    if (LLI_Ptr->Finger != NULL && LLI_Ptr->Finger != B)
+        LLI_Ptr->FingerStart++;
+    return &B->Data[B->First];
+}
+
+/////////////
+// LL_AddAtEnd is called to add the UserData to the end of the list.
+// The UserData goes just after the last UserData of the Tail block.
+// If the Tail block has no room after its last UserData but is not
+// full, its UserData are moved to the start of its array to make room.
+// If it is full (or there is no block), a new Tail block is made.
+/////////////
+void LL_AddAtEnd (LLInfoPtr LLI_Ptr, UserData theData)
+{
+    *LL_EmplaceEnd (LLI_Ptr) = theData;
+}
+
+/////////////
+// LL_EmplaceEnd makes room for a UserData at the end of the list, just
+// as LL_AddAtEnd does, and returns its address for the caller to fill in.
+/////////////
+UserData *LL_EmplaceEnd (LLInfoPtr LLI_Ptr)
+{
+    // we should not have been called if the Linked List
+    // Information structure does not exist
+    assert (LLI_Ptr != NULL);
+    BlockPtr B = LLI_Ptr->Tail;
+    if (B == NULL || B->First + B->Count == BLOCK_CAPACITY) {
+        if (B != NULL && B->Count < BLOCK_CAPACITY) {
+            // slide the UserData down to the start of the block
+            memmove (&B->Data[0], &B->Data[B->First], B->Count * sizeof (UserData));
+            B->First = 0;
+        } else {
+            // make an empty block that fills from its start and link it
+            // after the current Tail
+            B = MakeBlock (0);
+            B->prev = LLI_Ptr->Tail;
+            if (LLI_Ptr->Tail != NULL)
+                LLI_Ptr->Tail->next = B;
+            else
+                LLI_Ptr->Head = B;
+            LLI_Ptr->Tail = B;
+        }
+    }
+    // the new UserData goes just after the block's last UserData
+    B->Count++;
+    LLI_Ptr->NumNodesInList++;
+    return &B->Data[B->First + B->Count - 1];
+}
+
+/////////////
+// LL_GetFront is called to return the user data at the front of the
+// LL.  It verifies that (a) the underlying LL Information pointer exists,
+// (b) there is UserData to return and (c) the caller has provided a valid
+// choice to delete or retain the user data.  The program will abort if any
+// of these conditions is not met.
+// Deleting the UserData frees the Head block once it is empty.
+/////////////
+UserData LL_GetFront (LLInfoPtr LLI_Ptr, ShouldDelete Choice)
+{
+    assert (LLI_Ptr != NULL);
+    assert (LLI_Ptr->Head != NULL);
+    assert (Choice == DELETE_NODE || Choice == RETAIN_NODE);
+    // start by copying out the user data at the list start
+    BlockPtr B = LLI_Ptr->Head;
+    UserData D = B->Data[B->First];
+    if (Choice == DELETE_NODE) {
+        // drop the first UserData of the Head block
+        B->First++;
+        B->Count--;
+        LLI_Ptr->NumNodesInList--;
+        // every block after the Head now starts one index closer
+        if (LLI_Ptr->Finger != NULL && LLI_Ptr->Finger != B)
+            LLI_Ptr->FingerStart--;
+        // give the block back once nothing is left in it
+        if (B->Count == 0)
+            FreeBlock (LLI_Ptr, B);
+    }
+    // return the user data that has been read from the start
+    // of the linked list
+    return D;
+}
+
+/////////////
+// LL_Length returns the number of UserData in the underlying LL.
+// It allows calls to be made even if the underlying LL does not
+// exist, returning a count of zero under this condition
+/////////////
+int  LL_Length  (LLInfoPtr LLI_Ptr)
+{
+    return (LLI_Ptr == NULL) ? 0 : LLI_Ptr->NumNodesInList;
+}
+
+/////////////
+// LL_GetAtIndex returns the user data at the specified index
+// in the underlying LL.
+/////////////
+UserData  LL_GetAtIndex (LLInfoPtr LLI_Ptr, int FetchIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((FetchIndex >= 0) && (FetchIndex < LLI_Ptr->NumNodesInList) );
+    return *GetDataAddress (LLI_Ptr, FetchIndex);
+}
+
+/////////////
+// LL_SetAtIndex updates the UserData at the specified index
+// in the underlying LL to what was provided by the caller.
+/////////////
+void  LL_SetAtIndex (LLInfoPtr LLI_Ptr, UserData D, int UpdateIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((UpdateIndex >= 0) && (UpdateIndex < LLI_Ptr->NumNodesInList) );
+    *GetDataAddress (LLI_Ptr, UpdateIndex) = D;
+}
+
+//////////////
+// LL_Swap swaps the UserData at the specified indices Index1 and Index2
+// in the underlying LL.
+/////////////
+void  LL_Swap (LLInfoPtr LLI_Ptr, int Index1, int Index2)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((Index1 >= 0) && (Index1 < LLI_Ptr->NumNodesInList) );
+    assert ((Index2 >= 0) && (Index2 < LLI_Ptr->NumNodesInList) );
+    // no need to do anything if the indices are the same
+    if (Index1 == Index2)
+        return;
+    // locating a UserData never moves any others, so both
+    // addresses stay good while we swap through them
+    UserData *Data1 = GetDataAddress (LLI_Ptr, Index1);
+    UserData *Data2 = GetDataAddress (LLI_Ptr, Index2);
+    UserData temp = *Data1;
+    *Data1 = *Data2;
+    *Data2 = temp;
+}
+
+/////////////
+// LL_InsertAtIndex adds theData so that it ends up at InsertIndex,
+// moving the UserData from there on one index along.  InsertIndex may
+// be the length of the list, which adds at the end.
+// The block holding InsertIndex makes room by moving the UserData on
+// whichever side of it has space.  A full block is first split in two,
+// its second half going into a new block linked after it.
+/////////////
+void LL_InsertAtIndex (LLInfoPtr LLI_Ptr, UserData theData, int InsertIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((InsertIndex >= 0) && (InsertIndex <= LLI_Ptr->NumNodesInList) );
+    // the ends of the list are already handled, including an empty list
+    if (InsertIndex == 0) {
+        LL_AddAtFront (LLI_Ptr, theData);
+        return;
+    }
+    if (InsertIndex == LLI_Ptr->NumNodesInList) {
+        LL_AddAtEnd (LLI_Ptr, theData);
+        return;
+    }
+    // locating the index leaves its block as the Finger
+    GetDataAddress (LLI_Ptr, InsertIndex);
+    BlockPtr B = LLI_Ptr->Finger;
+    int Offset = InsertIndex - LLI_Ptr->FingerStart;
+    if (B->Count == BLOCK_CAPACITY) {
+        // a full block always has First 0, so the second half is moved
+        // to the start of a new block and both have room at their end
+        BlockPtr NewBlock = MakeBlock (0);
+        NewBlock->Count = BLOCK_CAPACITY - BLOCK_CAPACITY / 2;
+        memcpy (&NewBlock->Data[0], &B->Data[BLOCK_CAPACITY / 2], NewBlock->Count * sizeof (UserData));
+        B->Count = BLOCK_CAPACITY / 2;
+        NewBlock->prev = B;
+        NewBlock->next = B->next;
+        if (B->next != NULL)
+            B->next->prev = NewBlock;
+        else
+            LLI_Ptr->Tail = NewBlock;
+        B->next = NewBlock;
+        if (Offset > B->Count) {
+            Offset -= B->Count;
+            LLI_Ptr->FingerStart += B->Count;
+            LLI_Ptr->Finger = B = NewBlock;
+        }
+    }
+    if (B->First + B->Count < BLOCK_CAPACITY) {
+        // move the UserData from Offset on up by one
+        memmove (&B->Data[B->First + Offset + 1], &B->Data[B->First + Offset],
+                 (B->Count - Offset) * sizeof (UserData));
+    } else {
+        // move the UserData before Offset down by one
+        memmove (&B->Data[B->First - 1], &B->Data[B->First], Offset * sizeof (UserData));
+        B->First--;
+    }
+    B->Data[B->First + Offset] = theData;
+    B->Count++;
+    LLI_Ptr->NumNodesInList++;
+}
+
+/////////////
+// LL_RemoveAtIndex removes the UserData at RemoveIndex, moving the
+// UserData after it one index closer to the front, and returns it.
+// The gap is closed by moving the fewer of the UserData before or after
+// it in the block, and the block is freed once it is empty.
+/////////////
+UserData LL_RemoveAtIndex (LLInfoPtr LLI_Ptr, int RemoveIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((RemoveIndex >= 0) && (RemoveIndex < LLI_Ptr->NumNodesInList) );
+    // locating the index leaves its block as the Finger
+    UserData theData = *GetDataAddress (LLI_Ptr, RemoveIndex);
+    BlockPtr B = LLI_Ptr->Finger;
+    int Offset = RemoveIndex - LLI_Ptr->FingerStart;
+    if (Offset < B->Count - 1 - Offset) {
+        // move the UserData before Offset up by one
+        memmove (&B->Data[B->First + 1], &B->Data[B->First], Offset * sizeof (UserData));
+        B->First++;
+    } else {
+        // move the UserData after Offset down by one
+        memmove (&B->Data[B->First + Offset], &B->Data[B->First + Offset + 1],
+                 (B->Count - 1 - Offset) * sizeof (UserData));
+    }
+    B->Count--;
+    LLI_Ptr->NumNodesInList--;
+    if (B->Count == 0)
+        FreeBlock (LLI_Ptr, B);
+    return theData;
+}
+
+/////////////
+// LL_PeekFrontPtr returns the address of the first UserData of the
+// Head block instead of a copy of it
+/////////////
+UserData *LL_PeekFrontPtr (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    assert (LLI_Ptr->Head != NULL);
+    return &LLI_Ptr->Head->Data[LLI_Ptr->Head->First];
+}
+
+/////////////
+// LL_AtIndexPtr returns the address of the UserData at the specified
+// index instead of a copy of it
+/////////////
+UserData *LL_AtIndexPtr (LLInfoPtr LLI_Ptr, int FetchIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((FetchIndex >= 0) && (FetchIndex < LLI_Ptr->NumNodesInList) );
+    return GetDataAddress (LLI_Ptr, FetchIndex);
+}
+
+/////////////
+// LL_AddAtEndBatch is called to add Count UserData from the array
+// Data to the end of the list, in array order.
+// Whatever room is left after the Tail block's last UserData is filled
+// first, then new Tail blocks are made and filled, each with a single
+// copy of as many UserData as it can hold.
+/////////////
+void LL_AddAtEndBatch (LLInfoPtr LLI_Ptr, const UserData *Data, int Count)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Count >= 0 && (Data != NULL || Count == 0));
+    while (Count > 0) {
+        BlockPtr B = LLI_Ptr->Tail;
+        if (B == NULL || B->First + B->Count == BLOCK_CAPACITY) {
+            B = MakeBlock (0);
+            B->prev = LLI_Ptr->Tail;
+            if (LLI_Ptr->Tail != NULL)
+                LLI_Ptr->Tail->next = B;
+            else
+                LLI_Ptr->Head = B;
+            LLI_Ptr->Tail = B;
+        }
+        // copy as much as fits after the block's last UserData
+        int Room = BLOCK_CAPACITY - (B->First + B->Count);
+        int Chunk = (Count < Room) ? Count : Room;
+        memcpy (&B->Data[B->First + B->Count], Data, Chunk * sizeof (UserData));
+        B->Count += Chunk;
+        LLI_Ptr->NumNodesInList += Chunk;
+        Data += Chunk;
+        Count -= Chunk;
+    }
+}
+
+/////////////
+// LL_AddAtFrontBatch is called to add Count UserData from the array
+// Data to the front of the list.  The result is the same as calling
+// LL_AddAtFront for Data[0] up to Data[Count-1], so the array ends up
+// reversed: Data[Count-1] becomes the first UserData in the list.
+/////////////
+void LL_AddAtFrontBatch (LLInfoPtr LLI_Ptr, const UserData *Data, int Count)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Count >= 0 && (Data != NULL || Count == 0));
+    int Added = 0;
+    while (Added < Count) {
+        BlockPtr B = LLI_Ptr->Head;
+        if (B == NULL || B->First == 0) {
+            B = MakeBlock (BLOCK_CAPACITY);
+            B->next = LLI_Ptr->Head;
+            if (LLI_Ptr->Head != NULL)
+                LLI_Ptr->Head->prev = B;
+            else
+                LLI_Ptr->Tail = B;
+            LLI_Ptr->Head = B;
+        }
+        // fill the room before the block's first UserData
+        while (B->First > 0 && Added < Count) {
+            B->First--;
+            B->Data[B->First] = Data[Added++];
+            B->Count++;
+        }
+    }
+    LLI_Ptr->NumNodesInList += Count;
+    // the blocks have changed at the front, so find the Finger again later
+    LLI_Ptr->Finger = NULL;
+}
+
+/////////////
+// LL_DrainFront is called to remove up to MaxCount UserData from the
+// front of the list, copying them into Out in list order.
+// Each block is copied out with a single copy and freed once empty.
+// It returns the number of UserData removed.
+/////////////
+int LL_DrainFront (LLInfoPtr LLI_Ptr, UserData *Out, int MaxCount)
+{
+    assert (LLI_Ptr != NULL);
+    assert (MaxCount >= 0 && (Out != NULL || MaxCount == 0));
+    int Drained = 0;
+    while (Drained < MaxCount && LLI_Ptr->Head != NULL) {
+        BlockPtr B = LLI_Ptr->Head;
+        int Chunk = (MaxCount - Drained < B->Count) ? MaxCount - Drained : B->Count;
+        memcpy (&Out[Drained], &B->Data[B->First], Chunk * sizeof (UserData));
+        B->First += Chunk;
+        B->Count -= Chunk;
+        Drained += Chunk;
+        if (B->Count == 0)
+            FreeBlock (LLI_Ptr, B);
+    }
+    LLI_Ptr->NumNodesInList -= Drained;
+    // the blocks have changed at the front, so find the Finger again later
+    LLI_Ptr->Finger = NULL;
+    return Drained;
+}
+
+/////////////
+// LL_ToArray copies up to MaxCount UserData, starting at the front of
+// the list, into Out, a block at a time.  The list is not changed.
+// It returns the number of UserData copied.
+/////////////
+int LL_ToArray (LLInfoPtr LLI_Ptr, UserData *Out, int MaxCount)
+{
+    assert (LLI_Ptr != NULL);
+    assert (MaxCount >= 0 && (Out != NULL || MaxCount == 0));
+    int Copied = 0;
+    for (BlockPtr B = LLI_Ptr->Head; B != NULL && Copied < MaxCount; B = B->next) {
+        int Chunk = (MaxCount - Copied < B->Count) ? MaxCount - Copied : B->Count;
+        memcpy (&Out[Copied], &B->Data[B->First], Chunk * sizeof (UserData));
+        Copied += Chunk;
+    }
+    return Copied;
+}
+
+/////////////
+// LL_FromArray makes a new list holding the Count UserData in the
+// array Data, in array order.  The caller deletes it with LL_Delete
+// just like a list made by LL_Init.
+/////////////
+LLInfoPtr LL_FromArray (const UserData *Data, int Count)
+{
+    LLInfoPtr LLI_Ptr = LL_Init();
+    LL_AddAtEndBatch (LLI_Ptr, Data, Count);
+    return LLI_Ptr;
+}
+
+/////////////
+// LL_ForEach calls Visit for each UserData from the Head to the Tail,
+// passing its address and the caller's Context.  Visit may update the
+// UserData but must not add or delete any.
+/////////////
+void LL_ForEach (LLInfoPtr LLI_Ptr, LLVisitor Visit, void *Context)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Visit != NULL);
+    for (BlockPtr B = LLI_Ptr->Head; B != NULL; B = B->next)
+        for (int i = B->First; i < B->First + B->Count; i++)
+            Visit (&B->Data[i], Context);
+}
+
+/////////////
+// Local function MakeBlock allocates an empty, unlinked block.  First
+// is where its first UserData will be placed: 0 for a block that fills
+// towards its end and BLOCK_CAPACITY for one that fills towards its start.
+/////////////
+BlockPtr MakeBlock (int First)
+{
+    BlockPtr NewBlock = (BlockPtr) malloc (sizeof (Block));
+    assert (NewBlock != NULL);
+    NewBlock->next = NULL;
+    NewBlock->prev = NULL;
+    NewBlock->First = First;
+    NewBlock->Count = 0;
+    // Update the memory account to reflect the malloc
+    MA_Allocated (MA_LIST_NODE, sizeof (Block));
+    return NewBlock;
+}
+
+/////////////
+// Local function FreeBlock unlinks an empty block from the list,
+// updating Head and Tail if it was at either end, forgets it if it was
+// the Finger and frees it.
+/////////////
+void FreeBlock (LLInfoPtr LLI_Ptr, BlockPtr theBlock)
+{
+    assert (theBlock->Count == 0);
+    if (theBlock->prev != NULL)
+        theBlock->prev->next = theBlock->next;
+    else
+        LLI_Ptr->Head = theBlock->next;
+    if (theBlock->next != NULL)
+        theBlock->next->prev = theBlock->prev;
+    else
+        LLI_Ptr->Tail = theBlock->prev;
+    if (LLI_Ptr->Finger == theBlock)
+        LLI_Ptr->Finger = NULL;
+    free (theBlock);
+    // Update the memory account to reflect the free
+    MA_Released (MA_LIST_NODE, sizeof (Block));
+}
+
+/////////////
+// GetDataAddress is a utility function that will locate the UserData
+// at FetchIndex and return its address.
+// It starts from whichever of the Head block, the Tail block or the
+// Finger block is closest, then steps a whole block at a time until
+// it reaches the block holding FetchIndex.  That block becomes the new
+// Finger so that neighbouring indices are found without stepping.
+/////////////
+UserData *GetDataAddress (LLInfoPtr LLI_Ptr, int FetchIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((FetchIndex >= 0) && (FetchIndex < LLI_Ptr->NumNodesInList) );
+
+    // Start by assuming the Head or Tail block is closest
+    BlockPtr curr = LLI_Ptr->Head;
+    int start = 0;
+    int distance = FetchIndex;
+    if (LLI_Ptr->NumNodesInList - 1 - FetchIndex < distance) {
+        curr = LLI_Ptr->Tail;
+        start = LLI_Ptr->NumNodesInList - curr->Count;
+        distance = LLI_Ptr->NumNodesInList - 1 - FetchIndex;
+    }
+    // Use the Finger instead if it is closer still
+    if (LLI_Ptr->Finger != NULL && abs (FetchIndex - LLI_Ptr->FingerStart) < distance) {
+        curr = LLI_Ptr->Finger;
+        start = LLI_Ptr->FingerStart;
+    }
+
+    // step a block at a time until FetchIndex is inside curr
+    while (FetchIndex < start) {
+        curr = curr->prev;
+        start -= curr->Count;
+    }
+    while (FetchIndex >= start + curr->Count) {
+        start += curr->Count;
+        curr = curr->next;
+    }
+
+    // remember where we are for the next call
+    LLI_Ptr->Finger = curr;
+    LLI_Ptr->FingerStart = start;
+
+    return &curr->Data[curr->First + FetchIndex - start];
+}
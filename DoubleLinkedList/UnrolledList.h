@@ -0,0 +1,45 @@
+#ifndef UNROLLEDLIST_H_INCLUDED
+#define UNROLLEDLIST_H_INCLUDED
+
+// UnrolledList.h is included by LinkedList.h when the list is built
+// with LL_UNROLLED defined.  It describes how the unrolled list stores
+// UserData; the functions used to work with the list are still the ones
+// declared in LinkedList.h
+
+// The unrolled list uses UserData
+#include "UserData.h"
+
+// BLOCK_CAPACITY is the number of UserData held in each block.  It can
+// be changed at build time with -DBLOCK_CAPACITY=n
+#ifndef BLOCK_CAPACITY
+#define BLOCK_CAPACITY 32
+#endif
+
+// Instead of a node per UserData, the unrolled list is a doubly linked
+// list of blocks, each holding up to BLOCK_CAPACITY UserData side by side.
+// The UserData in a block are Data[First] through Data[First + Count - 1],
+// so there is room to add at either end of a block without moving the
+// UserData already in it.
+typedef struct block
+{
+    struct block *next;
+    struct block *prev;
+    int           First;
+    int           Count;
+    UserData      Data[BLOCK_CAPACITY];
+} Block, *BlockPtr;
+
+// A LL Information block contains Head and Tail pointers to the first
+// and last blocks and the running count of the UserData in all of them.
+// Finger remembers the block last located by index and FingerStart is
+// the index of the first UserData in that block.  Finger is NULL when
+// there is no remembered block.
+typedef struct {
+    BlockPtr Head;
+    BlockPtr Tail;
+    int      NumNodesInList;
+    BlockPtr Finger;
+    int      FingerStart;
+    } LLInfo, *LLInfoPtr;
+
+#endif // UNROLLEDLIST_H_INCLUDED
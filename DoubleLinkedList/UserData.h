@@ -6,8 +6,13 @@
 //
 
 // User data in each node contains an integer
+// SwapBenchmark builds this with USERDATA_PADDING set to a number of
+// extra bytes to carry, to see how the UserData size affects the list
 typedef struct {
     int num;
+#if defined(USERDATA_PADDING) && USERDATA_PADDING > 0
+    char padding[USERDATA_PADDING];
+#endif
 } UserData, *UserDataPtr;
 
 
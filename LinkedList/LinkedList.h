@@ -3,6 +3,8 @@
 
 // The LL functions use UserData
 #include "UserData.h"
+// The comparison used to sort a LL returns a bool
+#include <stdbool.h>
 
 // The Linked List needs the definition of what a Node is. A Node has
 // UserData and linkage information for both "next and "prev"
@@ -20,7 +22,8 @@ typedef struct node
 // For speed, it also contains a running count of the number of nodes
 // currently in the LL started at Head and finishing at Tail.
 // Head is used when adding or removing from the LL front,
-// Tail is needed only when adding to the end of the LL
+// Tail is used when adding to the end of the LL, so that the end is
+// reached without walking the list
 typedef struct {
     NodePtr Head;
     NodePtr Tail;
@@ -28,9 +31,9 @@ typedef struct {
     } LLInfo, *LLInfoPtr;
 
 // Verifying allocation / deallocation of dynamic memory is done through
-// AllocationCount.  The variable is declared in the LinkedList.c code and
-// is linked to through the extern
-extern int AllocationCount;
+// the memory account, which keeps the list nodes and LLInfo blocks apart
+// and still provides AllocationCount for reading
+#include "MemoryAccount.h"
 
 // ShouldDelete is an enum that has two valid values called DELETE_NODE
 // and RETAIN_NODE that are used in calling to get user data from the front
@@ -63,4 +66,68 @@ UserData        LL_GetAtIndex   (LLInfoPtr, int FetchIndex);
 void            LL_SetAtIndex   (LLInfoPtr LLI_Ptr, UserData D, int UpdateIndex);
 // LL_Swap swaps the nodes in the underlying LL specified by indices starting at 0
 void            LL_Swap         (LLInfoPtr LLI_Ptr, int Index1, int Index2);
+// LL_InsertAfter adds user data just after the node at the specified index starting at 0
+void            LL_InsertAfter  (LLInfoPtr LLI_Ptr, UserData theData, int AfterIndex);
+// LL_RemoveAfter removes the node just after the node at the specified index starting
+// at 0 and returns its user data
+UserData        LL_RemoveAfter  (LLInfoPtr LLI_Ptr, int AfterIndex);
+// LL_Reverse reverses the order of the nodes in the underlying LL in place
+void            LL_Reverse      (LLInfoPtr LLI_Ptr);
+
+// The functions below hand out the address of user data inside the LL rather than
+// a copy, so a large UserData is not copied.  An address is good until the user
+// data it points to is deleted.
+
+// LL_PeekFrontPtr returns the address of the user data at the Head of the underlying LL
+UserData       *LL_PeekFrontPtr (LLInfoPtr LLI_Ptr);
+// LL_AtIndexPtr returns the address of the user data at the specified index starting at 0
+UserData       *LL_AtIndexPtr   (LLInfoPtr LLI_Ptr, int FetchIndex);
+// LL_EmplaceFront adds a node at the Head and returns the address of its user data for
+// the caller to fill in
+UserData       *LL_EmplaceFront (LLInfoPtr LLI_Ptr);
+// LL_EmplaceEnd adds a node at the Tail and returns the address of its user data for
+// the caller to fill in
+UserData       *LL_EmplaceEnd   (LLInfoPtr LLI_Ptr);
+
+// LLVisitor is any function that, when called by LL_ForEach, receives the
+// address of a node's user data (which it may update) and the caller's Context
+typedef void (*LLVisitor) (UserData *Data, void *Context);
+
+// LL_ForEach calls Visit once for every node, from the Head to the Tail
+void            LL_ForEach      (LLInfoPtr LLI_Ptr, LLVisitor Visit, void *Context);
+
+// A cursor marks one position in the underlying LL so that the LL can be walked
+// and changed there without counting from the Head.  With only "next" links, a
+// cursor is the address of the link that points at the node: Head itself for the
+// first node or the "next" of the node before it.  LL_End is the link just past
+// the Tail.  Adding or deleting at a cursor changes which link holds the node
+// after it, so other cursors past that point must be fetched again.
+typedef NodePtr *LLCursor;
+
+// LL_Begin returns a cursor at the Head (LL_End if the LL is empty)
+LLCursor        LL_Begin        (LLInfoPtr LLI_Ptr);
+// LL_End returns the cursor just past the Tail
+LLCursor        LL_End          (LLInfoPtr LLI_Ptr);
+// LL_Next returns the cursor at the node after Cursor
+LLCursor        LL_Next         (LLInfoPtr LLI_Ptr, LLCursor Cursor);
+// LL_Prev returns the cursor at the node before Cursor, counting from the Head
+LLCursor        LL_Prev         (LLInfoPtr LLI_Ptr, LLCursor Cursor);
+// LL_GetAtCursor returns the user data at Cursor
+UserData        LL_GetAtCursor  (LLInfoPtr LLI_Ptr, LLCursor Cursor);
+// LL_SetAtCursor updates the user data at Cursor
+void            LL_SetAtCursor  (LLInfoPtr LLI_Ptr, LLCursor Cursor, UserData D);
+// LL_InsertBefore adds user data just before Cursor (at the Tail when Cursor is LL_End)
+// and returns the cursor at the new node
+LLCursor        LL_InsertBefore (LLInfoPtr LLI_Ptr, LLCursor Cursor, UserData theData);
+// LL_Erase deletes the node at Cursor and returns the cursor at the node that followed it
+LLCursor        LL_Erase        (LLInfoPtr LLI_Ptr, LLCursor Cursor);
+
+// LLComparison is any function that, when called by LL_Sort, receives the
+// addresses of two user data and returns true if the first has to come
+// before the second (false if they are equal or the second comes first)
+typedef bool (*LLComparison) (const UserData *first, const UserData *second);
+
+// LL_Sort puts the nodes in the order given by InOrder, keeping nodes that
+// compare equal in the order they were in
+void            LL_Sort         (LLInfoPtr LLI_Ptr, LLComparison InOrder);
 #endif // LINKEDLIST_H_INCLUDED
@@ -10,6 +10,9 @@
 //          - uses call to LL_GetFront with option to delete or retain the data
 //      Treat the list like an array, getting or an item by specifying the
 //          index of the item (0 is the front) - uses call to LL_GetAtIndex()
+//      Add or remove an item just after the item at an index - uses calls
+//          to LL_InsertAfter() and LL_RemoveAfter()
+//      Reverse the order of the list in place - uses call to LL_Reverse()
 //      Whenever we want to see how many items are inside the list, we call
 //          LL_Length() to return the item count.
 //  This code has been "overly documented" so that it serves as a learning
@@ -32,9 +35,8 @@ static void PrintLL (char msg[], LLInfoPtr theLL);
 // it will also print out the number of things allocated
 static void PrintLLItem (char msg[], UserData D);
 
-// AllocationCount is declared for global use in the list code itself.  We extern it so that
+// AllocationCount comes from the memory account, through LinkedList.h, so that
 // we can see how the allocations are inceeasing or decreasing.
-extern int AllocationCount;
 
 // The array size used
 #define ARRAYSIZE 7
@@ -82,6 +84,17 @@ int main(int argc, const char * argv[]) {
     // print out the number of items in the LL
     PrintLL ("After data has been swapped in the LL...", LL);
 
+    // reversing the LL in place puts the items back in their first order
+    LL_Reverse(LL);
+    PrintLL ("After the LL has been reversed...", LL);
+
+    // add an item after the first one and then take it back out
+    UserData Extra = { 15 };
+    LL_InsertAfter(LL, Extra, 0);
+    PrintLL ("After a data item has been inserted after the front of the LL...", LL);
+    Extra = LL_RemoveAfter(LL, 0);
+    PrintLLItem ("A data item has been removed from after the front of the LL.. ", Extra);
+
     // Check out the ability to get a few items from the front of the LL
     // deleting the items
     for (int loop = 0; loop < 2; loop++)
@@ -98,14 +111,19 @@ int main(int argc, const char * argv[]) {
 
 // function PrintLL is called to print out a message, followed by the contents of the list
 // To determine the items to print, it uses the LL_Length function to get the list size
-// and then calls the LL_GetAtIndex function to read the UserData for each node in the list.
+// and then walks a cursor from LL_Begin to LL_End, calling LL_GetAtCursor to read the
+// UserData for each node in the list.
 void PrintLL (char msg[], LLInfoPtr theLL)
 {
     printf ("%s\nThere are now %d items with an allocation count of %d\n",
             msg, LL_Length(theLL), AllocationCount);
-    for (int loop = 0; loop < LL_Length(theLL); loop++)
+    // a deleted LL has nothing to print
+    if (theLL == NULL)
+        return;
+    int loop = 0;
+    for (LLCursor C = LL_Begin(theLL); C != LL_End(theLL); C = LL_Next(theLL, C), loop++)
     {
-        UserData D = LL_GetAtIndex(theLL, loop);
+        UserData D = LL_GetAtCursor(theLL, C);
         if (loop == 0)
             printf  ("Head==> [%d] = %d\n", loop, D.num);
         else if (loop == LL_Length(theLL)-1)
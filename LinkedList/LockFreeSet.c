@@ -0,0 +1,346 @@
+///////////////////////
+//
+// This lock-free set is the singly linked list kept sorted, with the
+// Head and every next changed only by compare-and-swap so that no thread
+// ever waits for another.  It follows Harris's list, with Michael's
+// hazard pointers for freeing nodes:
+//      - A node is removed in two steps.  First the lowest bit of its
+//        Next is set (it is marked), which removes it from the set and
+//        stops any node being linked in after it.  Then the next of the
+//        node before it is swung past it (it is unlinked).  Any thread
+//        that finds a marked node while searching unlinks it.
+//      - A thread publishes the nodes it is about to read in its hazard
+//        pointers and checks they are still linked before reading them.
+//        An unlinked node goes onto the retired list of the thread that
+//        unlinked it, and is only freed when no hazard pointer holds it.
+// Every atomic uses the default (sequentially consistent) ordering: a
+// hazard pointer only protects a node if it is seen by every thread
+// before the check that the node is still linked.
+//
+///////////////////////
+
+// stdlib provides malloc and free
+#include <stdlib.h>
+// assert checks the arguments, like the rest of the list code
+#include <assert.h>
+// LockFreeSet.h defines SetNode, SetInfo and the hazard records
+#include "LockFreeSet.h"
+
+// IS_MARKED tells whether a Next has the removed mark and TO_NODE takes
+// the mark off to leave the address of the next node
+#define IS_MARKED(Link) (((Link) & 1) != 0)
+#define TO_NODE(Link)   ((SetNodePtr) ((Link) & ~(uintptr_t) 1))
+
+// The hazard pointers a thread uses while searching
+enum { HAZARD_CURR, HAZARD_NEXT, HAZARD_PREV };
+
+// A SetPosition is where a search stopped: Curr is the first node that
+// does not come before the key (NULL at the end of the list), Prev the
+// link that points at Curr and Next the node after Curr
+typedef struct {
+    atomic_uintptr_t *Prev;
+    SetNodePtr        Curr;
+    SetNodePtr        Next;
+} SetPosition;
+
+// locally called function declarations follow..
+//
+// Find searches for Key, unlinking marked nodes on the way, and returns
+// true if Curr is equal to Key
+static bool Find (SetHandle Me, const UserData *Key, SetPosition *Pos);
+
+// ClearHazards lets go of every node the thread was protecting
+static void ClearHazards (SetHandle Me);
+
+// Retire puts an unlinked node on the thread's retired list
+static void Retire (SetHandle Me, SetNodePtr theNode);
+
+// Scan frees every retired node that no hazard pointer holds
+static void Scan (SetHandle Me);
+
+// FreeSetNode frees a node and updates the memory account
+static void FreeSetNode (SetNodePtr theNode);
+
+/////////////
+// LFS_Init allocates and initializes an empty set ordered by InOrder.
+// It updates the memory account to reflect the malloc.
+/////////////
+SetInfoPtr LFS_Init (LLComparison InOrder)
+{
+    assert (InOrder != NULL);
+    SetInfoPtr Set = (SetInfoPtr) malloc (sizeof (SetInfo));
+    assert (Set != NULL);
+    atomic_init (&Set->Head, (uintptr_t) NULL);
+    Set->InOrder = InOrder;
+    atomic_init (&Set->NumNodesInSet, 0);
+    atomic_init (&Set->Records, NULL);
+    MA_Allocated (MA_LL_INFO, sizeof (SetInfo));
+    return Set;
+}
+
+/////////////
+// LFS_Delete frees the nodes still linked, then every hazard record
+// with the nodes retired on it, then the set itself.  No thread is
+// attached, so no node is protected and nothing else is running.
+/////////////
+SetInfoPtr LFS_Delete (SetInfoPtr Set)
+{
+    assert (Set != NULL);
+    SetNodePtr curr = TO_NODE (atomic_load (&Set->Head));
+    while (curr != NULL) {
+        SetNodePtr nextNode = TO_NODE (atomic_load (&curr->Next));
+        FreeSetNode (curr);
+        curr = nextNode;
+    }
+    SetHandle Record = atomic_load (&Set->Records);
+    while (Record != NULL) {
+        assert (!atomic_load (&Record->Active));
+        SetHandle nextRecord = Record->next;
+        while (Record->Retired != NULL) {
+            SetNodePtr nextRetired = Record->Retired->RetiredNext;
+            FreeSetNode (Record->Retired);
+            Record->Retired = nextRetired;
+        }
+        free (Record);
+        MA_Released (MA_LL_INFO, sizeof (HazardRecord));
+        Record = nextRecord;
+    }
+    free (Set);
+    MA_Released (MA_LL_INFO, sizeof (SetInfo));
+    return NULL;
+}
+
+/////////////
+// LFS_Attach hands the calling thread a hazard record.  A record given
+// back by a thread that detached is reused if there is one; otherwise a
+// new record is pushed onto the set's records, which are never removed
+// while the set exists.
+/////////////
+SetHandle LFS_Attach (SetInfoPtr Set)
+{
+    assert (Set != NULL);
+    for (SetHandle Record = atomic_load (&Set->Records); Record != NULL; Record = Record->next) {
+        bool Idle = false;
+        if (!atomic_load (&Record->Active)
+                && atomic_compare_exchange_strong (&Record->Active, &Idle, true))
+            return Record;
+    }
+    SetHandle Record = (SetHandle) malloc (sizeof (HazardRecord));
+    assert (Record != NULL);
+    for (int loop = 0; loop < LFS_HAZARDS; loop++)
+        atomic_init (&Record->Hazard[loop], NULL);
+    atomic_init (&Record->Active, true);
+    Record->Set = Set;
+    Record->Retired = NULL;
+    Record->NumRetired = 0;
+    MA_Allocated (MA_LL_INFO, sizeof (HazardRecord));
+    Record->next = atomic_load (&Set->Records);
+    while (!atomic_compare_exchange_weak (&Set->Records, &Record->next, Record))
+        ;
+    return Record;
+}
+
+/////////////
+// LFS_Detach frees what it can of the thread's retired nodes and gives
+// the record back.  Any retired nodes still protected stay on the record
+// for the next thread that attaches, or for LFS_Delete.
+/////////////
+void LFS_Detach (SetHandle Me)
+{
+    assert (Me != NULL);
+    ClearHazards (Me);
+    Scan (Me);
+    atomic_store (&Me->Active, false);
+}
+
+/////////////
+// LFS_Insert finds where theData belongs and links a new node there with
+// a compare-and-swap of the link before it.  If the link has changed in
+// the meantime, it searches again.
+/////////////
+bool LFS_Insert (SetHandle Me, UserData theData)
+{
+    assert (Me != NULL);
+    SetNodePtr NewNode = (SetNodePtr) malloc (sizeof (SetNode));
+    assert (NewNode != NULL);
+    NewNode->Data = theData;
+    NewNode->RetiredNext = NULL;
+    MA_Allocated (MA_LIST_NODE, sizeof (SetNode));
+    SetPosition Pos;
+    for (;;) {
+        if (Find (Me, &theData, &Pos)) {
+            // an equal member is there; the new node was never shared
+            ClearHazards (Me);
+            FreeSetNode (NewNode);
+            return false;
+        }
+        atomic_store (&NewNode->Next, (uintptr_t) Pos.Curr);
+        uintptr_t Expected = (uintptr_t) Pos.Curr;
+        if (atomic_compare_exchange_strong (Pos.Prev, &Expected, (uintptr_t) NewNode)) {
+            atomic_fetch_add (&Me->Set->NumNodesInSet, 1);
+            ClearHazards (Me);
+            return true;
+        }
+    }
+}
+
+/////////////
+// LFS_Contains finds Key and copies the member while its hazard pointer
+// still protects it
+/////////////
+bool LFS_Contains (SetHandle Me, UserData Key, UserData *Found)
+{
+    assert (Me != NULL);
+    SetPosition Pos;
+    bool InSet = Find (Me, &Key, &Pos);
+    if (InSet && Found != NULL)
+        *Found = Pos.Curr->Data;
+    ClearHazards (Me);
+    return InSet;
+}
+
+/////////////
+// LFS_Remove marks the member equal to Key, which is what takes it out
+// of the set, and then tries once to unlink it.  If another thread got
+// in the way, a search is made so the node is unlinked before returning.
+/////////////
+bool LFS_Remove (SetHandle Me, UserData Key)
+{
+    assert (Me != NULL);
+    SetPosition Pos;
+    for (;;) {
+        if (!Find (Me, &Key, &Pos)) {
+            ClearHazards (Me);
+            return false;
+        }
+        uintptr_t Next = (uintptr_t) Pos.Next;
+        if (!atomic_compare_exchange_strong (&Pos.Curr->Next, &Next, Next | 1))
+            continue;
+        atomic_fetch_sub (&Me->Set->NumNodesInSet, 1);
+        uintptr_t Expected = (uintptr_t) Pos.Curr;
+        if (atomic_compare_exchange_strong (Pos.Prev, &Expected, (uintptr_t) Pos.Next))
+            Retire (Me, Pos.Curr);
+        else
+            Find (Me, &Key, &Pos);
+        ClearHazards (Me);
+        return true;
+    }
+}
+
+/////////////
+// LFS_Size returns the running count of members
+/////////////
+int LFS_Size (SetInfoPtr Set)
+{
+    assert (Set != NULL);
+    return atomic_load (&Set->NumNodesInSet);
+}
+
+/////////////
+// Local function Find walks from the Head to the first node that does
+// not come before Key.  Each node is put in a hazard pointer and then
+// checked to still be linked from Prev, and the next node the same way,
+// before either is read; if a check fails the walk starts over.  Marked
+// nodes met on the way are unlinked and retired.  When it returns, the
+// hazard pointers still protect Curr, Next and the node holding Prev.
+/////////////
+bool Find (SetHandle Me, const UserData *Key, SetPosition *Pos)
+{
+    SetInfoPtr Set = Me->Set;
+TryAgain:
+    Pos->Prev = &Set->Head;
+    Pos->Curr = TO_NODE (atomic_load (Pos->Prev));
+    for (;;) {
+        if (Pos->Curr == NULL) {
+            Pos->Next = NULL;
+            return false;
+        }
+        atomic_store (&Me->Hazard[HAZARD_CURR], Pos->Curr);
+        if (atomic_load (Pos->Prev) != (uintptr_t) Pos->Curr)
+            goto TryAgain;
+        uintptr_t Next = atomic_load (&Pos->Curr->Next);
+        Pos->Next = TO_NODE (Next);
+        atomic_store (&Me->Hazard[HAZARD_NEXT], Pos->Next);
+        if (atomic_load (&Pos->Curr->Next) != Next)
+            goto TryAgain;
+        if (atomic_load (Pos->Prev) != (uintptr_t) Pos->Curr)
+            goto TryAgain;
+        if (!IS_MARKED (Next)) {
+            // stop at the first member that does not come before Key;
+            // it is equal to Key if Key does not come before it either
+            if (!Set->InOrder (&Pos->Curr->Data, Key))
+                return !Set->InOrder (Key, &Pos->Curr->Data);
+            Pos->Prev = &Pos->Curr->Next;
+            atomic_store (&Me->Hazard[HAZARD_PREV], Pos->Curr);
+        }
+        else {
+            // Curr was removed; unlink it on the remover's behalf
+            uintptr_t Expected = (uintptr_t) Pos->Curr;
+            if (!atomic_compare_exchange_strong (Pos->Prev, &Expected, (uintptr_t) Pos->Next))
+                goto TryAgain;
+            Retire (Me, Pos->Curr);
+        }
+        // Next is still protected until Curr's hazard pointer is moved to it
+        Pos->Curr = Pos->Next;
+    }
+}
+
+/////////////
+// Local function ClearHazards empties the thread's hazard pointers
+/////////////
+void ClearHazards (SetHandle Me)
+{
+    for (int loop = 0; loop < LFS_HAZARDS; loop++)
+        atomic_store (&Me->Hazard[loop], NULL);
+}
+
+/////////////
+// Local function Retire chains an unlinked node onto the thread's
+// retired list, and scans once LFS_SCAN_AT nodes are waiting
+/////////////
+void Retire (SetHandle Me, SetNodePtr theNode)
+{
+    theNode->RetiredNext = Me->Retired;
+    Me->Retired = theNode;
+    Me->NumRetired++;
+    if (Me->NumRetired >= LFS_SCAN_AT)
+        Scan (Me);
+}
+
+/////////////
+// Local function Scan looks for each retired node in the hazard pointers
+// of every record of the set.  A node that no thread holds can never be
+// reached again, so it is freed; the rest stay retired.
+/////////////
+void Scan (SetHandle Me)
+{
+    SetNodePtr Keep = NULL;
+    int NumKept = 0;
+    SetNodePtr theNode = Me->Retired;
+    while (theNode != NULL) {
+        SetNodePtr nextRetired = theNode->RetiredNext;
+        bool Held = false;
+        for (SetHandle Record = atomic_load (&Me->Set->Records); Record != NULL && !Held; Record = Record->next)
+            for (int loop = 0; loop < LFS_HAZARDS && !Held; loop++)
+                Held = (atomic_load (&Record->Hazard[loop]) == theNode);
+        if (Held) {
+            theNode->RetiredNext = Keep;
+            Keep = theNode;
+            NumKept++;
+        }
+        else
+            FreeSetNode (theNode);
+        theNode = nextRetired;
+    }
+    Me->Retired = Keep;
+    Me->NumRetired = NumKept;
+}
+
+/////////////
+// Local function FreeSetNode frees a node that no thread can reach
+/////////////
+void FreeSetNode (SetNodePtr theNode)
+{
+    free (theNode);
+    MA_Released (MA_LIST_NODE, sizeof (SetNode));
+}
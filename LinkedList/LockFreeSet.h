@@ -0,0 +1,108 @@
+#ifndef LOCKFREESET_H_INCLUDED
+#define LOCKFREESET_H_INCLUDED
+
+// LockFreeSet.h declares a set of UserData kept as a sorted singly linked
+// list that any number of threads can insert into, search and remove from
+// at once without any locks.  Two UserData are the same member when
+// neither comes before the other by the set's LLComparison, so the
+// comparison decides which part of the UserData is the key.
+//
+// A thread that uses the set first attaches to it and then passes the
+// SetHandle it gets to every call; the handle holds the thread's hazard
+// pointers, which keep nodes it is looking at from being freed under it.
+//
+//      SetInfoPtr Set = LFS_Init (NumIsLess);      // before the threads
+//      ...                                          // in each thread:
+//      SetHandle Me = LFS_Attach (Set);
+//      LFS_Insert (Me, D);
+//      if (LFS_Contains (Me, Key, &Found)) ...
+//      LFS_Remove (Me, Key);
+//      LFS_Detach (Me);
+//      ...
+//      Set = LFS_Delete (Set);                     // after the threads
+
+// The set uses UserData and the LLComparison of the linked list
+#include "LinkedList.h"
+#include <stdbool.h>
+// uintptr_t holds a next pointer with its deleted mark
+#include <stdint.h>
+// the links, hazard pointers and counts are atomics
+#include <stdatomic.h>
+
+// LFS_HAZARDS is the number of hazard pointers a thread needs: the node
+// before, the node at and the node after the place being looked at
+#define LFS_HAZARDS 3
+
+// LFS_SCAN_AT is the number of removed nodes a thread holds on to before
+// it checks the hazard pointers to see which it can free
+#ifndef LFS_SCAN_AT
+#define LFS_SCAN_AT 64
+#endif
+
+// A set node holds UserData and the link to the next node.  The lowest bit
+// of Next is set once the node has been removed from the set (it is then
+// only waiting to be unlinked), so Next is kept as a uintptr_t.
+// RetiredNext chains the node into its remover's retired list once it is
+// unlinked; Next is left alone then because other threads may still be
+// following it.
+typedef struct setnode
+{
+    UserData         Data;
+    atomic_uintptr_t Next;
+    struct setnode  *RetiredNext;
+} SetNode, *SetNodePtr;
+
+// A hazard record belongs to one attached thread at a time.  Hazard holds
+// the nodes the thread may be reading, which nobody may free.  The nodes
+// the thread unlinked wait in Retired until no hazard pointer holds them.
+typedef struct hazardrecord
+{
+    _Atomic (SetNodePtr)  Hazard[LFS_HAZARDS];
+    atomic_bool           Active;
+    struct hazardrecord  *next;
+    struct setinfo       *Set;
+    SetNodePtr            Retired;
+    int                   NumRetired;
+} HazardRecord, *SetHandle;
+
+// A set information block holds the Head of the sorted list, the
+// comparison that orders it, the running count of members and the hazard
+// records of every thread that has attached.
+typedef struct setinfo
+{
+    atomic_uintptr_t         Head;
+    LLComparison             InOrder;
+    atomic_int               NumNodesInSet;
+    _Atomic (SetHandle)      Records;
+} SetInfo, *SetInfoPtr;
+
+// LFS_Init allocates an empty set ordered by InOrder
+SetInfoPtr  LFS_Init        (LLComparison InOrder);
+
+// LFS_Delete frees the set, its nodes and its hazard records.  Every
+// thread must have detached.  It returns NULL
+SetInfoPtr  LFS_Delete      (SetInfoPtr Set);
+
+// LFS_Attach returns the calling thread's handle on the set
+SetHandle   LFS_Attach      (SetInfoPtr Set);
+
+// LFS_Detach gives the handle back; the thread must not use it again
+void        LFS_Detach      (SetHandle Me);
+
+// LFS_Insert adds theData and returns true, or returns false if an equal
+// member is already in the set
+bool        LFS_Insert      (SetHandle Me, UserData theData);
+
+// LFS_Contains returns true if a member equal to Key is in the set and,
+// when Found is not NULL, copies that member to Found
+bool        LFS_Contains    (SetHandle Me, UserData Key, UserData *Found);
+
+// LFS_Remove removes the member equal to Key and returns true, or returns
+// false if there was none
+bool        LFS_Remove      (SetHandle Me, UserData Key);
+
+// LFS_Size returns the number of members.  Other threads may change it as
+// soon as it is read
+int         LFS_Size        (SetInfoPtr Set);
+
+#endif // LOCKFREESET_H_INCLUDED
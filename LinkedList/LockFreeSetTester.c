@@ -0,0 +1,134 @@
+//
+//  LockFreeSetTester
+//
+//  This is a stress test of the lock-free set, run from several threads
+//  at once on one set.  It checks that:
+//      Threads inserting and removing the same few keys at random - uses
+//          calls to LFS_Insert() and LFS_Remove() - agree with the set:
+//          for every key, the inserts that succeeded less the removes
+//          that succeeded is 1 if LFS_Contains() finds it and 0 if not
+//      Threads searching at the same time - uses call to LFS_Contains() -
+//          only ever find a member equal to the key they asked for
+//      The set is still sorted, with no marked node left linked, and its
+//          size matches what was found
+//      Nothing is left allocated when the set is deleted
+//  A key whose count disagrees with LFS_Contains(), a search that finds
+//  the wrong member, or a set out of order or the wrong size each add
+//  one to Errors; main exits with 1 if Errors is not 0 or memory is
+//  left allocated.
+
+// we use printf from stdio.h
+#include <stdio.h>
+// we use rand_r from stdlib.h, which each thread can call on its own seed
+#include <stdlib.h>
+// the workers are pthreads
+#include <pthread.h>
+// we use the lock-free set, so include its functions that we can call
+#include "LockFreeSet.h"
+
+// The number of threads, the keys they share and the calls each makes
+#define NUM_UPDATERS       4
+#define NUM_SEARCHERS      2
+#define NUM_KEYS           256
+#define CALLS_PER_UPDATER  200000
+
+// The set and counts shared by the threads
+static SetInfoPtr TheSet;
+static atomic_int NetInserts[NUM_KEYS];
+static atomic_int UpdatersDone;
+static atomic_int Errors;
+
+// NumIsLess orders the set by num
+static bool NumIsLess (const UserData *first, const UserData *second);
+
+// Updater inserts or removes a random key on each call, counting the
+// calls that succeed
+static void *Updater (void *Arg);
+
+// Searcher looks keys up until the updaters are done
+static void *Searcher (void *Arg);
+
+int main(int argc, const char * argv[]) {
+    pthread_t Threads[NUM_UPDATERS + NUM_SEARCHERS];
+    unsigned int Seeds[NUM_UPDATERS + NUM_SEARCHERS];
+    printf ("%d threads insert and remove %d keys while %d threads search\n",
+            NUM_UPDATERS, NUM_KEYS, NUM_SEARCHERS);
+    TheSet = LFS_Init (NumIsLess);
+    for (int loop = 0; loop < NUM_UPDATERS + NUM_SEARCHERS; loop++) {
+        Seeds[loop] = loop + 1;
+        pthread_create (&Threads[loop], NULL, loop < NUM_UPDATERS ? Updater : Searcher, &Seeds[loop]);
+    }
+    for (int loop = 0; loop < NUM_UPDATERS + NUM_SEARCHERS; loop++)
+        pthread_join (Threads[loop], NULL);
+
+    // every key has to agree with the net count of its inserts and removes
+    SetHandle Me = LFS_Attach (TheSet);
+    int Members = 0;
+    for (int loop = 0; loop < NUM_KEYS; loop++) {
+        UserData Key = { loop };
+        bool InSet = LFS_Contains (Me, Key, NULL);
+        int Net = atomic_load (&NetInserts[loop]);
+        if (Net != (InSet ? 1 : 0))
+            atomic_fetch_add (&Errors, 1);
+        Members += InSet;
+    }
+    LFS_Detach (Me);
+
+    // walk the list itself, now that no thread is changing it
+    int Linked = 0;
+    int Last = -1;
+    for (SetNodePtr curr = (SetNodePtr) atomic_load (&TheSet->Head); curr != NULL; Linked++) {
+        uintptr_t Next = atomic_load (&curr->Next);
+        if ((Next & 1) != 0 || curr->Data.num <= Last)
+            atomic_fetch_add (&Errors, 1);
+        Last = curr->Data.num;
+        curr = (SetNodePtr) Next;
+    }
+    printf ("Members: %d found, %d linked, size %d\n", Members, Linked, LFS_Size (TheSet));
+    if (Linked != Members || LFS_Size (TheSet) != Members)
+        atomic_fetch_add (&Errors, 1);
+    TheSet = LFS_Delete (TheSet);
+
+    printf ("Errors: %d, the allocation count is now %d\n", atomic_load (&Errors), AllocationCount);
+    return (Errors == 0 && AllocationCount == 0) ? 0 : 1;
+}
+
+// function NumIsLess returns true if first's num is the smaller
+bool NumIsLess (const UserData *first, const UserData *second)
+{
+    return first->num < second->num;
+}
+
+// function Updater picks a key and an action at random each call
+void *Updater (void *Arg)
+{
+    unsigned int Seed = *(unsigned int *) Arg;
+    SetHandle Me = LFS_Attach (TheSet);
+    for (int loop = 0; loop < CALLS_PER_UPDATER; loop++) {
+        UserData Key = { rand_r (&Seed) % NUM_KEYS };
+        if (rand_r (&Seed) % 2 == 0) {
+            if (LFS_Insert (Me, Key))
+                atomic_fetch_add (&NetInserts[Key.num], 1);
+        }
+        else if (LFS_Remove (Me, Key))
+            atomic_fetch_sub (&NetInserts[Key.num], 1);
+    }
+    LFS_Detach (Me);
+    atomic_fetch_add (&UpdatersDone, 1);
+    return NULL;
+}
+
+// function Searcher checks that whatever it finds is the key it asked for
+void *Searcher (void *Arg)
+{
+    unsigned int Seed = *(unsigned int *) Arg;
+    SetHandle Me = LFS_Attach (TheSet);
+    while (atomic_load (&UpdatersDone) < NUM_UPDATERS) {
+        UserData Key = { rand_r (&Seed) % NUM_KEYS };
+        UserData Found;
+        if (LFS_Contains (Me, Key, &Found) && Found.num != Key.num)
+            atomic_fetch_add (&Errors, 1);
+    }
+    LFS_Detach (Me);
+    return NULL;
+}
@@ -0,0 +1,69 @@
+#ifndef MEMORYACCOUNT_H_INCLUDED
+#define MEMORYACCOUNT_H_INCLUDED
+
+// MemoryAccount.h declares the memory accounting that the containers use
+// to verify their allocation and deallocation of dynamic memory.  Every
+// malloc'd (or pooled) piece of a container is reported here by kind
+// with its size, right after it is allocated and right after it is
+// freed.  For each kind the account keeps the number of allocations
+// that are live, the bytes they hold and the most bytes ever held at
+// once (the high-water mark).
+//
+// The counters are C11 atomics, so containers used from several threads
+// at once still count correctly.  When the program exits with any
+// allocation still live, a leak report is printed to stderr.
+
+// size_t is defined in stddef.h
+#include <stddef.h>
+// MA_Report prints to a FILE
+#include <stdio.h>
+
+// MemoryKind says what an allocation is for, so the account can keep
+// the memory of each kind of structure apart
+typedef enum {
+    MA_LIST_NODE,   // a list node, or the array or block holding list data
+    MA_LL_INFO,     // a LinkedList information block (LLInfo)
+    MA_STACK_INFO,  // a stack structure (StackInfo)
+    MA_QUEUE_INFO,  // a queue structure (QueueInfo)
+    MA_TREE_NODE,   // a binary tree node (TreeNode)
+    MA_NUM_KINDS
+} MemoryKind;
+
+// MA_Allocated records that Bytes of Kind were just allocated
+void   MA_Allocated       (MemoryKind Kind, size_t Bytes);
+
+// MA_Released records that Bytes of Kind were just freed
+void   MA_Released        (MemoryKind Kind, size_t Bytes);
+
+// MA_ReleasedMany records that Count allocations of Kind, each of Bytes,
+// were just freed
+void   MA_ReleasedMany    (MemoryKind Kind, int Count, size_t Bytes);
+
+// MA_Resized records that a live allocation of Kind was realloc'd from
+// OldBytes to NewBytes; it is still one allocation
+void   MA_Resized         (MemoryKind Kind, size_t OldBytes, size_t NewBytes);
+
+// MA_AllocationCount returns the number of allocations live, all kinds
+int    MA_AllocationCount (void);
+
+// MA_LiveCount returns the number of allocations of Kind that are live
+int    MA_LiveCount       (MemoryKind Kind);
+
+// MA_LiveBytes returns the bytes held by the live allocations of Kind
+size_t MA_LiveBytes       (MemoryKind Kind);
+
+// MA_PeakBytes returns the most bytes of Kind that were live at one time
+size_t MA_PeakBytes       (MemoryKind Kind);
+
+// MA_Report prints the live count, live bytes and high-water mark of
+// every kind to Out
+void   MA_Report          (FILE *Out);
+
+// Verifying allocation / deallocation of dynamic memory used to be done
+// through a global int called AllocationCount.  It is kept, read only,
+// as the number of allocations that are live, so code like
+//      printf ("#allocations is %d\n", AllocationCount);
+// works as before.
+#define AllocationCount (MA_AllocationCount ())
+
+#endif // MEMORYACCOUNT_H_INCLUDED
@@ -5,6 +5,8 @@
 // The intent is to have a linked list that will support
 //      - placing nodes at the front of a list,
 //      - placing nodes at the end of a list
+//      - placing and removing nodes just after a given node,
+//      - reversing the order of the nodes in a list,
 //      - reporting the number of nodes in a list,
 //      - swapping node content,
 //      - reading any node content as if it were an array where
@@ -77,12 +79,9 @@
 //         "Tail".
 //      2. It declares the functions callable for a linked list.
 #include "LinkedList.h"
-
-// To make sure we are allocating and deallocating dynamic memory,
-// variable AllocationCount is declared within the LinkedList code
-// and can be referenced by any other code that does dynamic memory
-// allocation and deallocation that uses a linked list
-int AllocationCount = 0;
+// stddef provides offsetof, used to get from a node's "next" link back
+// to the node itself
+#include <stddef.h>
 
 // locally called function declarations follow..
 //
@@ -90,17 +89,23 @@ int AllocationCount = 0;
 // using the UserData
 static NodePtr MakeNode (UserData theData);
 
+// MakeEmptyNode is called to allocate a node whose UserData the caller fills in
+static NodePtr MakeEmptyNode (void);
+
 // GetNodeAddress is used to return a pointer to an LL node, given an index
 // It will return the address of the node w/o changing it's value
 static NodePtr GetNodeAddress (LLInfoPtr LLI_Ptr, int FetchIndex);
 
+// MergeRuns merges two sorted runs of nodes into one for LL_Sort
+static NodePtr MergeRuns (NodePtr First, NodePtr Second, LLComparison InOrder);
+
 
 // Externally callable functions for a user of the Linked List
 // follow
 
 /////////////
 // LL_Init is used to allocate and initialize a LinkedList
-// Information structure.  It will update the AllocationCount
+// Information structure.  It will update the memory account
 // to reflect the malloc of the struct and return the pointer
 // to the struct for the caller to use when calling any
 // other function in the linked list
@@ -114,8 +119,8 @@ LLInfoPtr LL_Init()
     LLI_Ptr->Head = NULL;
     LLI_Ptr->Tail = NULL;
     LLI_Ptr->NumNodesInList = 0;
-    // update AllocationCount to reflect the malloc
-    AllocationCount++;
+    // update the memory account to reflect the malloc
+    MA_Allocated (MA_LL_INFO, sizeof (LLInfo));
     // return the pointer to the allocated struct to the caller
     return LLI_Ptr;
 }
@@ -128,7 +133,7 @@ LLInfoPtr LL_Init()
 // It does so by simply calling LL_GetFront to read
 // each node with a delete option.  Once all the nodes
 // have been deleted, it frees the memory associated with
-// the LinkedList information struct and updates the AllocationCount
+// the LinkedList information struct and updates the memory account
 // to reflect the memory release.
 /////////////
 LLInfoPtr LL_Delete(LLInfoPtr LLI_Ptr)
@@ -145,9 +150,9 @@ LLInfoPtr LL_Delete(LLInfoPtr LLI_Ptr)
     // structure itself
     free(LLI_Ptr);
     LLI_Ptr = NULL;
-    // Update the AllocationCount to reflect the
+    // Update the memory account to reflect the
     // dealloction of the Information structure
-    AllocationCount--;
+    MA_Released (MA_LL_INFO, sizeof (LLInfo));
     // return a NULL because the list structure no longer exists
     return NULL;
 
@@ -197,8 +202,11 @@ void LL_AddAtFront (LLInfoPtr LLI_Ptr, UserData theData)
 // in the LinkedList Information structure LL_Ptr.
 // If there are no nodes currently in the list, it simply
 // calls LL_ADDAtFront to handle the situation.  Otherwise,
-// it uses Head to move to the end of the list and links the
-// new node to the end, updating Tail.
+// it links the new node after the Tail and makes it the new Tail.
+// Every function that changes the end of the list keeps Tail up to
+// date, so there is no need to walk from Head to find the end, and a
+// list built up from the end takes the same time per node however
+// long it gets.
 /////////////
 
 void LL_AddAtEnd (LLInfoPtr LLI_Ptr, UserData theData)
@@ -216,15 +224,10 @@ void LL_AddAtEnd (LLInfoPtr LLI_Ptr, UserData theData)
     // to become the new Tail
     else
     {
-        // start at the head of the list
-        NodePtr EndNode = LLI_Ptr->Head;
-        // move forward until we get to last node
-        while (EndNode->next != NULL)
-            EndNode = EndNode->next;
         // make a node to insert and link it to the
         // current last node
         NodePtr NewNode = (NodePtr) MakeNode(theData);
-        EndNode->next = NewNode;
+        LLI_Ptr->Tail->next = NewNode;
         // The new Tail is the Node just allocated
         LLI_Ptr->Tail = NewNode;
         // update the number of nodes in the list to reflect
@@ -270,8 +273,8 @@ UserData LL_GetFront (LLInfoPtr LLI_Ptr, ShouldDelete Choice)
         free (top);
         top = NULL;
         // because a node has been freed, update the
-        // allocation count in the list
-        AllocationCount--;
+        // memory account
+        MA_Released (MA_LIST_NODE, sizeof (Node));
         // because a node has been freed, update the
         // number of remaining nodes in the list
         LLI_Ptr->NumNodesInList--;
@@ -303,32 +306,23 @@ int  LL_Length  (LLInfoPtr LLI_Ptr)
 /////////////
 // LL_GetAtIndex returns the UserData at the specified index
 // in the underlying LL.
-// It counts nodes from the front of the LL held by Head,
-// returning the UserData at the index requested
+// It calls GetNodeAddress to find the node at the index requested,
+// returning its UserData
 /////////////
 UserData  LL_GetAtIndex (LLInfoPtr LLI_Ptr, int FetchIndex)
 {
     // Make sure the LL exists and the index is valid
     assert (LLI_Ptr != NULL);
     assert ((FetchIndex >= 0) && (FetchIndex < LLI_Ptr->NumNodesInList) );
-    int DesiredNodeCount = FetchIndex;
-    // start at the head of the list
-    NodePtr DesiredNode = LLI_Ptr->Head;
-    // move forward until we get to node[FetchIndex]
-    while (DesiredNodeCount--)
-    {
-        // advance forward
-        DesiredNode = DesiredNode->next;
-    }
-    // return its UserData
-    return DesiredNode->Data;
+    // return the UserData of node[FetchIndex]
+    return GetNodeAddress(LLI_Ptr, FetchIndex)->Data;
 }
 
 /////////////
 // LL_SetAtIndex updates the node UserData at the specified index
 // in the underlying LL.
-// It counts nodes from the front of the LL held by Head.
-// Once the position in the LL has been reached, the data is updated to what
+// It calls GetNodeAddress to find the node to update.
+// Once the node has been found, the data is updated to what
 // was provided by the caller by overwriting the data itself.
 /////////////
 void  LL_SetAtIndex (LLInfoPtr LLI_Ptr, UserData D, int UpdateIndex)
@@ -336,17 +330,8 @@ void  LL_SetAtIndex (LLInfoPtr LLI_Ptr, UserData D, int UpdateIndex)
     // Make sure the LL exists and the index is valid
     assert (LLI_Ptr != NULL);
     assert ((UpdateIndex >= 0) && (UpdateIndex < LLI_Ptr->NumNodesInList) );
-    int DesiredNodeCount = UpdateIndex;
-    // start at the head of the list
-    NodePtr DesiredNode = LLI_Ptr->Head;
-    // move forward until we get to node[UpdateIndex]
-    while (DesiredNodeCount--)
-    {
-        // advance forward
-        DesiredNode = DesiredNode->next;
-    }
-    // update the node's UserData
-    DesiredNode->Data = D;
+    // update the UserData of node[UpdateIndex]
+    GetNodeAddress(LLI_Ptr, UpdateIndex)->Data = D;
 }
 
 //////////////
@@ -374,22 +359,310 @@ void  LL_Swap (LLInfoPtr LLI_Ptr, int Index1, int Index2)
     return;
 }
 
+/////////////
+// LL_PeekFrontPtr returns the address of the UserData at the front
+// of the LL instead of a copy of it, so a large UserData is not copied
+// just to be looked at.  The caller may read or update the UserData
+// through the address, which is good until that node is deleted.
+/////////////
+UserData *LL_PeekFrontPtr (LLInfoPtr LLI_Ptr)
+{
+    // Make sure the LL exists and has a node at the front
+    assert (LLI_Ptr != NULL);
+    assert (LLI_Ptr->Head != NULL);
+    return &LLI_Ptr->Head->Data;
+}
+
+/////////////
+// LL_AtIndexPtr returns the address of the UserData at the specified
+// index in the underlying LL, instead of a copy of it.  Like
+// LL_PeekFrontPtr, the address is good until that node is deleted.
+/////////////
+UserData *LL_AtIndexPtr (LLInfoPtr LLI_Ptr, int FetchIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((FetchIndex >= 0) && (FetchIndex < LLI_Ptr->NumNodesInList) );
+    return &GetNodeAddress(LLI_Ptr, FetchIndex)->Data;
+}
+
+/////////////
+// LL_EmplaceFront adds a node to the front of the LL, like
+// LL_AddAtFront, but rather than copying in UserData passed by value
+// it returns the address of the new node's UserData for the caller to
+// fill in place.  Until the caller does, the UserData holds whatever
+// was in the node's memory.
+/////////////
+UserData *LL_EmplaceFront (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    NodePtr NewNode = MakeEmptyNode();
+    NewNode->next = LLI_Ptr->Head;
+    if (LLI_Ptr->Head == NULL)
+        LLI_Ptr->Tail = NewNode;
+    LLI_Ptr->Head = NewNode;
+    LLI_Ptr->NumNodesInList++;
+    return &NewNode->Data;
+}
+
+/////////////
+// LL_EmplaceEnd adds a node after the Tail of the LL and returns the
+// address of its UserData for the caller to fill in
+/////////////
+UserData *LL_EmplaceEnd (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    NodePtr NewNode = MakeEmptyNode();
+    if (LLI_Ptr->Tail != NULL)
+        LLI_Ptr->Tail->next = NewNode;
+    else
+        LLI_Ptr->Head = NewNode;
+    LLI_Ptr->Tail = NewNode;
+    LLI_Ptr->NumNodesInList++;
+    return &NewNode->Data;
+}
+
+/////////////
+// LL_ForEach calls Visit for each node from the Head to the Tail,
+// passing the address of the node's UserData and the caller's Context.
+// Visit may update the UserData but must not add or delete nodes.
+/////////////
+void LL_ForEach (LLInfoPtr LLI_Ptr, LLVisitor Visit, void *Context)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Visit != NULL);
+    for (NodePtr curr = LLI_Ptr->Head; curr != NULL; curr = curr->next)
+        Visit (&curr->Data, Context);
+}
+
+/////////////
+// The cursor functions let a caller walk the list a node at a time and
+// change it where they are, instead of counting from the Head for each
+// index.  A cursor is the address of the link that points at a node,
+// so a node can be added or deleted at a cursor by just changing that
+// link, even though there is no "prev" to find the node before it.
+/////////////
+LLCursor LL_Begin (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    return &LLI_Ptr->Head;
+}
+
+LLCursor LL_End (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    return (LLI_Ptr->Tail == NULL) ? &LLI_Ptr->Head : &LLI_Ptr->Tail->next;
+}
+
+LLCursor LL_Next (LLInfoPtr LLI_Ptr, LLCursor Cursor)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Cursor != NULL && *Cursor != NULL);
+    return &(*Cursor)->next;
+}
+
+/////////////
+// LL_Prev has no "prev" link to follow, so it counts from the Head
+// until it reaches the link just before Cursor.
+/////////////
+LLCursor LL_Prev (LLInfoPtr LLI_Ptr, LLCursor Cursor)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Cursor != NULL && Cursor != &LLI_Ptr->Head);
+    LLCursor curr = &LLI_Ptr->Head;
+    while (&(*curr)->next != Cursor)
+        curr = &(*curr)->next;
+    return curr;
+}
+
+UserData LL_GetAtCursor (LLInfoPtr LLI_Ptr, LLCursor Cursor)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Cursor != NULL && *Cursor != NULL);
+    return (*Cursor)->Data;
+}
+
+void LL_SetAtCursor (LLInfoPtr LLI_Ptr, LLCursor Cursor, UserData D)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Cursor != NULL && *Cursor != NULL);
+    (*Cursor)->Data = D;
+}
+
+/////////////
+// LL_InsertBefore makes a node for theData and makes the link at Cursor
+// point to it, with the new node linking on to the node that was there.
+// A node added at LL_End becomes the new Tail.
+// The new node is now at Cursor, so Cursor is returned.
+/////////////
+LLCursor LL_InsertBefore (LLInfoPtr LLI_Ptr, LLCursor Cursor, UserData theData)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Cursor != NULL);
+    NodePtr NewNode = MakeNode (theData);
+    NewNode->next = *Cursor;
+    if (*Cursor == NULL)
+        LLI_Ptr->Tail = NewNode;
+    *Cursor = NewNode;
+    LLI_Ptr->NumNodesInList++;
+    return Cursor;
+}
+
+/////////////
+// LL_Erase makes the link at Cursor skip over the node there and frees
+// the node.  If the node was the Tail, the node holding the link (if it
+// is not Head) is the new Tail.
+// The node that followed is now at Cursor, so Cursor is returned.
+/////////////
+LLCursor LL_Erase (LLInfoPtr LLI_Ptr, LLCursor Cursor)
+{
+    assert (LLI_Ptr != NULL);
+    assert (Cursor != NULL && *Cursor != NULL);
+    NodePtr theNode = *Cursor;
+    *Cursor = theNode->next;
+    if (theNode == LLI_Ptr->Tail)
+        LLI_Ptr->Tail = (Cursor == &LLI_Ptr->Head) ? NULL :
+                        (NodePtr) ((char *) Cursor - offsetof (Node, next));
+    free (theNode);
+    MA_Released (MA_LIST_NODE, sizeof (Node));
+    LLI_Ptr->NumNodesInList--;
+    return Cursor;
+}
+
+/////////////
+// LL_InsertAfter makes a node for theData and links it in just after
+// the node at AfterIndex.  The "next" of that node is the cursor where
+// the new node goes, so LL_InsertBefore does the linking, including
+// making the new node the Tail when it goes after the Tail.
+// Adding after the last node finds it through Tail without counting.
+/////////////
+void LL_InsertAfter (LLInfoPtr LLI_Ptr, UserData theData, int AfterIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((AfterIndex >= 0) && (AfterIndex < LLI_Ptr->NumNodesInList) );
+    NodePtr Before = GetNodeAddress(LLI_Ptr, AfterIndex);
+    LL_InsertBefore (LLI_Ptr, &Before->next, theData);
+}
+
+/////////////
+// LL_RemoveAfter removes the node just after the node at AfterIndex
+// and returns its UserData.  The "next" of the node at AfterIndex is
+// the cursor at the node removed, so LL_Erase does the unlinking,
+// including moving the Tail back when the Tail is removed.
+/////////////
+UserData LL_RemoveAfter (LLInfoPtr LLI_Ptr, int AfterIndex)
+{
+    // Make sure the LL exists and there is a node after the index
+    assert (LLI_Ptr != NULL);
+    assert ((AfterIndex >= 0) && (AfterIndex < LLI_Ptr->NumNodesInList - 1) );
+    NodePtr Before = GetNodeAddress(LLI_Ptr, AfterIndex);
+    UserData D = Before->next->Data;
+    LL_Erase (LLI_Ptr, &Before->next);
+    return D;
+}
+
+/////////////
+// LL_Reverse reverses the list in place by turning each "next" link
+// around as it walks from the Head, so no node is allocated or copied.
+// The old Head is the new Tail.
+/////////////
+void LL_Reverse (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    NodePtr prevNode = NULL;
+    NodePtr curr = LLI_Ptr->Head;
+    while (curr != NULL) {
+        NodePtr nextNode = curr->next;
+        curr->next = prevNode;
+        prevNode = curr;
+        curr = nextNode;
+    }
+    LLI_Ptr->Tail = LLI_Ptr->Head;
+    LLI_Ptr->Head = prevNode;
+}
+
+/////////////
+// LL_Sort sorts the list with a bottom-up merge sort that relinks the
+// nodes, so no UserData is copied and nothing is allocated.
+// Runs[i] is either empty or a sorted run of 2^i nodes.  The nodes are
+// taken off the list one at a time and each becomes a run of 1 that is
+// merged with Runs[0], then the result with Runs[1] and so on until an
+// empty entry is found to hold it, much like adding 1 to a binary number.
+// Merges therefore happen while the nodes involved were used recently,
+// instead of walking the whole list once for every doubling of the run
+// size.  At the end the remaining runs are merged together.
+// Runs only ever hold nodes that came before the ones being merged into
+// them, and MergeRuns keeps the earlier run first when nodes are equal,
+// so the sort is stable.
+// Only the "next" links are followed while merging; the Tail is found
+// in one walk at the end.
+/////////////
+void LL_Sort (LLInfoPtr LLI_Ptr, LLComparison InOrder)
+{
+    assert (LLI_Ptr != NULL);
+    assert (InOrder != NULL);
+    if (LLI_Ptr->NumNodesInList < 2)
+        return;
+    // a run of 2^i nodes fits in an int sized list for every i used
+    NodePtr Runs[sizeof (int) * 8] = {NULL};
+    int NumRuns = 0;
+    NodePtr curr = LLI_Ptr->Head;
+    while (curr != NULL) {
+        NodePtr nextNode = curr->next;
+        curr->next = NULL;
+        // merge the single node up through the runs until there is room for it
+        NodePtr carry = curr;
+        int i = 0;
+        for (; Runs[i] != NULL; i++) {
+            carry = MergeRuns (Runs[i], carry, InOrder);
+            Runs[i] = NULL;
+        }
+        Runs[i] = carry;
+        if (i >= NumRuns)
+            NumRuns = i + 1;
+        curr = nextNode;
+    }
+    // merge what is left, from the newest (smallest) run to the oldest
+    NodePtr list = NULL;
+    for (int i = 0; i < NumRuns; i++)
+        if (Runs[i] != NULL)
+            list = (list == NULL) ? Runs[i] : MergeRuns (Runs[i], list, InOrder);
+    // find the new Tail
+    LLI_Ptr->Head = list;
+    while (list->next != NULL)
+        list = list->next;
+    LLI_Ptr->Tail = list;
+}
+
 /////////////
 // Local function MakeNode allocates and initializes a Node for placement
 // in the LL.  It copies over the user data into the allocated node and NULLs the
 // node's "next" link.
 /////////////
 NodePtr MakeNode (UserData theData)
+{
+    // get an unlinked node, then copy in the user data without
+    // copying field by field.
+    NodePtr NewNode = MakeEmptyNode();
+    NewNode->Data = theData;
+    return NewNode;
+}
+
+/////////////
+// Local function MakeEmptyNode allocates a Node for placement in the
+// LL and NULLs its "next" link.  Its UserData is left for the caller
+// to fill in.
+/////////////
+NodePtr MakeEmptyNode (void)
 {
     // allocate a node to contain the user's data
     NodePtr NewNode = (NodePtr) malloc (sizeof (Node));
     assert (NewNode != NULL);
-    // copy in the user data without copying field by field.
-    NewNode->Data = theData;
     // "next" defaults to NULL
     NewNode->next = NULL;
-    // Update the number of allocations to reflect the malloc
-    AllocationCount++;
+    // Update the memory account to reflect the malloc
+    MA_Allocated (MA_LIST_NODE, sizeof (Node));
     // return the pointer to the node ready to link in
     return NewNode;
 }
@@ -397,7 +670,8 @@ NodePtr MakeNode (UserData theData)
 /////////////
 // GetNodeAddress is a utility function that will locate
 // the node at Index and return its address.
-// It counts nodes from the front of the LL held by Head.
+// The last node is the Tail, so it is returned without counting.
+// Otherwise it counts nodes from the front of the LL held by Head.
 // Once the position in the LL has been reached, the node adress
 // is returned.
 /////////////
@@ -406,6 +680,9 @@ NodePtr GetNodeAddress (LLInfoPtr LLI_Ptr, int FetchIndex)
     // Make sure the LL exists and the index is valid
     assert (LLI_Ptr != NULL);
     assert ((FetchIndex >= 0) && (FetchIndex < LLI_Ptr->NumNodesInList) );
+    // the last node needs no counting
+    if (FetchIndex == LLI_Ptr->NumNodesInList - 1)
+        return LLI_Ptr->Tail;
     int DesiredNodeCount = FetchIndex;
     // start at the head of the list
     NodePtr DesiredNode = LLI_Ptr->Head;
@@ -419,5 +696,27 @@ NodePtr GetNodeAddress (LLInfoPtr LLI_Ptr, int FetchIndex)
     return DesiredNode;
 }
 
-
-
+/////////////
+// Local function MergeRuns merges two sorted runs, each ending in a NULL
+// "next", into one sorted run and returns its first node.  First holds
+// the nodes that came earlier in the list, so on equal nodes it is taken
+// from First to keep the sort stable.
+/////////////
+NodePtr MergeRuns (NodePtr First, NodePtr Second, LLComparison InOrder)
+{
+    NodePtr Merged = NULL;
+    NodePtr *Link = &Merged;
+    while (First != NULL && Second != NULL) {
+        if (InOrder (&Second->Data, &First->Data)) {
+            *Link = Second;
+            Second = Second->next;
+        } else {
+            *Link = First;
+            First = First->next;
+        }
+        Link = &(*Link)->next;
+    }
+    // whatever is left of either run is already in order
+    *Link = (First != NULL) ? First : Second;
+    return Merged;
+}
@@ -20,7 +20,8 @@ typedef struct node
 // For speed, it also contains a running count of the number of nodes
 // currently in the LL started at Head and finishing at Tail.
 // Head is used when adding or removing from the LL front,
-// Tail is needed only when adding to the end of the LL
+// Tail is used when adding to the end of the LL, so that the end is
+// reached without walking the list
 typedef struct {
     NodePtr Head;
     NodePtr Tail;
@@ -63,4 +64,11 @@ UserData        LL_GetAtIndex   (LLInfoPtr, int FetchIndex);
 void            LL_SetAtIndex   (LLInfoPtr LLI_Ptr, UserData D, int UpdateIndex);
 // LL_Swap swaps the nodes in the underlying LL specified by indices starting at 0
 void            LL_Swap         (LLInfoPtr LLI_Ptr, int Index1, int Index2);
+// LL_InsertAfter adds user data just after the node at the specified index starting at 0
+void            LL_InsertAfter  (LLInfoPtr LLI_Ptr, UserData theData, int AfterIndex);
+// LL_RemoveAfter removes the node just after the node at the specified index starting
+// at 0 and returns its user data
+UserData        LL_RemoveAfter  (LLInfoPtr LLI_Ptr, int AfterIndex);
+// LL_Reverse reverses the order of the nodes in the underlying LL in place
+void            LL_Reverse      (LLInfoPtr LLI_Ptr);
 #endif // LINKEDLIST_H_INCLUDED
@@ -5,6 +5,8 @@
 // The intent is to have a linked list that will support
 //      - placing nodes at the front of a list,
 //      - placing nodes at the end of a list
+//      - placing and removing nodes just after a given node,
+//      - reversing the order of the nodes in a list,
 //      - reporting the number of nodes in a list,
 //      - swapping node content,
 //      - reading any node content as if it were an array where
@@ -197,8 +199,11 @@ void LL_AddAtFront (LLInfoPtr LLI_Ptr, UserData theData)
 // in the LinkedList Information structure LL_Ptr.
 // If there are no nodes currently in the list, it simply
 // calls LL_ADDAtFront to handle the situation.  Otherwise,
-// it uses Head to move to the end of the list and links the
-// new node to the end, updating Tail.
+// it links the new node after the Tail and makes it the new Tail.
+// Every function that changes the end of the list keeps Tail up to
+// date, so there is no need to walk from Head to find the end, and a
+// list built up from the end takes the same time per node however
+// long it gets.
 /////////////
 
 void LL_AddAtEnd (LLInfoPtr LLI_Ptr, UserData theData)
@@ -216,15 +221,10 @@ void LL_AddAtEnd (LLInfoPtr LLI_Ptr, UserData theData)
     // to become the new Tail
     else
     {
-        // start at the head of the list
-        NodePtr EndNode = LLI_Ptr->Head;
-        // move forward until we get to last node
-        while (EndNode->next != NULL)
-            EndNode = EndNode->next;
         // make a node to insert and link it to the
         // current last node
         NodePtr NewNode = (NodePtr) MakeNode(theData);
-        EndNode->next = NewNode;
+        LLI_Ptr->Tail->next = NewNode;
         // The new Tail is the Node just allocated
         LLI_Ptr->Tail = NewNode;
         // update the number of nodes in the list to reflect
@@ -303,32 +303,23 @@ int  LL_Length  (LLInfoPtr LLI_Ptr)
 /////////////
 // LL_GetAtIndex returns the UserData at the specified index
 // in the underlying LL.
-// It counts nodes from the front of the LL held by Head,
-// returning the UserData at the index requested
+// It calls GetNodeAddress to find the node at the index requested,
+// returning its UserData
 /////////////
 UserData  LL_GetAtIndex (LLInfoPtr LLI_Ptr, int FetchIndex)
 {
     // Make sure the LL exists and the index is valid
     assert (LLI_Ptr != NULL);
     assert ((FetchIndex >= 0) && (FetchIndex < LLI_Ptr->NumNodesInList) );
-    int DesiredNodeCount = FetchIndex;
-    // start at the head of the list
-    NodePtr DesiredNode = LLI_Ptr->Head;
-    // move forward until we get to node[FetchIndex]
-    while (DesiredNodeCount--)
-    {
-        // advance forward
-        DesiredNode = DesiredNode->next;
-    }
-    // return its UserData
-    return DesiredNode->Data;
+    // return the UserData of node[FetchIndex]
+    return GetNodeAddress(LLI_Ptr, FetchIndex)->Data;
 }
 
 /////////////
 // LL_SetAtIndex updates the node UserData at the specified index
 // in the underlying LL.
-// It counts nodes from the front of the LL held by Head.
-// Once the position in the LL has been reached, the data is updated to what
+// It calls GetNodeAddress to find the node to update.
+// Once the node has been found, the data is updated to what
 // was provided by the caller by overwriting the data itself.
 /////////////
 void  LL_SetAtIndex (LLInfoPtr LLI_Ptr, UserData D, int UpdateIndex)
@@ -336,17 +327,8 @@ void  LL_SetAtIndex (LLInfoPtr LLI_Ptr, UserData D, int UpdateIndex)
     // Make sure the LL exists and the index is valid
     assert (LLI_Ptr != NULL);
     assert ((UpdateIndex >= 0) && (UpdateIndex < LLI_Ptr->NumNodesInList) );
-    int DesiredNodeCount = UpdateIndex;
-    // start at the head of the list
-    NodePtr DesiredNode = LLI_Ptr->Head;
-    // move forward until we get to node[UpdateIndex]
-    while (DesiredNodeCount--)
-    {
-        // advance forward
-        DesiredNode = DesiredNode->next;
-    }
-    // update the node's UserData
-    DesiredNode->Data = D;
+    // update the UserData of node[UpdateIndex]
+    GetNodeAddress(LLI_Ptr, UpdateIndex)->Data = D;
 }
 
 //////////////
@@ -374,6 +356,72 @@ void  LL_Swap (LLInfoPtr LLI_Ptr, int Index1, int Index2)
     return;
 }
 
+/////////////
+// LL_InsertAfter makes a node for theData and links it in just after
+// the node at AfterIndex, which is found by GetNodeAddress.  When that
+// node is the Tail (found through Tail without counting) the new node
+// becomes the Tail.
+/////////////
+void LL_InsertAfter (LLInfoPtr LLI_Ptr, UserData theData, int AfterIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((AfterIndex >= 0) && (AfterIndex < LLI_Ptr->NumNodesInList) );
+    NodePtr Before = GetNodeAddress(LLI_Ptr, AfterIndex);
+    // link the new node between Before and the node after it
+    NodePtr NewNode = MakeNode(theData);
+    NewNode->next = Before->next;
+    Before->next = NewNode;
+    if (Before == LLI_Ptr->Tail)
+        LLI_Ptr->Tail = NewNode;
+    LLI_Ptr->NumNodesInList++;
+}
+
+/////////////
+// LL_RemoveAfter removes the node just after the node at AfterIndex
+// and returns its UserData.  When the node removed is the Tail, the
+// node at AfterIndex becomes the Tail.
+/////////////
+UserData LL_RemoveAfter (LLInfoPtr LLI_Ptr, int AfterIndex)
+{
+    // Make sure the LL exists and there is a node after the index
+    assert (LLI_Ptr != NULL);
+    assert ((AfterIndex >= 0) && (AfterIndex < LLI_Ptr->NumNodesInList - 1) );
+    NodePtr Before = GetNodeAddress(LLI_Ptr, AfterIndex);
+    NodePtr theNode = Before->next;
+    UserData D = theNode->Data;
+    // skip over the node and free it
+    Before->next = theNode->next;
+    if (theNode == LLI_Ptr->Tail)
+        LLI_Ptr->Tail = Before;
+    free (theNode);
+    // because a node has been freed, update the
+    // allocation count in the list
+    AllocationCount--;
+    LLI_Ptr->NumNodesInList--;
+    return D;
+}
+
+/////////////
+// LL_Reverse reverses the list in place by turning each "next" link
+// around as it walks from the Head, so no node is allocated or copied.
+// The old Head is the new Tail.
+/////////////
+void LL_Reverse (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    NodePtr prevNode = NULL;
+    NodePtr curr = LLI_Ptr->Head;
+    while (curr != NULL) {
+        NodePtr nextNode = curr->next;
+        curr->next = prevNode;
+        prevNode = curr;
+        curr = nextNode;
+    }
+    LLI_Ptr->Tail = LLI_Ptr->Head;
+    LLI_Ptr->Head = prevNode;
+}
+
 /////////////
 // Local function MakeNode allocates and initializes a Node for placement
 // in the LL.  It copies over the user data into the allocated node and NULLs the
@@ -397,7 +445,8 @@ NodePtr MakeNode (UserData theData)
 /////////////
 // GetNodeAddress is a utility function that will locate
 // the node at Index and return its address.
-// It counts nodes from the front of the LL held by Head.
+// The last node is the Tail, so it is returned without counting.
+// Otherwise it counts nodes from the front of the LL held by Head.
 // Once the position in the LL has been reached, the node adress
 // is returned.
 /////////////
@@ -406,6 +455,9 @@ NodePtr GetNodeAddress (LLInfoPtr LLI_Ptr, int FetchIndex)
     // Make sure the LL exists and the index is valid
     assert (LLI_Ptr != NULL);
     assert ((FetchIndex >= 0) && (FetchIndex < LLI_Ptr->NumNodesInList) );
+    // the last node needs no counting
+    if (FetchIndex == LLI_Ptr->NumNodesInList - 1)
+        return LLI_Ptr->Tail;
     int DesiredNodeCount = FetchIndex;
     // start at the head of the list
     NodePtr DesiredNode = LLI_Ptr->Head;
@@ -66,8 +66,8 @@ int main(int argc, const char * argv[]) {
     // peek at the data before popping it so we can see what peek yields
     while (!empty(sorted))
     {
-        PrintStackItem ("peek", peek(S));
-        PrintStackItem ("pop", pop(S));
+        PrintStackItem ("peek", peek(sorted));
+        PrintStackItem ("pop", pop(sorted));
     }
     // delete the stack and see the effect on the allocations
     PrintAllocations ("Before deleteStack");
@@ -169,8 +169,8 @@ Stack sortStack2(Stack inputStack, SortChoice SortChoice) {
         // check singular conditions under which we would pop from the temp stack
         // and place the item onto the input stack
         while (!empty(tempStack) &&
-            ((SortChoice == TASK_NUMBER && peek(tempStack).taskNumber > currentInputStackUserData.taskNumber) ||
-                (SortChoice == TASK_NAME && strcmp(peek(tempStack).taskName, currentInputStackUserData.taskName) > 0))) {
+            ((SortChoice == TASK_NUMBER && peekPtr(tempStack)->taskNumber > currentInputStackUserData.taskNumber) ||
+                (SortChoice == TASK_NAME && strcmp(peekPtr(tempStack)->taskName, currentInputStackUserData.taskName) > 0))) {
             push(inputStack, pop(tempStack));
         }
         // This is reached when the tempStack is empty, but the inputStack is not.
@@ -188,34 +188,35 @@ Stack sortStack(Stack inputStack, SortChoice SortChoice) {
         UserData currentInputStackUserData = pop(inputStack);
 
         while (!empty(tempStack)) {
-            // assign temp peeked variable to use for sort
-            UserData currentTempStackUserData = peek(tempStack);
+            // look at the top of the temp stack through a pointer, so its
+            // UserData (and the 80 char task name) is not copied every time
+            const UserData *currentTempStackUserData = peekPtr(tempStack);
+            bool moveBack;
 
             // check which choice to sort on
             switch (SortChoice) {
                 case TASK_NUMBER:
-                    // if the task number of the temp stack is greater than the current
-                    // task number from the input stack, pop the UserData from the temp stack
-                    // and push it onto the input stack.
-                    if (currentTempStackUserData.taskNumber > currentInputStackUserData.taskNumber)
-                        push(inputStack, pop (tempStack));
-                    else
-                        break;
+                    moveBack = currentTempStackUserData->taskNumber > currentInputStackUserData.taskNumber;
+                    break;
 
                 case TASK_NAME:
-                    if (strcmp(currentTempStackUserData.taskName, currentInputStackUserData.taskName) > 0)
-                        push(inputStack, pop(tempStack));
-                    else
-                        break;
+                    moveBack = strcmp(currentTempStackUserData->taskName, currentInputStackUserData.taskName) > 0;
+                    break;
 
                 default:
                     printf("Error, invalid sorting choice.\n");
-                    exit(0);;
+                    exit(0);
             }
+            // the temp stack is in order from here down, so stop
+            if (!moveBack)
+                break;
+            // otherwise, pop the UserData from the temp stack
+            // and push it onto the input stack.
+            push(inputStack, pop(tempStack));
         }
-        // This is reached when the tempStack is empty, but the inputStack is not.
-        // indicating there are still more items to sort.
+        // This is reached when the tempStack is empty, or its top belongs
+        // below the current item, so we push to the temp stack.
         push(tempStack, currentInputStackUserData);
     }
     return tempStack;
-}
\ No newline at end of file
+}
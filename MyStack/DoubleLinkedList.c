@@ -76,6 +76,9 @@ int AllocationCount = 0;
 // MakeNode are called to allocate and initialize a node using the UserData
 static NodePtr MakeNode (UserData theData);
 
+// MakeEmptyNode is called to allocate a node whose UserData the caller fills in
+static NodePtr MakeEmptyNode (void);
+
 // GetNodeAddress is used to return a pointer of an LL node, given an index
 // It will return the address of the node w/o changing its value
 static NodePtr GetNodeAddress (LLInfoPtr LLI_Ptr, int FetchIndex);
@@ -336,21 +339,98 @@ void  LL_Swap (LLInfoPtr LLI_Ptr, int Index1, int Index2)
     return;
 }
 
+/////////////
+// LL_PeekFrontPtr returns the address of the UserData at the front
+// of the LL instead of a copy of it, so a large UserData is not copied
+// just to be looked at.  The caller may read or update the UserData
+// through the address, which is good until that node is deleted.
+/////////////
+UserData *LL_PeekFrontPtr (LLInfoPtr LLI_Ptr)
+{
+    // Make sure the LL exists and has a node at the front
+    assert (LLI_Ptr != NULL);
+    assert (LLI_Ptr->Head != NULL);
+    return &LLI_Ptr->Head->Data;
+}
+
+/////////////
+// LL_AtIndexPtr returns the address of the UserData at the specified
+// index in the underlying LL, instead of a copy of it.  Like
+// LL_PeekFrontPtr, the address is good until that node is deleted.
+/////////////
+UserData *LL_AtIndexPtr (LLInfoPtr LLI_Ptr, int FetchIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((FetchIndex >= 0) && (FetchIndex < LLI_Ptr->NumNodesInList) );
+    return &GetNodeAddress(LLI_Ptr, FetchIndex)->Data;
+}
+
+/////////////
+// LL_EmplaceFront adds a node to the front of the LL, like
+// LL_AddAtFront, but rather than copying in UserData passed by value
+// it returns the address of the new node's UserData for the caller to
+// fill in place.  Until the caller does, the UserData holds whatever
+// was in the node's memory.
+/////////////
+UserData *LL_EmplaceFront (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    NodePtr NewNode = MakeEmptyNode();
+    NewNode->next = LLI_Ptr->Head;
+    if (LLI_Ptr->Head != NULL)
+        LLI_Ptr->Head->prev = NewNode;
+    else
+        LLI_Ptr->Tail = NewNode;
+    LLI_Ptr->Head = NewNode;
+    LLI_Ptr->NumNodesInList++;
+    return &NewNode->Data;
+}
+
+/////////////
+// LL_EmplaceEnd adds a node to the end of the LL, like LL_AddAtEnd,
+// and returns the address of its UserData for the caller to fill in
+/////////////
+UserData *LL_EmplaceEnd (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    NodePtr NewNode = MakeEmptyNode();
+    NewNode->prev = LLI_Ptr->Tail;
+    if (LLI_Ptr->Tail != NULL)
+        LLI_Ptr->Tail->next = NewNode;
+    else
+        LLI_Ptr->Head = NewNode;
+    LLI_Ptr->Tail = NewNode;
+    LLI_Ptr->NumNodesInList++;
+    return &NewNode->Data;
+}
+
 /////////////
 // Local function MakeNode allocates and initializes a Node for placement
 // in the LL.  It copies over the user data into the allocated node and NULLs the
 // node's "next" link.
 /////////////
 NodePtr MakeNode (UserData theData)
+{
+    // get an unlinked node, then copy in the user data without
+    // copying field by field.
+    NodePtr NewNode = MakeEmptyNode();
+    NewNode->Data = theData;
+    return NewNode;
+}
+
+/////////////
+// Local function MakeEmptyNode allocates a Node for placement in the
+// LL and NULLs its "next" and "prev" links.  Its UserData is left for
+// the caller to fill in.
+/////////////
+NodePtr MakeEmptyNode (void)
 {
     // allocate a node to contain the user's data
     // and abort if the allocation fails
     NodePtr NewNode = (NodePtr) malloc (sizeof (Node));
     assert (NewNode != NULL);
-    // allocation worked, copy in the user data without
-    // copying field by field.
-    NewNode->Data = theData;
-    // unless updated by the caller of MakeNode, the "next"
+    // unless updated by the caller, the "next"
     // and "prev" default to NULL
     NewNode->next = NULL;
     NewNode->prev = NULL;
@@ -62,4 +62,19 @@ UserData        LL_GetAtIndex   (LLInfoPtr, int FetchIndex);
 void            LL_SetAtIndex   (LLInfoPtr LLI_Ptr, UserData D, int UpdateIndex);
 // LL_Swap swaps the nodes in the underlying LL specified by indices starting at 0
 void            LL_Swap         (LLInfoPtr LLI_Ptr, int Index1, int Index2);
+
+// The functions below hand out the address of user data inside the LL rather than
+// a copy, so a large UserData is not copied.  An address is good until the user
+// data it points to is deleted.
+
+// LL_PeekFrontPtr returns the address of the user data at the Head of the underlying LL
+UserData       *LL_PeekFrontPtr (LLInfoPtr LLI_Ptr);
+// LL_AtIndexPtr returns the address of the user data at the specified index starting at 0
+UserData       *LL_AtIndexPtr   (LLInfoPtr LLI_Ptr, int FetchIndex);
+// LL_EmplaceFront adds a node at the Head and returns the address of its user data for
+// the caller to fill in
+UserData       *LL_EmplaceFront (LLInfoPtr LLI_Ptr);
+// LL_EmplaceEnd adds a node at the Tail and returns the address of its user data for
+// the caller to fill in
+UserData       *LL_EmplaceEnd   (LLInfoPtr LLI_Ptr);
 #endif // LINKEDLIST_H_INCLUDED
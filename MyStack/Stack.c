@@ -83,3 +83,13 @@ UserData    peek (Stack S)
     assert ( (S != NULL) && (S->empty != true) );
     return LL_GetFront(S->LL, RETAIN_NODE);
 }
+
+/*
+   peekPtr() returns the address of the UserData at the front of the stack
+   without copying it, by calling the linked list LL_PeekFrontPtr()
+*/
+UserData   *peekPtr (Stack S)
+{
+    assert ( (S != NULL) && (S->empty != true) );
+    return LL_PeekFrontPtr(S->LL);
+}
@@ -37,6 +37,11 @@ UserData    pop (Stack S);
 // delete it from the stack
 UserData    peek (Stack S);
 
+// peekPtr() returns the address of the UserData on the top of the stack instead
+// of a copy, so a large UserData is not copied just to be looked at.  The address
+// is good until that UserData is popped
+UserData   *peekPtr (Stack S);
+
 // deleteStack() deletes the frees the storage that was allocated by the call
 // to initStack()
 Stack       deleteStack(Stack S);
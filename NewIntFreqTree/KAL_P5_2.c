@@ -35,6 +35,9 @@
 // it is used whenever a boolean is being produced, used, or passed back to a caller
 #include <stdbool.h>
 
+// MemoryAccount counts the TreeNodes allocated and provides AllocationCount
+#include "MemoryAccount.h"
+
 // <<< you need to describe what each of these is and how it is used in the solution
 #define MaxIntSize 20
 #define INFILENAME "integers.in"
@@ -86,12 +89,6 @@ int compareIntegers (int x, int y);
 
 TreeNodePtr deleteTree         (TreeNodePtr nodeP);
 
-// To make sure we are allocating and deallocating dynamic memory,
-// variable AllocationCount is declared within the BinaryTree code.
-// It could be referenced by any other code that does dynamic memory
-// allocation and deallocation if we needed using extern
-int AllocationCount = 0;
-
 // main will do the following:
 //      1. It opens both an input and output file. Failure to be able to
 //          open the files will result in program termination
@@ -241,8 +238,8 @@ TreeNodePtr newTreeNode(NodeData nodeInformation)
     p -> data = nodeInformation;
     // NULL its links
     p -> left = p -> right = NULL;
-    // increase allocation count for new node
-    AllocationCount ++;
+    // add the new node to the memory account
+    MA_Allocated (MA_TREE_NODE, sizeof (TreeNode));
     // give it back to the caller
     return p;
 } //end newTreeNode
@@ -313,8 +310,8 @@ TreeNodePtr deleteTree(TreeNodePtr nodeP) {
         printf("\n\nDeleting node for integer: %d", nodeP->data.integer);
         // free memory for the TreeNode
         free(nodeP);
-        // decrement AllocationCount
-        AllocationCount --;
+        // take the TreeNode off the memory account
+        MA_Released (MA_TREE_NODE, sizeof (TreeNode));
         return NULL;
     }
     return NULL;
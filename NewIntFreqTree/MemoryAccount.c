@@ -0,0 +1,193 @@
+///////////////////////
+//
+// The memory account replaces the plain int AllocationCount that each
+// container bumped after a malloc and dropped after a free.  That int
+// was a data race as soon as two threads used containers, and it only
+// counted calls.  The account keeps, for each MemoryKind:
+//      - Count, the number of allocations that are live,
+//      - Bytes, the bytes those allocations hold, and
+//      - Peak, the most Bytes has been (the high-water mark).
+// All three are C11 atomics updated with relaxed ordering: each is a
+// statistic on its own, nothing else is published through them, so
+// they need to be exact but not ordered with the memory they count.
+//
+// The first allocation recorded registers ReportLeaks with atexit so
+// that anything still live when the program ends is reported.
+//
+///////////////////////
+
+// stdlib provides atexit
+#include <stdlib.h>
+// assert checks the arguments
+#include <assert.h>
+#include <stdbool.h>
+// the counters are atomics so threads can share them
+#include <stdatomic.h>
+// MemoryAccount.h declares the functions and MemoryKind
+#include "MemoryAccount.h"
+
+// the counters for one kind of memory
+typedef struct {
+    atomic_int    Count;
+    atomic_size_t Bytes;
+    atomic_size_t Peak;
+} KindAccount;
+
+// one account per kind, all zero at start up
+static KindAccount Accounts[MA_NUM_KINDS];
+
+// LeakReportRegistered is set once ReportLeaks is registered with atexit
+static atomic_bool LeakReportRegistered;
+
+// the names MA_Report prints for the kinds, in MemoryKind order
+static const char *KindNames[MA_NUM_KINDS] = {
+    "list node", "LLInfo", "StackInfo", "QueueInfo", "TreeNode"
+};
+
+// locally called function declarations follow..
+//
+// RaisePeak makes Peak of Kind at least Bytes
+static void RaisePeak (KindAccount *Account, size_t Bytes);
+
+// ReportLeaks is run at exit and reports allocations still live
+static void ReportLeaks (void);
+
+/////////////
+// MA_Allocated adds one allocation of Bytes to the Kind's account
+// and raises its high-water mark if the live bytes are a new high
+/////////////
+void MA_Allocated (MemoryKind Kind, size_t Bytes)
+{
+    assert (Kind >= 0 && Kind < MA_NUM_KINDS);
+    // register the leak report the first time anything is allocated;
+    // the load keeps the exchange (a write) off every allocation
+    if (!atomic_load_explicit (&LeakReportRegistered, memory_order_relaxed)
+            && !atomic_exchange (&LeakReportRegistered, true))
+        atexit (ReportLeaks);
+    KindAccount *Account = &Accounts[Kind];
+    atomic_fetch_add_explicit (&Account->Count, 1, memory_order_relaxed);
+    size_t Now = atomic_fetch_add_explicit (&Account->Bytes, Bytes, memory_order_relaxed) + Bytes;
+    RaisePeak (Account, Now);
+}
+
+/////////////
+// MA_Released takes one allocation of Bytes off the Kind's account
+/////////////
+void MA_Released (MemoryKind Kind, size_t Bytes)
+{
+    MA_ReleasedMany (Kind, 1, Bytes);
+}
+
+/////////////
+// MA_ReleasedMany takes Count allocations, each of Bytes, off the
+// Kind's account, as when a list gives back all its nodes at once
+/////////////
+void MA_ReleasedMany (MemoryKind Kind, int Count, size_t Bytes)
+{
+    assert (Kind >= 0 && Kind < MA_NUM_KINDS);
+    assert (Count >= 0);
+    KindAccount *Account = &Accounts[Kind];
+    atomic_fetch_sub_explicit (&Account->Count, Count, memory_order_relaxed);
+    atomic_fetch_sub_explicit (&Account->Bytes, (size_t) Count * Bytes, memory_order_relaxed);
+}
+
+/////////////
+// MA_Resized moves the Kind's live bytes from OldBytes to NewBytes
+// for an allocation that was realloc'd; the count does not change
+/////////////
+void MA_Resized (MemoryKind Kind, size_t OldBytes, size_t NewBytes)
+{
+    assert (Kind >= 0 && Kind < MA_NUM_KINDS);
+    KindAccount *Account = &Accounts[Kind];
+    if (NewBytes >= OldBytes) {
+        size_t Grow = NewBytes - OldBytes;
+        size_t Now = atomic_fetch_add_explicit (&Account->Bytes, Grow, memory_order_relaxed) + Grow;
+        RaisePeak (Account, Now);
+    }
+    else
+        atomic_fetch_sub_explicit (&Account->Bytes, OldBytes - NewBytes, memory_order_relaxed);
+}
+
+/////////////
+// MA_AllocationCount returns the number of live allocations of every
+// kind added together.  It is what AllocationCount reads.
+/////////////
+int MA_AllocationCount (void)
+{
+    int Total = 0;
+    for (int Kind = 0; Kind < MA_NUM_KINDS; Kind++)
+        Total += atomic_load_explicit (&Accounts[Kind].Count, memory_order_relaxed);
+    return Total;
+}
+
+/////////////
+// MA_LiveCount returns the number of live allocations of Kind
+/////////////
+int MA_LiveCount (MemoryKind Kind)
+{
+    assert (Kind >= 0 && Kind < MA_NUM_KINDS);
+    return atomic_load_explicit (&Accounts[Kind].Count, memory_order_relaxed);
+}
+
+/////////////
+// MA_LiveBytes returns the bytes held by the live allocations of Kind
+/////////////
+size_t MA_LiveBytes (MemoryKind Kind)
+{
+    assert (Kind >= 0 && Kind < MA_NUM_KINDS);
+    return atomic_load_explicit (&Accounts[Kind].Bytes, memory_order_relaxed);
+}
+
+/////////////
+// MA_PeakBytes returns the high-water mark of the bytes of Kind
+/////////////
+size_t MA_PeakBytes (MemoryKind Kind)
+{
+    assert (Kind >= 0 && Kind < MA_NUM_KINDS);
+    return atomic_load_explicit (&Accounts[Kind].Peak, memory_order_relaxed);
+}
+
+/////////////
+// MA_Report prints a line per kind that has ever been allocated,
+// giving its live allocations, live bytes and high-water mark
+/////////////
+void MA_Report (FILE *Out)
+{
+    assert (Out != NULL);
+    fprintf (Out, "%-10s %8s %12s %12s\n", "kind", "live", "live bytes", "peak bytes");
+    for (int Kind = 0; Kind < MA_NUM_KINDS; Kind++) {
+        if (MA_PeakBytes (Kind) == 0)
+            continue;
+        fprintf (Out, "%-10s %8d %12zu %12zu\n", KindNames[Kind],
+                 MA_LiveCount (Kind), MA_LiveBytes (Kind), MA_PeakBytes (Kind));
+    }
+}
+
+/////////////
+// Local function RaisePeak sets the account's Peak to Bytes when that
+// is higher.  Another thread may raise Peak between the load and the
+// exchange, so the exchange is retried until Peak is at least Bytes.
+/////////////
+void RaisePeak (KindAccount *Account, size_t Bytes)
+{
+    size_t Peak = atomic_load_explicit (&Account->Peak, memory_order_relaxed);
+    while (Bytes > Peak
+           && !atomic_compare_exchange_weak_explicit (&Account->Peak, &Peak, Bytes,
+                                                      memory_order_relaxed, memory_order_relaxed))
+        ;
+}
+
+/////////////
+// Local function ReportLeaks is registered with atexit.  If anything
+// is still allocated when the program ends it says so on stderr and
+// prints the account; a program that freed everything prints nothing.
+/////////////
+void ReportLeaks (void)
+{
+    int Live = MA_AllocationCount ();
+    if (Live == 0)
+        return;
+    fprintf (stderr, "MemoryAccount: %d allocation%s still live at exit\n",
+             Live, Live == 1 ? "" : "s");
+    MA_Report (stderr);
+}
@@ -26,6 +26,7 @@
 #include <stdio.h> // provides the functions for i/o, printf, fopen and fscanf
 #include <string.h> // provides the strcmp and strcpy functions
 #include <stdlib.h> // provides the functions for memory management, malloc and free
+#include "MemoryAccount.h" // counts the TreeNodes allocated and provides AllocationCount
 
 // <<< you need to add comments on what these are and how they
 // <<< are used
@@ -72,12 +73,6 @@ typedef struct {
     TreeNodePtr root;
 } BinaryTree;
 
-// To make sure we are allocating and deallocating dynamic memory,
-// variable AllocationCount is declared within the BinaryTree code.
-// It could be referenced by any other code that does dynamic memory
-// allocation and deallocation if we needed using extern
-int AllocationCount = 0;
-
 // The declarations for all the called functions are here
 // <<< you must add comments on what they are and how they contribute
 // <<< to the problem solution
@@ -195,7 +190,7 @@ TreeNodePtr buildTree   (FILE * in, TreeNodePtr nodeParent)
     if (strcmp(str, "@") == 0) return NULL;
     // else allocate memory dynamically for a new TreeNode and assign the memory pointer to a TreeNodePtr
     TreeNodePtr p = (TreeNodePtr) malloc(sizeof(TreeNode));
-    AllocationCount ++;
+    MA_Allocated (MA_TREE_NODE, sizeof (TreeNode));
     // copy the current char to the newly created TreeNode's data word field
     strcpy(p -> data.word, str);
     // assign the parent node pointer to the nodeParent that was passed into the function
@@ -363,8 +358,8 @@ TreeNodePtr deleteTree(TreeNodePtr nodeP) {
         printf("\n\nDeleting node: %s", nodeP->data.word);
         // free memory for the TreeNode
         free(nodeP);
-        // decrement AllocationCount
-        AllocationCount --;
+        // take the TreeNode off the memory account
+        MA_Released (MA_TREE_NODE, sizeof (TreeNode));
         return NULL;
     }
     return NULL;
@@ -4,6 +4,14 @@
 // The LL functions use UserData
 #include "UserData.h"
 
+// Building with LL_DEQUE defined selects the deque, which keeps the
+// UserData side by side in a ring array instead of one per node.  Its
+// layout is in DequeList.h; every function declared below works the same
+// way with either layout.
+#ifdef LL_DEQUE
+#include "DequeList.h"
+#else
+
 // The Linked List needs the definition of what a Node is. A Node has
 // UserData and linkage information for both "next and "prev"
 // for a doubly linked list).
@@ -26,11 +34,12 @@ typedef struct {
     NodePtr Tail;
     int     NumNodesInList;
     } LLInfo, *LLInfoPtr;
+#endif // LL_DEQUE
 
 // Verifying allocation / deallocation of dynamic memory is done through
-// AllocationCount.  The variable is declared in LinkedList.c and is linked to
-// through the extern
-extern int AllocationCount;
+// the memory account, which keeps the list nodes and LLInfo blocks apart
+// and still provides AllocationCount for reading
+#include "MemoryAccount.h"
 
 // ShouldDelete is an enum that has two valid values called DELETE_NODE
 // and RETAIN_NODE that are used in calling to get user data from the front
@@ -62,4 +71,55 @@ UserData        LL_GetAtIndex   (LLInfoPtr, int FetchIndex);
 void            LL_SetAtIndex   (LLInfoPtr LLI_Ptr, UserData D, int UpdateIndex);
 // LL_Swap swaps the nodes in the underlying LL specified by indices starting at 0
 void            LL_Swap         (LLInfoPtr LLI_Ptr, int Index1, int Index2);
+
+// The functions below hand out the address of user data inside the LL rather than
+// a copy, so a large UserData is not copied.  An address is good until the user
+// data it points to is deleted or, with the deque layout, until anything is added
+// to or erased from the LL (which may move it).
+
+// LL_PeekFrontPtr returns the address of the user data at the Head of the underlying LL
+UserData       *LL_PeekFrontPtr (LLInfoPtr LLI_Ptr);
+// LL_AtIndexPtr returns the address of the user data at the specified index starting at 0
+UserData       *LL_AtIndexPtr   (LLInfoPtr LLI_Ptr, int FetchIndex);
+// LL_EmplaceFront adds a node at the Head and returns the address of its user data for
+// the caller to fill in
+UserData       *LL_EmplaceFront (LLInfoPtr LLI_Ptr);
+// LL_EmplaceEnd adds a node at the Tail and returns the address of its user data for
+// the caller to fill in
+UserData       *LL_EmplaceEnd   (LLInfoPtr LLI_Ptr);
+
+// LLVisitor is any function that, when called by LL_ForEach, receives the
+// address of a node's user data (which it may update) and the caller's Context
+typedef void (*LLVisitor) (UserData *Data, void *Context);
+
+// LL_ForEach calls Visit once for every node, from the Head to the Tail
+void            LL_ForEach      (LLInfoPtr LLI_Ptr, LLVisitor Visit, void *Context);
+
+// A cursor marks one node in the underlying LL so that the LL can be walked and
+// changed at that node without counting from the Head.  LL_End is the position
+// just past the Tail (a NULL node).  With the deque a cursor is the index of the
+// user data and LL_End is LL_Length.
+#ifdef LL_DEQUE
+typedef int LLCursor;
+#else
+typedef NodePtr LLCursor;
+#endif
+
+// LL_Begin returns a cursor at the Head (LL_End if the LL is empty)
+LLCursor        LL_Begin        (LLInfoPtr LLI_Ptr);
+// LL_End returns the cursor just past the Tail
+LLCursor        LL_End          (LLInfoPtr LLI_Ptr);
+// LL_Next returns the cursor at the node after Cursor
+LLCursor        LL_Next         (LLInfoPtr LLI_Ptr, LLCursor Cursor);
+// LL_Prev returns the cursor at the node before Cursor (the Tail when Cursor is LL_End)
+LLCursor        LL_Prev         (LLInfoPtr LLI_Ptr, LLCursor Cursor);
+// LL_GetAtCursor returns the user data at Cursor
+UserData        LL_GetAtCursor  (LLInfoPtr LLI_Ptr, LLCursor Cursor);
+// LL_SetAtCursor updates the user data at Cursor
+void            LL_SetAtCursor  (LLInfoPtr LLI_Ptr, LLCursor Cursor, UserData D);
+// LL_InsertBefore adds user data just before Cursor (at the Tail when Cursor is LL_End)
+// and returns the cursor at the new node
+LLCursor        LL_InsertBefore (LLInfoPtr LLI_Ptr, LLCursor Cursor, UserData theData);
+// LL_Erase deletes the node at Cursor and returns the cursor at the node that followed it
+LLCursor        LL_Erase        (LLInfoPtr LLI_Ptr, LLCursor Cursor);
 #endif // LINKEDLIST_H_INCLUDED
@@ -35,7 +35,7 @@ Queue initQueue(UserComparison UserOrder)
     // allocate a queue structure and abort if the allocation failed
     Queue Q = (Queue) malloc(sizeof(QueueInfo));
     assert (Q!= NULL);
-    AllocationCount++;
+    MA_Allocated (MA_QUEUE_INFO, sizeof (QueueInfo));
     // allocate and initialize the underlying linked list
     Q->LL = LL_Init();
     // we are empty until an item is pushed
@@ -56,7 +56,7 @@ Queue deleteQueue(Queue Q)
     assert (Q != NULL);
     LL_Delete(Q->LL);
     free (Q);
-    AllocationCount--;
+    MA_Released (MA_QUEUE_INFO, sizeof (QueueInfo));
     return NULL;
 }
 
@@ -69,43 +69,44 @@ bool empty (Queue Q)
     return Q->empty;
 }
 
-// AdjustQueue is a bubble sort that sorts by priority
+// AdjustQueue puts the UserData just enqueued in priority order
 // if the user provided a priority comparison
 // support routine. If one is not provided, the
 // function will leave the queue in the order
 // that enqueue calls have been made.  That makes it
 // operate as a simple queue.
+// Every earlier enqueue left the queue in priority order, so only
+// the new UserData at the Tail can be out of place.  A cursor walks
+// back from the Tail for as long as the user's comparison ranks the new
+// UserData ahead of the one before it and not the other way round, and
+// the new UserData is moved there.  A comparison that returns true for
+// equal priorities, such as one using <=, ranks each of two equal
+// UserData ahead of the other, so the walk stops at a tie: UserData of
+// equal priority are dequeued in the order they were enqueued, whether
+// the comparison is strict or not.  The UserData already queued are
+// never reordered among themselves, and it takes a single walk of the
+// list instead of passes of a bubble sort made of index lookups.
 void AdjustQueue (Queue Q)
 {
     assert (Q != NULL);
-    int Qsize = LL_Length(Q->LL);
     // we are done if there is no priority function
     // or there are 0 or 1 items in the queue
-    if ((Q->Priority == NULL) || (Qsize < 2)) return;
-    int i,j;
-    // swapped false means that nothing has been
-    // swapped, so the bubble sort can exit on sensing
-    // it
-    bool swapped;
-
-    // loop through all UserData
-    for(i = 0; i < Qsize-1; i++) {
-        // swapped is the exit condition
-        swapped = false;
-        // loop through numbers falling ahead
-        for(j = 0; j < Qsize-1-i; j++) {
-            // check if UserData[j+1] is of higher priority than UserData[j]
-            if (Q->Priority(LL_GetAtIndex(Q->LL, j+1), LL_GetAtIndex(Q->LL, j))) {
-                // yes, so swap and flag that swapping is being done
-                LL_Swap(Q->LL, j, j+1);
-                swapped = true;
-            }
-        }
-        // if nothing was swapped that means
-        // queue is sorted now, so we are done.
-        if(!swapped) {
+    if ((Q->Priority == NULL) || (LL_Length(Q->LL) < 2)) return;
+    LLCursor Tail = LL_Prev(Q->LL, LL_End(Q->LL));
+    UserData D = LL_GetAtCursor(Q->LL, Tail);
+    // walk back while the new UserData is of higher priority than the
+    // one before, stopping at one of equal priority
+    LLCursor Place = Tail;
+    while (Place != LL_Begin(Q->LL)) {
+        UserData Before = LL_GetAtCursor(Q->LL, LL_Prev(Q->LL, Place));
+        if (!Q->Priority(D, Before) || Q->Priority(Before, D))
             break;
-        }
+        Place = LL_Prev(Q->LL, Place);
+    }
+    // move the new UserData there, unless it is already in place
+    if (Place != Tail) {
+        LL_Erase(Q->LL, Tail);
+        LL_InsertBefore(Q->LL, Place, D);
     }
 }
 
@@ -143,3 +144,13 @@ UserData    peek (Queue Q)
     assert ( (Q != NULL) && (Q->empty != true) );
     return LL_GetFront(Q->LL, RETAIN_NODE);
 }
+
+/*
+   peekPtr() returns the address of the UserData at the front of the queue
+   without copying it, by calling the linked list LL_PeekFrontPtr()
+*/
+UserData   *peekPtr (Queue Q)
+{
+    assert ( (Q != NULL) && (Q->empty != true) );
+    return LL_PeekFrontPtr(Q->LL);
+}
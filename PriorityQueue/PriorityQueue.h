@@ -44,6 +44,11 @@ UserData    dequeue (Queue Q);
 // peek() returns the UserData on the top of the queue but will not
 // delete it from the queue
 UserData    peek (Queue Q);
+// peekPtr() returns the address of the UserData on the top of the queue instead
+// of a copy, so a large UserData is not copied just to be looked at.  The address
+// is good until that UserData is dequeued or, with the deque layout, anything else
+// is enqueued
+UserData   *peekPtr (Queue Q);
 // deleteQueue() deletes the frees the storage that was allocated by the call
 // to initQueue()
 Queue deleteQueue(Queue Q);
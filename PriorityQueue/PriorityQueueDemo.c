@@ -40,10 +40,9 @@ static bool          HighestNumIsHighestPriority (UserData first, UserData secon
 
 /*
  * Verifying allocation / deallocation of dynamic memory is done through
- * AllocationCount.  The variable is declared in LinkedList.c and is linked to
- * through the extern
+ * AllocationCount.  It is read from the memory account, which the queue
+ * includes through LinkedList.h
 */
-extern int AllocationCount;
 
 /*
  * This function is used by Runtest() to generate UserData to fill a queue
@@ -224,5 +223,7 @@ int main()
     deleteQueue (Q);
     printf ("After deleteQueue, remaining allocations is %d \n", AllocationCount);
 
+    // show how much memory the queues needed at their largest
+    MA_Report (stdout);
     return 0;
 }
@@ -0,0 +1,216 @@
+//
+//  BlockingQueue.c
+//
+//  Every call takes Lock for its whole length.  The waiting calls loop on
+//  pthread_cond_timedwait(), since a condition variable can wake a thread
+//  that another thread then beats to the UserData or the room, until what
+//  they wait for is there, the queue is closed or the deadline has passed.
+//  The deadline is worked out once, on the monotonic clock, so a wait that
+//  is woken early and goes back to sleep does not start its timeout again,
+//  and changing the system time does not stretch or cut it.
+//
+//  A producer signals NotEmpty to wake one consumer for the one UserData
+//  it added.  A consumer of a queue with a high watermark signals NotFull
+//  for the room it made; a batch can make room for many producers, so it
+//  broadcasts.  Signalling with no thread waiting costs no system call.
+//
+
+// stdlib provides malloc and free
+#include <stdlib.h>
+// time provides clock_gettime and struct timespec for the deadlines
+#include <time.h>
+// errno provides ETIMEDOUT
+#include <errno.h>
+// asserts are used for checking the arguments
+#include <assert.h>
+// the calls the queue supports are included for consistency checking
+#include "BlockingQueue.h"
+
+// locally called function declarations follow..
+//
+// Deadline returns the monotonic clock time TimeoutMs milliseconds from now
+static struct timespec Deadline (long TimeoutMs);
+
+// Wait waits on Condition until it is signalled, returning false if the
+// deadline passes first or TimeoutMs is 0
+static bool Wait (BlockingQueue BQ, pthread_cond_t *Condition, long TimeoutMs, const struct timespec *Until);
+
+// WaitForUserData waits until the queue holds a UserData, returning false
+// if the time runs out or the queue is closed and empty
+static bool WaitForUserData (BlockingQueue BQ, long TimeoutMs);
+
+/*
+ BQ_Init() allocates the blocking queue and the queue it wraps, and sets
+ the condition variables up to time their waits on the monotonic clock
+*/
+BlockingQueue BQ_Init (int HighWatermark)
+{
+    assert (HighWatermark >= 0);
+    BlockingQueue BQ = (BlockingQueue) malloc (sizeof (BlockingQueueInfo));
+    assert (BQ != NULL);
+    MA_Allocated (MA_QUEUE_INFO, sizeof (BlockingQueueInfo));
+    BQ->Q = initQueueWithCapacity (HighWatermark);
+    BQ->Count = 0;
+    BQ->HighWatermark = HighWatermark;
+    BQ->Closed = false;
+    pthread_mutex_init (&BQ->Lock, NULL);
+    pthread_condattr_t Attributes;
+    pthread_condattr_init (&Attributes);
+    pthread_condattr_setclock (&Attributes, CLOCK_MONOTONIC);
+    pthread_cond_init (&BQ->NotEmpty, &Attributes);
+    pthread_cond_init (&BQ->NotFull, &Attributes);
+    pthread_condattr_destroy (&Attributes);
+    return BQ;
+}
+
+/*
+ BQ_Delete() frees the queue it wraps, with anything left in it, and then
+ itself.  No thread may still be using it.  It returns NULL
+*/
+BlockingQueue BQ_Delete (BlockingQueue BQ)
+{
+    assert (BQ != NULL);
+    BQ->Q = deleteQueue (BQ->Q);
+    pthread_cond_destroy (&BQ->NotFull);
+    pthread_cond_destroy (&BQ->NotEmpty);
+    pthread_mutex_destroy (&BQ->Lock);
+    free (BQ);
+    MA_Released (MA_QUEUE_INFO, sizeof (BlockingQueueInfo));
+    return NULL;
+}
+
+/*
+ BQ_Enqueue() waits while the queue is at its high watermark, then adds D
+ and wakes a consumer
+*/
+bool BQ_Enqueue (BlockingQueue BQ, UserData D, long TimeoutMs)
+{
+    assert (BQ != NULL);
+    struct timespec Until = Deadline (TimeoutMs);
+    pthread_mutex_lock (&BQ->Lock);
+    while (!BQ->Closed && BQ->HighWatermark > 0 && BQ->Count >= BQ->HighWatermark)
+        if (!Wait (BQ, &BQ->NotFull, TimeoutMs, &Until))
+            break;
+    bool Added = !BQ->Closed && (BQ->HighWatermark == 0 || BQ->Count < BQ->HighWatermark);
+    if (Added) {
+        enqueue (BQ->Q, D);
+        BQ->Count++;
+        pthread_cond_signal (&BQ->NotEmpty);
+    }
+    pthread_mutex_unlock (&BQ->Lock);
+    return Added;
+}
+
+/*
+ BQ_DequeueWait() waits for a UserData and takes it, waking a producer that
+ may be waiting for the room
+*/
+bool BQ_DequeueWait (BlockingQueue BQ, UserData *D, long TimeoutMs)
+{
+    assert ( (BQ != NULL) && (D != NULL) );
+    pthread_mutex_lock (&BQ->Lock);
+    bool Got = WaitForUserData (BQ, TimeoutMs);
+    if (Got) {
+        *D = dequeue (BQ->Q);
+        BQ->Count--;
+        if (BQ->HighWatermark > 0)
+            pthread_cond_signal (&BQ->NotFull);
+    }
+    pthread_mutex_unlock (&BQ->Lock);
+    return Got;
+}
+
+/*
+ BQ_DequeueBatch() waits for a UserData and then takes as many as there
+ are, up to MaxItems, before it lets go of the lock.  Every producer
+ waiting may now have room, so all are woken
+*/
+int BQ_DequeueBatch (BlockingQueue BQ, UserData *Items, int MaxItems, long TimeoutMs)
+{
+    assert ( (BQ != NULL) && (Items != NULL) && (MaxItems > 0) );
+    pthread_mutex_lock (&BQ->Lock);
+    int Taken = 0;
+    if (WaitForUserData (BQ, TimeoutMs)) {
+        while (Taken < MaxItems && BQ->Count > 0) {
+            Items[Taken++] = dequeue (BQ->Q);
+            BQ->Count--;
+        }
+        if (BQ->HighWatermark > 0)
+            pthread_cond_broadcast (&BQ->NotFull);
+    }
+    pthread_mutex_unlock (&BQ->Lock);
+    return Taken;
+}
+
+/*
+ BQ_Close() marks the queue closed and wakes every thread waiting on it,
+ so producers give up and consumers see whether anything is left
+*/
+void BQ_Close (BlockingQueue BQ)
+{
+    assert (BQ != NULL);
+    pthread_mutex_lock (&BQ->Lock);
+    BQ->Closed = true;
+    pthread_cond_broadcast (&BQ->NotEmpty);
+    pthread_cond_broadcast (&BQ->NotFull);
+    pthread_mutex_unlock (&BQ->Lock);
+}
+
+/*
+ BQ_Length() reads the count under the lock
+*/
+int BQ_Length (BlockingQueue BQ)
+{
+    assert (BQ != NULL);
+    pthread_mutex_lock (&BQ->Lock);
+    int Count = BQ->Count;
+    pthread_mutex_unlock (&BQ->Lock);
+    return Count;
+}
+
+/*
+ Deadline adds TimeoutMs to the monotonic clock.  A timeout that does not
+ wait, or waits forever, has no deadline to work out
+*/
+struct timespec Deadline (long TimeoutMs)
+{
+    struct timespec Until = {0, 0};
+    if (TimeoutMs > 0) {
+        clock_gettime (CLOCK_MONOTONIC, &Until);
+        Until.tv_sec += TimeoutMs / 1000;
+        Until.tv_nsec += (TimeoutMs % 1000) * 1000000L;
+        if (Until.tv_nsec >= 1000000000L) {
+            Until.tv_sec++;
+            Until.tv_nsec -= 1000000000L;
+        }
+    }
+    return Until;
+}
+
+/*
+ Wait sleeps on Condition, letting go of Lock while it does.  It returns
+ false straight away for a timeout of 0, and once the deadline has passed
+*/
+bool Wait (BlockingQueue BQ, pthread_cond_t *Condition, long TimeoutMs, const struct timespec *Until)
+{
+    if (TimeoutMs == 0)
+        return false;
+    if (TimeoutMs < 0) {
+        pthread_cond_wait (Condition, &BQ->Lock);
+        return true;
+    }
+    return pthread_cond_timedwait (Condition, &BQ->Lock, Until) != ETIMEDOUT;
+}
+
+/*
+ WaitForUserData waits on NotEmpty, with Lock held, until there is a
+ UserData, the queue is closed or the time runs out
+*/
+bool WaitForUserData (BlockingQueue BQ, long TimeoutMs)
+{
+    struct timespec Until = Deadline (TimeoutMs);
+    while (BQ->Count == 0 && !BQ->Closed)
+        if (!Wait (BQ, &BQ->NotEmpty, TimeoutMs, &Until))
+            break;
+    return BQ->Count > 0;
+}
@@ -0,0 +1,83 @@
+//
+//  BlockingQueue.h
+//
+
+#ifndef BlockingQueue_h
+#define BlockingQueue_h
+
+// BlockingQueue.h declares a queue for threads that wait on each other
+// instead of polling.  It is a Queue from Queue.h, of whichever layout the
+// build picked, with a mutex around every call and two condition variables:
+//      - a consumer that finds the queue empty sleeps until a producer adds
+//        a UserData or its timeout runs out, using no CPU in the meantime
+//      - a consumer can take up to a whole batch of UserData for one lock
+//        and unlock, instead of one lock and unlock for each
+//      - a producer that finds the queue at its high watermark sleeps until
+//        a consumer has made room, so a slow consumer slows its producers
+//        down rather than letting the queue grow without limit
+// Once a queue is closed producers can add nothing more, and consumers
+// take what is left and are then told it is empty instead of waiting.
+//
+//      BlockingQueue Q = BQ_Init (1000);           // before the threads
+//      ...
+//      BQ_Enqueue (Q, D, BQ_WAIT_FOREVER);         // in producers
+//      if (BQ_DequeueWait (Q, &D, 100)) ...        // in consumers
+//      n = BQ_DequeueBatch (Q, Items, 64, 100);
+//      ...
+//      BQ_Close (Q);                               // when the producers stop
+//      ...
+//      Q = BQ_Delete (Q);                          // after the threads
+
+// The calls on a queue need to pass or return UserData
+#include "UserData.h"
+// The queue the blocking queue wraps
+#include "Queue.h"
+// The mutex and the condition variables are pthread ones
+#include <pthread.h>
+// The waiting calls return a boolean
+#include <stdbool.h>
+
+// BQ_WAIT_FOREVER, given as a timeout, waits with no time limit.  A
+// timeout of 0 does not wait at all
+#define BQ_WAIT_FOREVER (-1L)
+
+// This is the layout of a blocking queue.  Q holds the UserData and Count
+// says how many, since the queue itself does not keep a count.  Lock guards
+// all of them; consumers wait on NotEmpty and producers on NotFull.
+// HighWatermark is the count at which producers wait, or 0 for no limit.
+
+typedef struct {
+    Queue           Q;
+    int             Count;
+    int             HighWatermark;
+    bool            Closed;
+    pthread_mutex_t Lock;
+    pthread_cond_t  NotEmpty;
+    pthread_cond_t  NotFull;
+} BlockingQueueInfo, *BlockingQueue;
+
+// BQ_Init() allocates an empty queue whose producers wait once it holds
+// HighWatermark UserData, or never wait if HighWatermark is 0
+BlockingQueue   BQ_Init          (int HighWatermark);
+// BQ_Delete() frees the queue and any UserData left in it.  It returns NULL
+BlockingQueue   BQ_Delete        (BlockingQueue BQ);
+// BQ_Enqueue() adds D at the end of the queue, first waiting up to
+// TimeoutMs milliseconds while it is at its high watermark.  It returns
+// false, without adding D, if the time ran out or the queue is closed
+bool            BQ_Enqueue       (BlockingQueue BQ, UserData D, long TimeoutMs);
+// BQ_DequeueWait() takes the UserData at the front of the queue into D,
+// first waiting up to TimeoutMs milliseconds while it is empty.  It returns
+// false if the time ran out, or the queue is closed and empty
+bool            BQ_DequeueWait   (BlockingQueue BQ, UserData *D, long TimeoutMs);
+// BQ_DequeueBatch() waits the same way as BQ_DequeueWait() and then takes
+// up to MaxItems UserData into Items, in order, all under one lock.  It
+// returns how many it took, which is 0 if it would have returned false
+int             BQ_DequeueBatch  (BlockingQueue BQ, UserData *Items, int MaxItems, long TimeoutMs);
+// BQ_Close() stops any more UserData being added and wakes every waiting
+// thread
+void            BQ_Close         (BlockingQueue BQ);
+// BQ_Length() returns how many UserData the queue holds.  Other threads
+// may change that as soon as it is read
+int             BQ_Length        (BlockingQueue BQ);
+
+#endif /* BlockingQueue_h */
@@ -0,0 +1,177 @@
+//
+//  BlockingQueueTester
+//
+//  This tests the blocking queue.  It checks that:
+//      On one thread a wait on an empty queue, or a full one, gives up
+//          after its timeout, and using almost no CPU while it waits - uses
+//          calls to BQ_DequeueWait() and BQ_Enqueue()
+//      A batch comes out in order and a closed queue gives up straight
+//          away - uses calls to BQ_DequeueBatch() and BQ_Close()
+//      Producers sending their own numbers to consumers, some taking one at
+//          a time and some in batches, get every number through exactly
+//          once without the queue ever going over its high watermark
+//      Nothing is left allocated when the queues are deleted
+//  A wait that returns early or late, a batch out of order, a number
+//  lost or doubled and a queue found over its watermark all count as
+//  errors, and so does memory still allocated at the end; the exit
+//  status says whether there were any.
+
+// printf support
+#include <stdio.h>
+// the producers and consumers are pthreads
+#include <pthread.h>
+// time provides clock_gettime for the wall clock and clock for the CPU used
+#include <time.h>
+// we use the blocking queue, so include its functions that we can call
+#include "BlockingQueue.h"
+
+// The threads, the numbers each producer sends, the high watermark the
+// threads use and the biggest batch
+#define NUM_PRODUCERS  3
+#define NUM_CONSUMERS  4
+#define PER_PRODUCER   200000
+#define NUM_NUMBERS    (NUM_PRODUCERS * PER_PRODUCER)
+#define WATERMARK      32
+#define MAX_BATCH      16
+
+// The queue the threads share, the numbers taken and the mismatches found
+static BlockingQueue   TheQueue;
+static char            Taken[NUM_NUMBERS];
+static pthread_mutex_t TakenLock = PTHREAD_MUTEX_INITIALIZER;
+static int             Errors;
+
+// Producer sends its numbers, waiting for room whenever it has to
+static void *Producer (void *Arg);
+
+// Consumer takes numbers until the queue is closed and empty
+static void *Consumer (void *Arg);
+
+// CountTaken marks numbers taken, counting an error for any taken before
+static void CountTaken (const UserData *Items, int NumItems);
+
+// TimeWait returns the wall clock milliseconds a dequeue from an empty
+// queue took with TimeoutMs, putting the CPU milliseconds used in *CPUMs
+static double TimeWait (BlockingQueue BQ, long TimeoutMs, double *CPUMs);
+
+int main(int argc, const char * argv[]) {
+    // waits on an empty queue give up on time, and sleep while they wait
+    BlockingQueue BQ = BQ_Init (4);
+    UserData D = {0};
+    double CPUMs;
+    double WallMs = TimeWait (BQ, 0, &CPUMs);
+    printf ("Dequeue from empty, no wait: gave up after %.1fms\n", WallMs);
+    Errors += (WallMs > 10);
+    WallMs = TimeWait (BQ, 200, &CPUMs);
+    printf ("Dequeue from empty, 200ms wait: gave up after %.1fms using %.1fms of CPU\n", WallMs, CPUMs);
+    Errors += (WallMs < 200 || CPUMs > 20);
+
+    // the high watermark stops a fifth enqueue, then a batch takes all four
+    for (int loop = 0; loop < 4; loop++) {
+        D.taskNumber = loop;
+        Errors += !BQ_Enqueue (BQ, D, 0);
+    }
+    Errors += BQ_Enqueue (BQ, D, 0) || BQ_Enqueue (BQ, D, 50) || BQ_Length (BQ) != 4;
+    UserData Batch[MAX_BATCH];
+    int NumBatch = BQ_DequeueBatch (BQ, Batch, MAX_BATCH, BQ_WAIT_FOREVER);
+    Errors += (NumBatch != 4);
+    for (int loop = 0; loop < NumBatch; loop++)
+        Errors += (Batch[loop].taskNumber != loop);
+
+    // once closed, nothing more goes in and the last UserData come out
+    Errors += !BQ_Enqueue (BQ, D, 0);
+    BQ_Close (BQ);
+    Errors += BQ_Enqueue (BQ, D, BQ_WAIT_FOREVER);
+    Errors += !BQ_DequeueWait (BQ, &D, BQ_WAIT_FOREVER) || BQ_DequeueWait (BQ, &D, BQ_WAIT_FOREVER);
+    BQ = BQ_Delete (BQ);
+    printf ("One thread: %d errors\n", Errors);
+
+    // producers and consumers through a queue with a small watermark
+    pthread_t Producers[NUM_PRODUCERS], Consumers[NUM_CONSUMERS];
+    int Ids[NUM_PRODUCERS + NUM_CONSUMERS];
+    printf ("%d threads send %d numbers through a queue of at most %d to %d threads\n",
+            NUM_PRODUCERS, NUM_NUMBERS, WATERMARK, NUM_CONSUMERS);
+    TheQueue = BQ_Init (WATERMARK);
+    for (int loop = 0; loop < NUM_PRODUCERS + NUM_CONSUMERS; loop++) {
+        Ids[loop] = loop;
+        if (loop < NUM_PRODUCERS)
+            pthread_create (&Producers[loop], NULL, Producer, &Ids[loop]);
+        else
+            pthread_create (&Consumers[loop - NUM_PRODUCERS], NULL, Consumer, &Ids[loop]);
+    }
+    for (int loop = 0; loop < NUM_PRODUCERS; loop++)
+        pthread_join (Producers[loop], NULL);
+    BQ_Close (TheQueue);
+    for (int loop = 0; loop < NUM_CONSUMERS; loop++)
+        pthread_join (Consumers[loop], NULL);
+    TheQueue = BQ_Delete (TheQueue);
+    int NeverTaken = 0;
+    for (int loop = 0; loop < NUM_NUMBERS; loop++)
+        NeverTaken += (Taken[loop] == 0);
+    printf ("Numbers never taken: %d\n", NeverTaken);
+    Errors += (NeverTaken != 0);
+
+    printf ("Errors: %d, the allocation count is now %d\n", Errors, AllocationCount);
+    return (Errors == 0 && AllocationCount == 0) ? 0 : 1;
+}
+
+// function Producer sends the numbers from its Id * PER_PRODUCER up,
+// checking after each that the queue is not over its watermark
+void *Producer (void *Arg)
+{
+    int First = *(int *) Arg * PER_PRODUCER;
+    for (int loop = 0; loop < PER_PRODUCER; loop++) {
+        UserData D = {First + loop};
+        int Over = !BQ_Enqueue (TheQueue, D, BQ_WAIT_FOREVER) || BQ_Length (TheQueue) > WATERMARK;
+        if (Over) {
+            pthread_mutex_lock (&TakenLock);
+            Errors++;
+            pthread_mutex_unlock (&TakenLock);
+        }
+    }
+    return NULL;
+}
+
+// function Consumer takes numbers one at a time if its Id is even and in
+// batches if it is odd, until the queue is closed and empty
+void *Consumer (void *Arg)
+{
+    bool Batches = (*(int *) Arg % 2 != 0);
+    UserData Items[MAX_BATCH];
+    for (;;) {
+        int NumItems;
+        if (Batches)
+            NumItems = BQ_DequeueBatch (TheQueue, Items, MAX_BATCH, BQ_WAIT_FOREVER);
+        else
+            NumItems = BQ_DequeueWait (TheQueue, &Items[0], BQ_WAIT_FOREVER);
+        if (NumItems == 0)
+            return NULL;
+        CountTaken (Items, NumItems);
+    }
+}
+
+// function CountTaken marks each number taken
+void CountTaken (const UserData *Items, int NumItems)
+{
+    pthread_mutex_lock (&TakenLock);
+    for (int loop = 0; loop < NumItems; loop++) {
+        int Number = Items[loop].taskNumber;
+        if (Number < 0 || Number >= NUM_NUMBERS || Taken[Number]++ != 0)
+            Errors++;
+    }
+    pthread_mutex_unlock (&TakenLock);
+}
+
+// function TimeWait times one dequeue from an empty queue by the wall
+// clock and by the CPU the program used
+double TimeWait (BlockingQueue BQ, long TimeoutMs, double *CPUMs)
+{
+    UserData D;
+    struct timespec Start, End;
+    clock_t CPUStart = clock();
+    clock_gettime (CLOCK_MONOTONIC, &Start);
+    if (BQ_DequeueWait (BQ, &D, TimeoutMs))
+        Errors++;
+    clock_gettime (CLOCK_MONOTONIC, &End);
+    *CPUMs = (double) (clock() - CPUStart) * 1000 / CLOCKS_PER_SEC;
+    return (End.tv_sec - Start.tv_sec) * 1e3 + (End.tv_nsec - Start.tv_nsec) / 1e6;
+}
@@ -0,0 +1,268 @@
+///////////////////////
+//
+// This deque code provides exactly the same functions as
+// DoubleLinkedList.c, declared in LinkedList.h, and is used in its
+// place when the list is built with LL_DEQUE defined.
+//
+// WHY?... The stack, queue and priority queue only ever add and remove
+// at the ends of their list (plus some index access), yet with nodes
+// every UserData pays for a malloc and two pointers, and a walk jumps
+// around memory from node to node.  The deque keeps the UserData side
+// by side in one array used as a ring:
+//
+//      - Adding at the end writes just past the last UserData, adding
+//        at the front writes just before the first one (wrapping round
+//        to the end of the array) and moves Front back, so neither
+//        moves any UserData already there.
+//      - Getting from the front reads Data[Front] and moves Front on.
+//      - The UserData at any index is Data[(Front + index) % Capacity],
+//        so LL_GetAtIndex and LL_SetAtIndex need no walk at all.
+//      - Only when the ring is full is a bigger array allocated; the
+//        UserData are copied over once and the old array is freed.
+//
+// Capacity is always a power of 2, so "% Capacity" is done with a mask.
+//
+///////////////////////
+
+// stdlib provides the definition of NULL and the declarations for
+// malloc() and free()
+#include <stdlib.h>
+// assert is used to check the calls are valid
+#include <assert.h>
+// The list needs UserData to know what the ring holds
+#include "UserData.h"
+// LinkedList.h declares the functions callable for a linked list and,
+// with LL_DEQUE defined, pulls in the ring layout from DequeList.h
+#include "LinkedList.h"
+
+// locally called function declarations follow..
+//
+// Slot returns the position in the ring array of the UserData at an index
+static int Slot (LLInfoPtr LLI_Ptr, int Index);
+
+// MakeRoom doubles the ring array when it is full
+static void MakeRoom (LLInfoPtr LLI_Ptr);
+
+// Externally callable functions for a user of the Linked List
+// follow
+
+/////////////
+// LL_Init is used to allocate and initialize a LinkedList
+// Information structure.  The ring array is not allocated until the
+// first UserData is added.  It will update the memory account to
+// reflect the malloc of the struct and return the pointer to the
+// struct for the caller to use when calling any other function in the
+// linked list
+/////////////
+LLInfoPtr LL_Init()
+{
+    // Allocate a Linked List Information structure
+    LLInfoPtr LLI_Ptr = (LLInfoPtr) malloc (sizeof (LLInfo));
+    assert (LLI_Ptr != NULL);
+    // Initialize the data in the struct just allocated
+    LLI_Ptr->Data = NULL;
+    LLI_Ptr->Capacity = 0;
+    LLI_Ptr->Front = 0;
+    LLI_Ptr->NumNodesInList = 0;
+    // update the memory account to reflect the malloc
+    MA_Allocated (MA_LL_INFO, sizeof (LLInfo));
+    // return the pointer to the allocated struct to the caller
+    return LLI_Ptr;
+}
+
+/////////////
+// LL_Delete is called to delete the Linked List identified by LL_Ptr.
+// All the UserData are in the one array, so it is freed with a single
+// call, then the LinkedList information struct is freed and the
+// memory account updated to reflect the memory release.  The ring
+// array is counted as a list node allocation.
+/////////////
+LLInfoPtr LL_Delete(LLInfoPtr LLI_Ptr)
+{
+    // We should not have been called if the Linked List
+    // Information structure does not exist
+    assert (LLI_Ptr != NULL);
+    if (LLI_Ptr->Data != NULL) {
+        free (LLI_Ptr->Data);
+        MA_Released (MA_LIST_NODE, LLI_Ptr->Capacity * sizeof (UserData));
+    }
+    free(LLI_Ptr);
+    LLI_Ptr = NULL;
+    MA_Released (MA_LL_INFO, sizeof (LLInfo));
+    // return a NULL because the list structure no longer exists
+    return NULL;
+}
+
+/////////////
+// LL_AddAtFront is called to add the UserData to the front of the list.
+// Front moves back one place, wrapping round to the end of the array,
+// and the UserData goes there.
+/////////////
+void LL_AddAtFront (LLInfoPtr LLI_Ptr, UserData theData)
+{
+    *LL_EmplaceFront (LLI_Ptr) = theData;
+}
+
+/////////////
+// LL_EmplaceFront makes room for a UserData at the front of the list,
+// just as LL_AddAtFront does, and returns its address for the caller
+// to fill in place.
+/////////////
+UserData *LL_EmplaceFront (LLInfoPtr LLI_Ptr)
+{
+    // We should not have been called if the Linked List
+    // Information structure does not exist
+    assert (LLI_Ptr != NULL);
+    MakeRoom (LLI_Ptr);
+    LLI_Ptr->Front = (LLI_Ptr->Front - 1) & (LLI_Ptr->Capacity - 1);
+    LLI_Ptr->NumNodesInList++;
+    return &LLI_Ptr->Data[LLI_Ptr->Front];
+}
+
+/////////////
+// LL_AddAtEnd is called to add the UserData to the end of the list,
+// in the place just after the last UserData
+/////////////
+void LL_AddAtEnd (LLInfoPtr LLI_Ptr, UserData theData)
+{
+    *LL_EmplaceEnd (LLI_Ptr) = theData;
+}
+
+/////////////
+// LL_EmplaceEnd makes room for a UserData at the end of the list, just
+// as LL_AddAtEnd does, and returns its address for the caller to fill in.
+/////////////
+UserData *LL_EmplaceEnd (LLInfoPtr LLI_Ptr)
+{
+    // We should not have been called if the Linked List
+    // Information structure does not exist
+    assert (LLI_Ptr != NULL);
+    MakeRoom (LLI_Ptr);
+    LLI_Ptr->NumNodesInList++;
+    return &LLI_Ptr->Data[Slot (LLI_Ptr, LLI_Ptr->NumNodesInList - 1)];
+}
+
+/////////////
+// LL_GetFront returns the UserData at the front of the list and, when
+// asked to delete it, moves Front on past it.  The array is kept for
+// the UserData that will be added later.
+/////////////
+UserData LL_GetFront (LLInfoPtr LLI_Ptr, ShouldDelete Choice)
+{
+    // We should not have been called if the Linked List
+    // Information structure does not exist or if the list is empty
+    assert (LLI_Ptr != NULL);
+    assert (LLI_Ptr->NumNodesInList > 0);
+    assert ((Choice == DELETE_NODE) || (Choice == RETAIN_NODE));
+    UserData theData = LLI_Ptr->Data[LLI_Ptr->Front];
+    if (Choice == DELETE_NODE) {
+        LLI_Ptr->Front = (LLI_Ptr->Front + 1) & (LLI_Ptr->Capacity - 1);
+        LLI_Ptr->NumNodesInList--;
+    }
+    return theData;
+}
+
+/////////////
+// LL_Length returns the number of UserData in the underlying LL.
+// It allows calls to be made even if the underlying LL does not
+// exist, returning a count of zero under this condition
+/////////////
+int  LL_Length  (LLInfoPtr LLI_Ptr)
+{
+    return (LLI_Ptr == NULL) ? 0 : LLI_Ptr->NumNodesInList;
+}
+
+/////////////
+// LL_GetAtIndex returns the user data at the specified index
+// in the underlying LL, straight from its place in the ring
+/////////////
+UserData  LL_GetAtIndex (LLInfoPtr LLI_Ptr, int FetchIndex)
+{
+    assert (LLI_Ptr != NULL);
+    assert ((FetchIndex >= 0) && (FetchIndex < LLI_Ptr->NumNodesInList));
+    return LLI_Ptr->Data[Slot (LLI_Ptr, FetchIndex)];
+}
+
+/////////////
+// LL_SetAtIndex updates the user data at the specified index
+// in the underlying LL
+/////////////
+void  LL_SetAtIndex (LLInfoPtr LLI_Ptr, UserData D, int UpdateIndex)
+{
+    assert (LLI_Ptr != NULL);
+    assert ((UpdateIndex >= 0) && (UpdateIndex < LLI_Ptr->NumNodesInList));
+    LLI_Ptr->Data[Slot (LLI_Ptr, UpdateIndex)] = D;
+}
+
+/////////////
+// LL_PeekFrontPtr returns the address of the UserData at the front of
+// the list instead of a copy of it
+/////////////
+UserData *LL_PeekFrontPtr (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    assert (LLI_Ptr->NumNodesInList > 0);
+    return &LLI_Ptr->Data[LLI_Ptr->Front];
+}
+
+/////////////
+// LL_AtIndexPtr returns the address of the UserData at the index
+// instead of a copy of it
+/////////////
+UserData *LL_AtIndexPtr (LLInfoPtr LLI_Ptr, int FetchIndex)
+{
+    assert (LLI_Ptr != NULL);
+    assert ((FetchIndex >= 0) && (FetchIndex < LLI_Ptr->NumNodesInList));
+    return &LLI_Ptr->Data[Slot (LLI_Ptr, FetchIndex)];
+}
+
+/////////////
+// LL_Swap swaps the user data at the two indices
+/////////////
+void  LL_Swap (LLInfoPtr LLI_Ptr, int Index1, int Index2)
+{
+    assert (LLI_Ptr != NULL);
+    assert ((Index1 >= 0) && (Index1 < LLI_Ptr->NumNodesInList));
+    assert ((Index2 >= 0) && (Index2 < LLI_Ptr->NumNodesInList));
+    int Slot1 = Slot (LLI_Ptr, Index1);
+    int Slot2 = Slot (LLI_Ptr, Index2);
+    UserData Temp = LLI_Ptr->Data[Slot1];
+    LLI_Ptr->Data[Slot1] = LLI_Ptr->Data[Slot2];
+    LLI_Ptr->Data[Slot2] = Temp;
+}
+
+/////////////
+// Local function Slot returns where in the ring array the UserData at
+// Index is kept.  Capacity is a power of 2, so the wrap is a mask.
+/////////////
+int Slot (LLInfoPtr LLI_Ptr, int Index)
+{
+    return (LLI_Ptr->Front + Index) & (LLI_Ptr->Capacity - 1);
+}
+
+/////////////
+// Local function MakeRoom makes sure there is room for one more
+// UserData.  When the ring is full an array twice the size is
+// allocated, the UserData are copied into it in list order starting at
+// its beginning (so Front becomes 0) and the old array is freed.
+/////////////
+void MakeRoom (LLInfoPtr LLI_Ptr)
+{
+    if (LLI_Ptr->NumNodesInList < LLI_Ptr->Capacity)
+        return;
+    int NewCapacity = (LLI_Ptr->Capacity == 0) ? DEQUE_INITIAL_CAPACITY : LLI_Ptr->Capacity * 2;
+    // the mask in Slot only works for a power of 2
+    assert ((NewCapacity & (NewCapacity - 1)) == 0);
+    UserData *NewData = (UserData *) malloc (NewCapacity * sizeof (UserData));
+    assert (NewData != NULL);
+    MA_Allocated (MA_LIST_NODE, NewCapacity * sizeof (UserData));
+    for (int i = 0; i < LLI_Ptr->NumNodesInList; i++)
+        NewData[i] = LLI_Ptr->Data[Slot (LLI_Ptr, i)];
+    if (LLI_Ptr->Data != NULL) {
+        free (LLI_Ptr->Data);
+        MA_Released (MA_LIST_NODE, LLI_Ptr->Capacity * sizeof (UserData));
+    }
+    LLI_Ptr->Data = NewData;
+    LLI_Ptr->Capacity = NewCapacity;
+    LLI_Ptr->Front = 0;
+}
@@ -0,0 +1,30 @@
+#ifndef DEQUELIST_H_INCLUDED
+#define DEQUELIST_H_INCLUDED
+
+// DequeList.h is included by LinkedList.h when the list is built
+// with LL_DEQUE defined.  It describes how the deque stores UserData;
+// the functions used to work with the list are still the ones declared
+// in LinkedList.h
+
+// The deque uses UserData
+#include "UserData.h"
+
+// DEQUE_INITIAL_CAPACITY is the number of UserData the ring first has
+// room for; it doubles each time it fills, so it must be a power of 2.
+// It can be changed at build time with -DDEQUE_INITIAL_CAPACITY=n
+#ifndef DEQUE_INITIAL_CAPACITY
+#define DEQUE_INITIAL_CAPACITY 16
+#endif
+
+// Instead of nodes, the deque keeps the UserData side by side in one
+// array used as a ring.  The UserData at index i of the list is in
+// Data[(Front + i) % Capacity], so adding or removing at either end only
+// moves Front or the count, and any index is found without a walk.
+typedef struct {
+    UserData *Data;
+    int       Capacity;
+    int       Front;
+    int       NumNodesInList;
+    } LLInfo, *LLInfoPtr;
+
+#endif // DEQUELIST_H_INCLUDED
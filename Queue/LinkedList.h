@@ -4,6 +4,14 @@
 // The LL functions use UserData
 #include "UserData.h"
 
+// Building with LL_DEQUE defined selects the deque, which keeps the
+// UserData side by side in a ring array instead of one per node.  Its
+// layout is in DequeList.h; every function declared below works the same
+// way with either layout.
+#ifdef LL_DEQUE
+#include "DequeList.h"
+#else
+
 // The Linked List needs the definition of what a Node is. A Node has
 // UserData and linkage information for both "next and "prev"
 // for a doubly linked list).
@@ -26,11 +34,12 @@ typedef struct {
     NodePtr Tail;
     int     NumNodesInList;
     } LLInfo, *LLInfoPtr;
+#endif // LL_DEQUE
 
 // Verifying allocation / deallocation of dynamic memory is done through
-// AllocationCount.  The variable is declared in LinkedList.c and is linked to
-// through the extern
-extern int AllocationCount;
+// the memory account, which keeps the list nodes and LLInfo blocks apart
+// and still provides AllocationCount for reading
+#include "MemoryAccount.h"
 
 // ShouldDelete is an enum that has two valid values called DELETE_NODE
 // and RETAIN_NODE that are used in calling to get user data from the front
@@ -62,4 +71,20 @@ UserData        LL_GetAtIndex   (LLInfoPtr, int FetchIndex);
 void            LL_SetAtIndex   (LLInfoPtr LLI_Ptr, UserData D, int UpdateIndex);
 // LL_Swap swaps the nodes in the underlying LL specified by indices starting at 0
 void            LL_Swap         (LLInfoPtr LLI_Ptr, int Index1, int Index2);
+
+// The functions below hand out the address of user data inside the LL rather than
+// a copy, so a large UserData is not copied.  An address is good until the user
+// data it points to is deleted or, with the deque layout, until anything is added
+// to the LL (which may move it).
+
+// LL_PeekFrontPtr returns the address of the user data at the Head of the underlying LL
+UserData       *LL_PeekFrontPtr (LLInfoPtr LLI_Ptr);
+// LL_AtIndexPtr returns the address of the user data at the specified index starting at 0
+UserData       *LL_AtIndexPtr   (LLInfoPtr LLI_Ptr, int FetchIndex);
+// LL_EmplaceFront adds a node at the Head and returns the address of its user data for
+// the caller to fill in
+UserData       *LL_EmplaceFront (LLInfoPtr LLI_Ptr);
+// LL_EmplaceEnd adds a node at the Tail and returns the address of its user data for
+// the caller to fill in
+UserData       *LL_EmplaceEnd   (LLInfoPtr LLI_Ptr);
 #endif // LINKEDLIST_H_INCLUDED
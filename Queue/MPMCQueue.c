@@ -0,0 +1,155 @@
+//
+//  MPMCQueue.c
+//
+//  A producer reads EnqueuePos and looks at the Sequence of that cell:
+//      - equal to the position: the cell is free, so it claims the
+//        position by moving EnqueuePos on with a compare-and-swap, stores
+//        its UserData and then sets the Sequence to position + 1, with a
+//        release store so the consumer that sees it also sees the UserData
+//      - less than the position: the cell still holds the UserData from
+//        one time round the ring earlier, so the queue is full
+//      - more than the position: another producer claimed it first, so it
+//        reads EnqueuePos again
+//  A consumer does the same from DequeuePos, looking for a Sequence of
+//  position + 1, and frees the cell with a Sequence of position + the ring
+//  size.  Producers and consumers only ever compare-and-swap their own
+//  position, so the two ends do not contend with each other, and no
+//  cell is claimed by two threads.
+//
+
+// stdlib provides aligned_alloc, malloc and free
+#include <stdlib.h>
+// stdint provides intptr_t, for the signed difference of two positions
+#include <stdint.h>
+// sched_yield lets a waiting thread give way
+#include <sched.h>
+// asserts are used for checking the arguments
+#include <assert.h>
+// the calls the queue supports are included for consistency checking
+#include "MPMCQueue.h"
+
+/*
+ MPMC_Init() allocates the queue on its own cache lines and a ring of at
+ least Capacity cells, each with the Sequence for the first time round
+*/
+MPMCQueue MPMC_Init (int Capacity)
+{
+    assert (Capacity > 0);
+    size_t RingSize = 2;
+    while (RingSize < (size_t) Capacity)
+        RingSize *= 2;
+    MPMCQueue Q = (MPMCQueue) aligned_alloc (MPMC_CACHE_LINE, sizeof (MPMCQueueInfo));
+    assert (Q != NULL);
+    MA_Allocated (MA_QUEUE_INFO, sizeof (MPMCQueueInfo));
+    Q->Cells = (MPMCCell *) malloc (RingSize * sizeof (MPMCCell));
+    assert (Q->Cells != NULL);
+    MA_Allocated (MA_LIST_NODE, RingSize * sizeof (MPMCCell));
+    for (size_t loop = 0; loop < RingSize; loop++)
+        atomic_init (&Q->Cells[loop].Sequence, loop);
+    Q->Mask = RingSize - 1;
+    atomic_init (&Q->EnqueuePos, 0);
+    atomic_init (&Q->DequeuePos, 0);
+    return Q;
+}
+
+/*
+ MPMC_Delete() frees the ring and the queue.  It returns NULL to indicate
+ that there is no longer a queue
+*/
+MPMCQueue MPMC_Delete (MPMCQueue Q)
+{
+    assert (Q != NULL);
+    free (Q->Cells);
+    MA_Released (MA_LIST_NODE, (Q->Mask + 1) * sizeof (MPMCCell));
+    free (Q);
+    MA_Released (MA_QUEUE_INFO, sizeof (MPMCQueueInfo));
+    return NULL;
+}
+
+/*
+ MPMC_TryEnqueue() claims the cell at EnqueuePos if it is free and fills it
+*/
+bool MPMC_TryEnqueue (MPMCQueue Q, UserData D)
+{
+    assert (Q != NULL);
+    size_t Pos = atomic_load_explicit (&Q->EnqueuePos, memory_order_relaxed);
+    for (;;) {
+        MPMCCell *Cell = &Q->Cells[Pos & Q->Mask];
+        size_t Sequence = atomic_load_explicit (&Cell->Sequence, memory_order_acquire);
+        intptr_t Diff = (intptr_t) Sequence - (intptr_t) Pos;
+        if (Diff == 0) {
+            // a failed swap leaves the newer EnqueuePos in Pos.  The strong
+            // swap only fails when another producer has moved it on
+            if (atomic_compare_exchange_strong_explicit (&Q->EnqueuePos, &Pos, Pos + 1,
+                                                         memory_order_relaxed, memory_order_relaxed)) {
+                Cell->Data = D;
+                atomic_store_explicit (&Cell->Sequence, Pos + 1, memory_order_release);
+                return true;
+            }
+        }
+        else if (Diff < 0)
+            return false;
+        else
+            Pos = atomic_load_explicit (&Q->EnqueuePos, memory_order_relaxed);
+    }
+}
+
+/*
+ MPMC_TryDequeue() claims the cell at DequeuePos if it is full, empties it
+ and frees it for the enqueue one time round the ring later
+*/
+bool MPMC_TryDequeue (MPMCQueue Q, UserData *D)
+{
+    assert ( (Q != NULL) && (D != NULL) );
+    size_t Pos = atomic_load_explicit (&Q->DequeuePos, memory_order_relaxed);
+    for (;;) {
+        MPMCCell *Cell = &Q->Cells[Pos & Q->Mask];
+        size_t Sequence = atomic_load_explicit (&Cell->Sequence, memory_order_acquire);
+        intptr_t Diff = (intptr_t) Sequence - (intptr_t) (Pos + 1);
+        if (Diff == 0) {
+            if (atomic_compare_exchange_strong_explicit (&Q->DequeuePos, &Pos, Pos + 1,
+                                                         memory_order_relaxed, memory_order_relaxed)) {
+                *D = Cell->Data;
+                atomic_store_explicit (&Cell->Sequence, Pos + Q->Mask + 1, memory_order_release);
+                return true;
+            }
+        }
+        else if (Diff < 0)
+            return false;
+        else
+            Pos = atomic_load_explicit (&Q->DequeuePos, memory_order_relaxed);
+    }
+}
+
+/*
+ MPMC_Enqueue() tries MPMC_SPIN_TRIES times straight away, in case a
+ consumer is about to make room, and then yields between tries
+*/
+void MPMC_Enqueue (MPMCQueue Q, UserData D)
+{
+    for (int Tries = 0; !MPMC_TryEnqueue (Q, D); Tries++)
+        if (Tries >= MPMC_SPIN_TRIES)
+            sched_yield ();
+}
+
+/*
+ MPMC_Dequeue() tries MPMC_SPIN_TRIES times straight away, in case a
+ producer is about to fill a cell, and then yields between tries
+*/
+UserData MPMC_Dequeue (MPMCQueue Q)
+{
+    UserData D;
+    for (int Tries = 0; !MPMC_TryDequeue (Q, &D); Tries++)
+        if (Tries >= MPMC_SPIN_TRIES)
+            sched_yield ();
+    return D;
+}
+
+/*
+ MPMC_Capacity() returns the number of cells in the ring
+*/
+int MPMC_Capacity (MPMCQueue Q)
+{
+    assert (Q != NULL);
+    return (int) (Q->Mask + 1);
+}
@@ -0,0 +1,109 @@
+//
+//  MPMCQueue.h
+//
+
+#ifndef MPMCQueue_h
+#define MPMCQueue_h
+
+// MPMCQueue.h declares a bounded queue of UserData that any number of
+// producer and consumer threads can use at once.  It is Dmitry Vyukov's
+// bounded queue: a ring of cells, each with a sequence number that says
+// whether the cell is ready for the next enqueue or the next dequeue.
+//
+//      MPMCQueue Q = MPMC_Init (1024);            // before the threads
+//      ...                                         // in any thread:
+//      if (!MPMC_TryEnqueue (Q, D)) ...            // full
+//      if (MPMC_TryDequeue (Q, &D)) ...            // not empty
+//      MPMC_Enqueue (Q, D);                        // waits for room
+//      D = MPMC_Dequeue (Q);                       // waits for a UserData
+//      ...
+//      Q = MPMC_Delete (Q);                        // after the threads
+//
+// Progress: there are no locks, and a try call that finds the queue full
+// or empty returns at once.  The positions are moved on with a strong
+// compare-and-swap, so a thread only retries because another thread on
+// the same end has just claimed a position.  That does not make the queue
+// lock-free, though.  A producer that has claimed position p and is
+// switched out before it fills the cell stops DequeuePos at p: every
+// consumer is told the queue is empty, even if the cells after p are
+// already full.  Once the other producers have gone round the ring to p,
+// they are told the queue is full as well.  So one stalled producer
+// blocks all the consumers and, in the end, all the producers, until it
+// runs again; a stalled consumer does the same to the producers.  In the
+// worst case the queue is blocking.
+//
+// Fairness: UserData come out in the order their cells were claimed, so
+// the queue is first in, first out for each producer, and the UserData
+// each consumer gets from one producer arrive in the order sent.  Threads
+// racing for the same end are not served in any order, though, and one
+// can lose the race any number of times in a row.  The waiting calls spin
+// for a short while and then yield their CPU each time round, so they do
+// not queue waiting threads either.
+
+// The calls on a queue need to pass or return UserData
+#include "UserData.h"
+// The try calls return a boolean
+#include <stdbool.h>
+// size_t is defined in stddef.h
+#include <stddef.h>
+// the positions and sequence numbers are atomics
+#include <stdatomic.h>
+// Verifying allocation / deallocation of dynamic memory is done through
+// the memory account, which also provides AllocationCount for reading
+#include "MemoryAccount.h"
+
+// MPMC_CACHE_LINE is the size of a cache line.  The producers' and the
+// consumers' positions are kept this far apart so that claiming a cell at
+// one end does not take the cache line away from threads at the other
+#ifndef MPMC_CACHE_LINE
+#define MPMC_CACHE_LINE 64
+#endif
+
+// MPMC_SPIN_TRIES is the number of times the waiting calls try again
+// straight away before they start yielding between tries
+#ifndef MPMC_SPIN_TRIES
+#define MPMC_SPIN_TRIES 64
+#endif
+
+// A cell holds a UserData and its Sequence.  For the cell at position p
+// (counting every enqueue ever made), a Sequence of p means the cell is
+// free for the enqueue at p, and p + 1 means it holds that UserData, ready
+// for the dequeue at p.  The dequeue then sets it to p + the ring size,
+// freeing it for the enqueue one time round the ring later.
+typedef struct {
+    atomic_size_t Sequence;
+    UserData      Data;
+} MPMCCell;
+
+// This is the layout of an MPMC queue.  The cells are a ring of Mask + 1.
+// EnqueuePos is the position the next producer will claim and DequeuePos
+// the one the next consumer will claim; each is claimed with a
+// compare-and-swap and each is on its own cache line.
+
+typedef struct {
+    _Alignas (MPMC_CACHE_LINE) atomic_size_t EnqueuePos;
+    _Alignas (MPMC_CACHE_LINE) atomic_size_t DequeuePos;
+    _Alignas (MPMC_CACHE_LINE) MPMCCell     *Cells;
+    size_t                                   Mask;
+} MPMCQueueInfo, *MPMCQueue;
+
+// MPMC_Init() allocates an empty queue with room for Capacity UserData,
+// rounded up to a power of two of at least 2
+MPMCQueue   MPMC_Init           (int Capacity);
+// MPMC_Delete() frees the queue.  It returns NULL
+MPMCQueue   MPMC_Delete         (MPMCQueue Q);
+// MPMC_TryEnqueue() adds D at the end of the queue and returns true, or
+// returns false if the queue is full
+bool        MPMC_TryEnqueue     (MPMCQueue Q, UserData D);
+// MPMC_TryDequeue() takes the UserData at the front of the queue into D
+// and returns true, or returns false if the queue is empty
+bool        MPMC_TryDequeue     (MPMCQueue Q, UserData *D);
+// MPMC_Enqueue() adds D at the end of the queue, waiting while it is full
+void        MPMC_Enqueue        (MPMCQueue Q, UserData D);
+// MPMC_Dequeue() returns the UserData at the front of the queue, waiting
+// while it is empty
+UserData    MPMC_Dequeue        (MPMCQueue Q);
+// MPMC_Capacity() returns the number of UserData the queue has room for
+int         MPMC_Capacity       (MPMCQueue Q);
+
+#endif /* MPMCQueue_h */
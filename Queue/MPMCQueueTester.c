@@ -0,0 +1,140 @@
+//
+//  MPMCQueueTester
+//
+//  This is a stress test of the bounded multi-producer, multi-consumer
+//  queue.  It checks that:
+//      On one thread the queue is first in, first out and reports full and
+//          empty - uses calls to MPMC_TryEnqueue() and MPMC_TryDequeue()
+//      Producers each sending their own numbers through a small ring, with
+//          MPMC_Enqueue() and MPMC_TryEnqueue(), to consumers using
+//          MPMC_Dequeue() and MPMC_TryDequeue(), get every number through
+//          exactly once, and each consumer gets each producer's numbers
+//          in the order they were sent
+//      Nothing is left allocated when the queues are deleted
+//  A number delivered twice or never, or behind a later number from the
+//  same producer, and a wrong full or empty report, are each counted.
+//  The count is printed, and the program exits with 1 unless it is 0 and
+//  no memory is still allocated.
+
+// printf support
+#include <stdio.h>
+// we use rand_r from stdlib.h, which each thread can call on its own seed
+#include <stdlib.h>
+// the producers and consumers are pthreads
+#include <pthread.h>
+// sched_yield lets a thread that cannot go on give way
+#include <sched.h>
+// we use the MPMC queue, so include its functions that we can call
+#include "MPMCQueue.h"
+
+// The threads, the numbers each producer sends and the ring they share.
+// A producer's numbers are Producer * PER_PRODUCER up
+#define NUM_PRODUCERS  3
+#define NUM_CONSUMERS  3
+#define PER_PRODUCER   300000
+#define NUM_NUMBERS    (NUM_PRODUCERS * PER_PRODUCER)
+#define RING_SIZE      16
+
+// The queue the threads share, the numbers taken and the mismatches found
+static MPMCQueue   TheQueue;
+static atomic_char Taken[NUM_NUMBERS];
+static atomic_int  NumTaken;
+static atomic_int  Errors;
+
+// Producer sends its numbers in order
+static void *Producer (void *Arg);
+
+// Consumer takes numbers until all have been taken
+static void *Consumer (void *Arg);
+
+int main(int argc, const char * argv[]) {
+    // on one thread: fill to the brim, then empty it again, twice round
+    MPMCQueue Q = MPMC_Init (5);
+    UserData D = {0};
+    if (MPMC_Capacity (Q) != 8 || MPMC_TryDequeue (Q, &D))
+        atomic_fetch_add (&Errors, 1);
+    for (int round = 0; round < 3; round++) {
+        for (int loop = 0; loop < 8; loop++) {
+            D.taskNumber = round * 8 + loop;
+            if (!MPMC_TryEnqueue (Q, D))
+                atomic_fetch_add (&Errors, 1);
+        }
+        if (MPMC_TryEnqueue (Q, D))
+            atomic_fetch_add (&Errors, 1);
+        for (int loop = 0; loop < 8; loop++)
+            if (MPMC_Dequeue (Q).taskNumber != round * 8 + loop)
+                atomic_fetch_add (&Errors, 1);
+        if (MPMC_TryDequeue (Q, &D))
+            atomic_fetch_add (&Errors, 1);
+    }
+    Q = MPMC_Delete (Q);
+    printf ("One thread: %d errors\n", atomic_load (&Errors));
+
+    pthread_t Threads[NUM_PRODUCERS + NUM_CONSUMERS];
+    unsigned int Ids[NUM_PRODUCERS + NUM_CONSUMERS];
+    printf ("%d threads send %d numbers through a ring of %d to %d threads\n",
+            NUM_PRODUCERS, NUM_NUMBERS, RING_SIZE, NUM_CONSUMERS);
+    TheQueue = MPMC_Init (RING_SIZE);
+    for (int loop = 0; loop < NUM_PRODUCERS + NUM_CONSUMERS; loop++) {
+        Ids[loop] = (loop < NUM_PRODUCERS) ? loop : loop - NUM_PRODUCERS;
+        pthread_create (&Threads[loop], NULL, loop < NUM_PRODUCERS ? Producer : Consumer, &Ids[loop]);
+    }
+    for (int loop = 0; loop < NUM_PRODUCERS + NUM_CONSUMERS; loop++)
+        pthread_join (Threads[loop], NULL);
+    TheQueue = MPMC_Delete (TheQueue);
+    int NeverTaken = 0;
+    for (int loop = 0; loop < NUM_NUMBERS; loop++)
+        NeverTaken += (atomic_load (&Taken[loop]) == 0);
+    printf ("Numbers never taken: %d\n", NeverTaken);
+    if (NeverTaken != 0)
+        atomic_fetch_add (&Errors, 1);
+
+    printf ("Errors: %d, the allocation count is now %d\n", atomic_load (&Errors), AllocationCount);
+    return (Errors == 0 && AllocationCount == 0) ? 0 : 1;
+}
+
+// function Producer sends its numbers, choosing at random between the
+// waiting call and the try call, yielding whenever the try finds it full
+void *Producer (void *Arg)
+{
+    unsigned int Seed = *(unsigned int *) Arg + 1;
+    int First = *(unsigned int *) Arg * PER_PRODUCER;
+    for (int loop = 0; loop < PER_PRODUCER; loop++) {
+        UserData D = {First + loop};
+        if (rand_r (&Seed) % 2 == 0)
+            MPMC_Enqueue (TheQueue, D);
+        else
+            while (!MPMC_TryEnqueue (TheQueue, D))
+                sched_yield ();
+    }
+    return NULL;
+}
+
+// function Consumer takes numbers with the try call until every number has
+// been taken, so that no consumer is left waiting at the end.  It checks
+// that each number has not been taken before and that the numbers it gets
+// from each producer keep going up
+void *Consumer (void *Arg)
+{
+    int Last[NUM_PRODUCERS];
+    for (int loop = 0; loop < NUM_PRODUCERS; loop++)
+        Last[loop] = -1;
+    while (atomic_load (&NumTaken) < NUM_NUMBERS) {
+        UserData D;
+        if (!MPMC_TryDequeue (TheQueue, &D)) {
+            sched_yield ();
+            continue;
+        }
+        atomic_fetch_add (&NumTaken, 1);
+        int Number = D.taskNumber;
+        if (Number < 0 || Number >= NUM_NUMBERS || atomic_fetch_add (&Taken[Number], 1) != 0) {
+            atomic_fetch_add (&Errors, 1);
+            continue;
+        }
+        int From = Number / PER_PRODUCER;
+        if (Number <= Last[From])
+            atomic_fetch_add (&Errors, 1);
+        Last[From] = Number;
+    }
+    return NULL;
+}
@@ -24,7 +24,7 @@ Queue initQueue()
     // allocate a queue structure and abort if the allocation failed
     Queue Q = (Queue) malloc(sizeof(QueueInfo));
     assert (Q!= NULL);
-    AllocationCount++;
+    MA_Allocated (MA_QUEUE_INFO, sizeof (QueueInfo));
     // allocate and initialize the underlying linked list
     Q->LL = LL_Init();
     // we are empty until an item is pushed
@@ -33,6 +33,17 @@ Queue initQueue()
     return Q;
 }
 
+/*
+ initQueueWithCapacity() is initQueue() for a queue on a linked list, since
+ each enqueue makes room for itself.  It is here so that the same code can
+ use either queue layout.
+*/
+Queue initQueueWithCapacity(int Capacity)
+{
+    assert (Capacity >= 0);
+    return initQueue();
+}
+
 /*
 peek() will return the UserData at the front of the queue, but leave the data
 on the queue by calling the linked list GetFront() with a RETAIN option
@@ -43,6 +54,16 @@ UserData peek(Queue Q)
 	return LL_GetFront(Q->LL, RETAIN_NODE);
 }
 
+/*
+peekPtr() returns the address of the UserData at the front of the queue
+without copying it, by calling the linked list LL_PeekFrontPtr()
+*/
+UserData *peekPtr(Queue Q)
+{
+	assert((Q != NULL) && (Q->empty != true));
+	return LL_PeekFrontPtr(Q->LL);
+}
+
 /*
 empty() returns the boolean indicating whether the queue is currently empty
 */
@@ -54,14 +75,14 @@ bool empty(Queue Q)
 
 /*
  deleteQueue() calls the linked list delete to free up all of its nodes and, on return,
- frees up the queue itself.  Then reduces the allocation count by one.
+ frees up the queue itself.  Then takes it off the memory account.
  It returns NULL to indicate that there is no longer a queue.
  */
 Queue deleteQueue(Queue Q) {
 	assert(Q != NULL);
 	LL_Delete(Q->LL);
 	free(Q);
-	AllocationCount--;
+	MA_Released (MA_QUEUE_INFO, sizeof (QueueInfo));
 	return NULL;
 }
 
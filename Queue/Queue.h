@@ -7,11 +7,20 @@
 
 // The calls on a Queue need to pass or return UserData
 #include "UserData.h"
-// Our Queue will use a linked list, so we need to resolve LLInfoPtr
-#include "LinkedList.h"
 // The Queue empty() call returns a boolean
 #include <stdbool.h>
 
+// Building with QUEUE_RING defined selects the ring queue, which keeps the
+// UserData in one growable ring array instead of a linked list, so an
+// enqueue or dequeue does not allocate or free anything once the ring is
+// big enough.  Its layout is in RingQueue.h.  Every function declared below
+// works the same way with either layout.
+#if defined (QUEUE_RING)
+#include "RingQueue.h"
+#else
+// Our Queue will use a linked list, so we need to resolve LLInfoPtr
+#include "LinkedList.h"
+
 // This is the layout of a queue.  Notice that it contains
 // a pointer to our underlying linked list and a simple boolean
 // to indicate if our queue is empty (true) or not empty (false)
@@ -20,9 +29,14 @@ typedef struct {
     LLInfoPtr LL;
     bool empty;
 } QueueInfo, *Queue;
+#endif // QUEUE_RING
 
 // initQueue() allocates a queue and initializes it
 Queue       initQueue();
+// initQueueWithCapacity() allocates a queue with room for Capacity UserData
+// before it has to grow.  A queue on a linked list has nothing to set aside,
+// so it is the same as initQueue()
+Queue       initQueueWithCapacity(int Capacity);
 // empty() returns the boolean for the Queue Q (true is empty, false is not empty)
 bool        empty(Queue Q);
 // enqueue() places the UserData at the end of the underlying LL
@@ -33,6 +47,11 @@ UserData    dequeue (Queue Q);
 // peek() returns the UserData on the top of the queue but will not
 // delete it from the queue
 UserData    peek (Queue Q);
+// peekPtr() returns the address of the UserData on the top of the queue instead
+// of a copy, so a large UserData is not copied just to be looked at.  The address
+// is good until that UserData is dequeued or, with the deque or ring layout, anything
+// else is enqueued
+UserData   *peekPtr (Queue Q);
 // deleteQueue() deletes the frees the storage that was allocated by the call
 // to initQueue()
 Queue       deleteQueue(Queue Q);
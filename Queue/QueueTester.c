@@ -7,6 +7,9 @@
 //      - it uses empty() to determine if the queue holds any data that
 //          can be dequeued or peeked
 //      - when done, it deletes the queue
+//      - it builds a second queue with initQueueWithCapacity() and shows
+//          that, with the ring layout, filling it to that capacity makes
+//          no more allocations
 // For demonstration purposes, it shows the number of allocations for
 // everything it does.
 
@@ -60,6 +63,19 @@ int main(int argc, const char * argv[]) {
    PrintAllocations ("Before deleteQueue called");
    Q = deleteQueue(Q);
    PrintAllocations ("After deleteQueue called");
+
+   // a queue made with room for the demo data does not grow while it holds it
+   Q = initQueueWithCapacity(NumDemoDataItems);
+   PrintAllocations ("After initQueueWithCapacity called");
+   for (int loop = 0; loop < NumDemoDataItems; loop++)
+       enqueue (Q, DemoData[loop]);
+   PrintAllocations ("After the demo data is enqueued");
+   while (!empty(Q))
+       dequeue(Q);
+   Q = deleteQueue(Q);
+   PrintAllocations ("After deleteQueue called");
+   // show how much memory the queue needed at its largest
+   MA_Report (stdout);
     return 0;
 }
 
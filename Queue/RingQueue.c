@@ -0,0 +1,156 @@
+//
+//  RingQueue.c
+//
+//  The ring queue provides the same calls as Queue.c, declared in Queue.h,
+//  and is used in its place when the queue is built with QUEUE_RING defined.
+//  Instead of a list node per UserData, the UserData are kept side by side
+//  in one ring array, so
+//      - enqueue() checks there is room and stores the UserData after the
+//        last one, wrapping round to the start of the array
+//      - dequeue() reads the front UserData and moves the front on
+//  Neither calls the allocator unless the ring is full, when it doubles with
+//  a realloc, counted in the memory account as list node storage (the same
+//  as the deque's ring array and the array stack).
+//
+
+// stdlib provides malloc, realloc and free
+#include <stdlib.h>
+// stdbool defines bool
+#include <stdbool.h>
+// string provides memcpy for unwrapping the ring when it grows
+#include <string.h>
+// asserts are used for checking that the queue exists
+#include <assert.h>
+// calls the queue supports are included for consistency checking
+#include "Queue.h"
+
+// Resize is a local function that moves the UserData into a ring with room
+// for NewCapacity of them
+static void Resize (Queue Q, int NewCapacity);
+
+/*
+ initQueue() allocates a queue structure and initializes its contents.
+ The ring is not allocated until the first enqueue needs it
+*/
+Queue initQueue()
+{
+    // allocate a queue structure and abort if the allocation failed
+    Queue Q = (Queue) malloc(sizeof(QueueInfo));
+    assert (Q!= NULL);
+    MA_Allocated (MA_QUEUE_INFO, sizeof (QueueInfo));
+    // we are empty and have no ring until an item is enqueued
+    Q->Items = NULL;
+    Q->Front = 0;
+    Q->Count = 0;
+    Q->Capacity = 0;
+    // return the queue to the caller
+    return Q;
+}
+
+/*
+ initQueueWithCapacity() allocates a queue with a ring that has room for at
+ least Capacity UserData, rounded up to a power of two, so that the queue
+ does not allocate at all while it holds no more than that
+*/
+Queue initQueueWithCapacity(int Capacity)
+{
+    assert (Capacity >= 0);
+    Queue Q = initQueue();
+    if (Capacity > 0) {
+        int RingSize = 1;
+        while (RingSize < Capacity)
+            RingSize *= 2;
+        Resize (Q, RingSize);
+    }
+    return Q;
+}
+
+/*
+peek() will return the UserData at the front of the queue, but leave the data
+on the queue
+*/
+UserData peek(Queue Q)
+{
+	assert((Q != NULL) && (Q->Count > 0));
+	return Q->Items[Q->Front];
+}
+
+/*
+peekPtr() returns the address of the UserData at the front of the queue
+without copying it.  An enqueue may move the ring, so the address is only
+good until the next enqueue or dequeue
+*/
+UserData *peekPtr(Queue Q)
+{
+	assert((Q != NULL) && (Q->Count > 0));
+	return &Q->Items[Q->Front];
+}
+
+/*
+empty() returns true when there is nothing in the queue
+*/
+bool empty(Queue Q)
+{
+	assert(Q != NULL);
+	return Q->Count == 0;
+}
+
+/*
+ deleteQueue() frees the ring, if there is one, and then the queue itself.
+ It returns NULL to indicate that there is no longer a queue.
+ */
+Queue deleteQueue(Queue Q) {
+	assert(Q != NULL);
+	if (Q->Items != NULL) {
+		free(Q->Items);
+		MA_Released (MA_LIST_NODE, Q->Capacity * sizeof (UserData));
+	}
+	free(Q);
+	MA_Released (MA_QUEUE_INFO, sizeof (QueueInfo));
+	return NULL;
+}
+
+/* enqueue() stores the UserData in the slot after the last one, first
+   doubling the ring if it is full
+*/
+void enqueue (Queue Q, UserData D) {
+	assert(Q != NULL);
+	if (Q->Count == Q->Capacity)
+		Resize (Q, (Q->Capacity == 0) ? QUEUE_INITIAL_CAPACITY : Q->Capacity * 2);
+	Q->Items[(Q->Front + Q->Count) & (Q->Capacity - 1)] = D;
+	Q->Count++;
+}
+
+/*
+   dequeue() returns the UserData at the front of the queue and moves the
+   front on to the next slot round the ring
+*/
+UserData dequeue (Queue Q) {
+	assert((Q != NULL) && (Q->Count > 0));
+	UserData D = Q->Items[Q->Front];
+	Q->Front = (Q->Front + 1) & (Q->Capacity - 1);
+	Q->Count--;
+	return D;
+}
+
+/*
+   Resize reallocs the ring to NewCapacity slots and updates the memory
+   account.  If the UserData wrapped round the end of the old ring, the ones
+   at its start are copied to just after its end, where the bigger ring
+   continues, so they follow on from the others again
+*/
+void Resize (Queue Q, int NewCapacity)
+{
+	assert ( (NewCapacity >= Q->Count) && ((NewCapacity & (NewCapacity - 1)) == 0) );
+	UserData *NewItems = (UserData *) realloc (Q->Items, NewCapacity * sizeof (UserData));
+	assert (NewItems != NULL);
+	if (Q->Items == NULL)
+		MA_Allocated (MA_LIST_NODE, NewCapacity * sizeof (UserData));
+	else
+		MA_Resized (MA_LIST_NODE, Q->Capacity * sizeof (UserData), NewCapacity * sizeof (UserData));
+	int Wrapped = Q->Front + Q->Count - Q->Capacity;
+	if (Wrapped > 0)
+		memcpy (&NewItems[Q->Capacity], NewItems, Wrapped * sizeof (UserData));
+	Q->Items = NewItems;
+	Q->Capacity = NewCapacity;
+}
@@ -0,0 +1,43 @@
+//
+//  RingQueue.h
+//
+
+#ifndef RingQueue_h
+#define RingQueue_h
+
+// RingQueue.h is included by Queue.h when the queue is built with
+// QUEUE_RING defined.  It describes how the ring queue stores UserData;
+// the functions used to work with the queue are still the ones declared
+// in Queue.h
+
+// The queue holds UserData
+#include "UserData.h"
+// The queue empty() call returns a boolean
+#include <stdbool.h>
+// Verifying allocation / deallocation of dynamic memory is done through
+// the memory account, which also provides AllocationCount for reading
+#include "MemoryAccount.h"
+
+// QUEUE_INITIAL_CAPACITY is the number of UserData the ring first has room
+// for when initQueue() is used; it doubles each time it fills.  It has to
+// be a power of two, and can be changed at build time with
+// -DQUEUE_INITIAL_CAPACITY=n
+#ifndef QUEUE_INITIAL_CAPACITY
+#define QUEUE_INITIAL_CAPACITY 16
+#endif
+
+// This is the layout of a ring queue.  The UserData are kept in Items, a
+// ring of Capacity slots where Capacity is a power of two, so the slot after
+// the last is found by masking with Capacity - 1 instead of dividing.  The
+// front of the queue is Items[Front] and the Count UserData after it follow
+// round the ring.  The ring only ever grows, so a queue that stays about
+// the same size never allocates once it has found that size.
+
+typedef struct {
+    UserData *Items;
+    int       Front;
+    int       Count;
+    int       Capacity;
+} QueueInfo, *Queue;
+
+#endif /* RingQueue_h */
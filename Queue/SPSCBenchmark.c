@@ -0,0 +1,295 @@
+//
+//  SPSCBenchmark
+//
+//  This program times the single-producer, single-consumer queue against
+//  a Queue.h queue with one mutex around every call, the way a pipeline
+//  of two threads would otherwise share it, in two ways:
+//      ping-pong - one thread sends a UserData to the other, which sends
+//                  it straight back on a second queue.  The time for each
+//                  round trip is mostly the time for a UserData written
+//                  by one core to be seen by the other
+//      streaming - one thread sends NUM_STREAMED UserData as fast as it
+//                  can and the other takes them as fast as it can, one at
+//                  a time and, for the SPSC queue, also in batches of
+//                  BATCH_SIZE
+//  Every UserData received is checked to be the next one sent.  On Linux,
+//  when the program may run on two or more CPUs, the sending thread is
+//  pinned to one of them and the receiving thread to another, so that
+//  the UserData really do cross between cores, and the CPUs used are
+//  printed.  A thread that finds its queue full or empty yields, so that
+//  the benchmark still makes progress when both threads share one CPU;
+//  there the round trip is the time for two thread switches rather than
+//  two cache-line transfers, and the program says so.
+
+// pthread_setaffinity_np and the CPU_ macros are GNU extensions
+#define _GNU_SOURCE
+// we use printf from stdio.h
+#include <stdio.h>
+// we use clock_gettime from time.h to time the runs by the wall clock
+#include <time.h>
+// the two ends of the pipeline are pthreads
+#include <pthread.h>
+// sched_yield lets a thread that cannot go on give way to the other
+#include <sched.h>
+// we use both queues, so include the functions that we can call
+#include "Queue.h"
+#include "SPSCQueue.h"
+
+// The round trips, the UserData streamed, the batch size and the ring size
+#define NUM_ROUND_TRIPS  200000
+#define NUM_STREAMED     10000000
+#define BATCH_SIZE       64
+#define RING_SIZE        1024
+
+// QueueKind says which queue, and which calls, a run uses
+typedef enum { SPSC_SINGLE, SPSC_BATCH, ONE_MUTEX } QueueKind;
+
+// A Pipe is one direction of a pipeline: an SPSC queue, or a Queue.h
+// queue and the mutex that goes with it
+typedef struct {
+    SPSCQueue       Ring;
+    Queue           Q;
+    pthread_mutex_t Mutex;
+} Pipe;
+
+// The pipes used by a run, and its kind
+static Pipe      Ping, Pong;
+static QueueKind Kind;
+static int       Mismatches;
+
+// The CPUs the sending and receiving threads are pinned to, or -1 if
+// they are not pinned
+static int       SenderCpu = -1, ReceiverCpu = -1;
+
+// PickCpus chooses two different CPUs the program may run on, if there
+// are two, and pins the calling (sending) thread to the first
+static void PickCpus (void);
+
+// PinTo pins the calling thread to Cpu, unless Cpu is -1
+static void PinTo (int Cpu);
+
+// Send puts D in the pipe, yielding while it is full
+static void Send (Pipe *P, UserData D);
+
+// Receive takes the next UserData from the pipe, yielding while it is empty
+static UserData Receive (Pipe *P);
+
+// Echo receives on Ping and sends each UserData back on Pong
+static void *Echo (void *Arg);
+
+// Consume receives NUM_STREAMED UserData on Ping, checking their order
+static void *Consume (void *Arg);
+
+// TimePingPong returns the nanoseconds a round trip takes
+static double TimePingPong (QueueKind RunKind);
+
+// TimeStream returns the UserData streamed a second
+static double TimeStream (QueueKind RunKind);
+
+// OpenPipe and ClosePipe make and delete a pipe of the run's kind
+static void OpenPipe (Pipe *P);
+static void ClosePipe (Pipe *P);
+
+// Seconds returns the wall clock time from Start to End
+static double Seconds (struct timespec Start, struct timespec End);
+
+int main(int argc, const char * argv[]) {
+    PickCpus();
+    if (ReceiverCpu >= 0)
+        printf ("Sending thread on CPU %d, receiving thread on CPU %d\n", SenderCpu, ReceiverCpu);
+    else
+        printf ("The threads are not pinned to different CPUs, so a round trip is mostly thread switches\n");
+    printf ("%-14s %18s %20s\n", "queue", "round trip ns", "streamed items/s");
+    printf ("%-14s %18.0f %20.0f\n", "SPSC", TimePingPong (SPSC_SINGLE), TimeStream (SPSC_SINGLE));
+    printf ("%-14s %18s %20.0f\n", "SPSC batches", "-", TimeStream (SPSC_BATCH));
+    printf ("%-14s %18.0f %20.0f\n", "one mutex", TimePingPong (ONE_MUTEX), TimeStream (ONE_MUTEX));
+    if (Mismatches != 0)
+        printf ("%d UserData arrived out of order\n", Mismatches);
+    printf ("The allocation count is now %d\n", AllocationCount);
+    return 0;
+}
+
+// function OpenPipe makes the queue the run's kind uses
+void OpenPipe (Pipe *P)
+{
+    if (Kind == ONE_MUTEX) {
+        P->Q = initQueue();
+        pthread_mutex_init (&P->Mutex, NULL);
+    }
+    else
+        P->Ring = SPSC_Init (RING_SIZE);
+}
+
+// function ClosePipe deletes the queue the run's kind used
+void ClosePipe (Pipe *P)
+{
+    if (Kind == ONE_MUTEX) {
+        P->Q = deleteQueue (P->Q);
+        pthread_mutex_destroy (&P->Mutex);
+    }
+    else
+        P->Ring = SPSC_Delete (P->Ring);
+}
+
+// function Send tries until there is room
+void Send (Pipe *P, UserData D)
+{
+    if (Kind == ONE_MUTEX) {
+        pthread_mutex_lock (&P->Mutex);
+        enqueue (P->Q, D);
+        pthread_mutex_unlock (&P->Mutex);
+    }
+    else
+        while (!SPSC_TryEnqueue (P->Ring, D))
+            sched_yield ();
+}
+
+// function Receive tries until there is a UserData
+UserData Receive (Pipe *P)
+{
+    UserData D;
+    if (Kind == ONE_MUTEX)
+        for (;;) {
+            pthread_mutex_lock (&P->Mutex);
+            bool Got = !empty (P->Q);
+            if (Got)
+                D = dequeue (P->Q);
+            pthread_mutex_unlock (&P->Mutex);
+            if (Got)
+                return D;
+            sched_yield ();
+        }
+    while (!SPSC_TryDequeue (P->Ring, &D))
+        sched_yield ();
+    return D;
+}
+
+// function Echo sends back every UserData it is sent
+void *Echo (void *Arg)
+{
+    PinTo (ReceiverCpu);
+    for (int loop = 0; loop < NUM_ROUND_TRIPS; loop++)
+        Send (&Pong, Receive (&Ping));
+    return NULL;
+}
+
+// function TimePingPong sends each UserData to the echo thread and waits
+// for it to come back before sending the next
+double TimePingPong (QueueKind RunKind)
+{
+    Kind = RunKind;
+    OpenPipe (&Ping);
+    OpenPipe (&Pong);
+    pthread_t EchoThread;
+    pthread_create (&EchoThread, NULL, Echo, NULL);
+    struct timespec Start, End;
+    clock_gettime (CLOCK_MONOTONIC, &Start);
+    for (int loop = 0; loop < NUM_ROUND_TRIPS; loop++) {
+        UserData D = {loop};
+        Send (&Ping, D);
+        Mismatches += (Receive (&Pong).taskNumber != loop);
+    }
+    clock_gettime (CLOCK_MONOTONIC, &End);
+    pthread_join (EchoThread, NULL);
+    ClosePipe (&Ping);
+    ClosePipe (&Pong);
+    return Seconds (Start, End) * 1e9 / NUM_ROUND_TRIPS;
+}
+
+// function Consume takes the streamed UserData, a batch at a time for a
+// batch run, counting any that are not the next one sent
+void *Consume (void *Arg)
+{
+    PinTo (ReceiverCpu);
+    int Mismatched = 0;
+    if (Kind == SPSC_BATCH) {
+        UserData Batch[BATCH_SIZE];
+        for (int Expected = 0; Expected < NUM_STREAMED; ) {
+            int Taken = SPSC_DequeueBatch (Ping.Ring, Batch, BATCH_SIZE);
+            if (Taken == 0)
+                sched_yield ();
+            for (int loop = 0; loop < Taken; loop++)
+                Mismatched += (Batch[loop].taskNumber != Expected++);
+        }
+    }
+    else
+        for (int Expected = 0; Expected < NUM_STREAMED; Expected++)
+            Mismatched += (Receive (&Ping).taskNumber != Expected);
+    Mismatches += Mismatched;
+    return NULL;
+}
+
+// function TimeStream sends NUM_STREAMED UserData to the consuming thread
+// and times them until it has taken the last
+double TimeStream (QueueKind RunKind)
+{
+    Kind = RunKind;
+    OpenPipe (&Ping);
+    pthread_t ConsumeThread;
+    struct timespec Start, End;
+    clock_gettime (CLOCK_MONOTONIC, &Start);
+    pthread_create (&ConsumeThread, NULL, Consume, NULL);
+    if (Kind == SPSC_BATCH) {
+        UserData Batch[BATCH_SIZE];
+        for (int Next = 0; Next < NUM_STREAMED; ) {
+            int NumBatch = (NUM_STREAMED - Next < BATCH_SIZE) ? NUM_STREAMED - Next : BATCH_SIZE;
+            for (int loop = 0; loop < NumBatch; loop++)
+                Batch[loop].taskNumber = Next + loop;
+            int Added = SPSC_EnqueueBatch (Ping.Ring, Batch, NumBatch);
+            if (Added == 0)
+                sched_yield ();
+            Next += Added;
+        }
+    }
+    else
+        for (int loop = 0; loop < NUM_STREAMED; loop++) {
+            UserData D = {loop};
+            Send (&Ping, D);
+        }
+    pthread_join (ConsumeThread, NULL);
+    clock_gettime (CLOCK_MONOTONIC, &End);
+    ClosePipe (&Ping);
+    return NUM_STREAMED / Seconds (Start, End);
+}
+
+// function PickCpus takes the first two CPUs in the program's affinity
+// mask.  Elsewhere than Linux the threads are left where they are.
+void PickCpus (void)
+{
+#if defined (__linux__)
+    cpu_set_t Allowed;
+    if (sched_getaffinity (0, sizeof (Allowed), &Allowed) != 0)
+        return;
+    int First = -1;
+    for (int Cpu = 0; Cpu < CPU_SETSIZE; Cpu++)
+        if (CPU_ISSET (Cpu, &Allowed)) {
+            if (First < 0)
+                First = Cpu;
+            else {
+                SenderCpu = First;
+                ReceiverCpu = Cpu;
+                PinTo (SenderCpu);
+                return;
+            }
+        }
+#endif // __linux__
+}
+
+// function PinTo sets the calling thread's affinity to the one CPU
+void PinTo (int Cpu)
+{
+#if defined (__linux__)
+    if (Cpu < 0)
+        return;
+    cpu_set_t Only;
+    CPU_ZERO (&Only);
+    CPU_SET (Cpu, &Only);
+    pthread_setaffinity_np (pthread_self (), sizeof (Only), &Only);
+#endif // __linux__
+}
+
+// function Seconds converts the time between Start and End to seconds
+double Seconds (struct timespec Start, struct timespec End)
+{
+    return (End.tv_sec - Start.tv_sec) + (End.tv_nsec - Start.tv_nsec) / 1e9;
+}
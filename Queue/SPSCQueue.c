@@ -0,0 +1,180 @@
+//
+//  SPSCQueue.c
+//
+//  The SPSC queue is a ring with an index for each end, each written by one
+//  thread only.  The producer stores a UserData in its slot and only then
+//  moves Tail on with a release store; the consumer reads Tail with an
+//  acquire load before it reads the slot, so it always sees the UserData
+//  that was stored there.  The same pairing on Head tells the producer a
+//  slot has been read and may be used again.
+//
+//  Each thread reads the other's index only when its cached copy runs out:
+//  a producer that last saw room for 100 more UserData adds 100 without
+//  looking at Head again.  The batch calls go further and move their index
+//  once for the whole batch, copying the UserData with at most two memcpys,
+//  one up to the end of the ring and one from its start.
+//
+
+// stdlib provides aligned_alloc and free
+#include <stdlib.h>
+// string provides memcpy for the batch calls
+#include <string.h>
+// asserts are used for checking the arguments
+#include <assert.h>
+// the calls the queue supports are included for consistency checking
+#include "SPSCQueue.h"
+
+// locally called function declarations follow..
+//
+// CopyRing copies NumItems UserData between Items and the ring from the
+// slot for Index on, wrapping round the end of the ring; ToRing says which way
+static void CopyRing (SPSCQueue Q, size_t Index, UserData *Items, int NumItems, bool ToRing);
+
+/*
+ SPSC_Init() allocates the queue on its own cache lines, and its ring with
+ a power of two slots of at least Capacity
+*/
+SPSCQueue SPSC_Init (int Capacity)
+{
+    assert (Capacity > 0);
+    size_t RingSize = 1;
+    while (RingSize < (size_t) Capacity)
+        RingSize *= 2;
+    SPSCQueue Q = (SPSCQueue) aligned_alloc (SPSC_CACHE_LINE, sizeof (SPSCQueueInfo));
+    assert (Q != NULL);
+    MA_Allocated (MA_QUEUE_INFO, sizeof (SPSCQueueInfo));
+    Q->Items = (UserData *) malloc (RingSize * sizeof (UserData));
+    assert (Q->Items != NULL);
+    MA_Allocated (MA_LIST_NODE, RingSize * sizeof (UserData));
+    Q->Mask = RingSize - 1;
+    atomic_init (&Q->Head, 0);
+    atomic_init (&Q->Tail, 0);
+    Q->CachedTail = 0;
+    Q->CachedHead = 0;
+    return Q;
+}
+
+/*
+ SPSC_Delete() frees the ring and the queue.  It returns NULL to indicate
+ that there is no longer a queue
+*/
+SPSCQueue SPSC_Delete (SPSCQueue Q)
+{
+    assert (Q != NULL);
+    free (Q->Items);
+    MA_Released (MA_LIST_NODE, (Q->Mask + 1) * sizeof (UserData));
+    free (Q);
+    MA_Released (MA_QUEUE_INFO, sizeof (SPSCQueueInfo));
+    return NULL;
+}
+
+/*
+ SPSC_TryEnqueue() checks for room against its copy of Head, reading Head
+ again only if the copy says the ring is full, then stores D and moves
+ Tail on
+*/
+bool SPSC_TryEnqueue (SPSCQueue Q, UserData D)
+{
+    assert (Q != NULL);
+    size_t Tail = atomic_load_explicit (&Q->Tail, memory_order_relaxed);
+    if (Tail - Q->CachedHead > Q->Mask) {
+        Q->CachedHead = atomic_load_explicit (&Q->Head, memory_order_acquire);
+        if (Tail - Q->CachedHead > Q->Mask)
+            return false;
+    }
+    Q->Items[Tail & Q->Mask] = D;
+    atomic_store_explicit (&Q->Tail, Tail + 1, memory_order_release);
+    return true;
+}
+
+/*
+ SPSC_TryDequeue() checks for a UserData against its copy of Tail, reading
+ Tail again only if the copy says the ring is empty, then reads the
+ UserData and moves Head on
+*/
+bool SPSC_TryDequeue (SPSCQueue Q, UserData *D)
+{
+    assert ( (Q != NULL) && (D != NULL) );
+    size_t Head = atomic_load_explicit (&Q->Head, memory_order_relaxed);
+    if (Head == Q->CachedTail) {
+        Q->CachedTail = atomic_load_explicit (&Q->Tail, memory_order_acquire);
+        if (Head == Q->CachedTail)
+            return false;
+    }
+    *D = Q->Items[Head & Q->Mask];
+    atomic_store_explicit (&Q->Head, Head + 1, memory_order_release);
+    return true;
+}
+
+/*
+ SPSC_EnqueueBatch() works out the room there is, from its copy of Head
+ and then from Head itself if the copy does not show room for them all,
+ copies in as many UserData as fit and moves Tail on once
+*/
+int SPSC_EnqueueBatch (SPSCQueue Q, const UserData *Items, int NumItems)
+{
+    assert ( (Q != NULL) && (Items != NULL) && (NumItems >= 0) );
+    size_t Tail = atomic_load_explicit (&Q->Tail, memory_order_relaxed);
+    size_t Room = Q->Mask + 1 - (Tail - Q->CachedHead);
+    if (Room < (size_t) NumItems) {
+        Q->CachedHead = atomic_load_explicit (&Q->Head, memory_order_acquire);
+        Room = Q->Mask + 1 - (Tail - Q->CachedHead);
+    }
+    int Count = (Room < (size_t) NumItems) ? (int) Room : NumItems;
+    if (Count == 0)
+        return 0;
+    CopyRing (Q, Tail, (UserData *) Items, Count, true);
+    atomic_store_explicit (&Q->Tail, Tail + Count, memory_order_release);
+    return Count;
+}
+
+/*
+ SPSC_DequeueBatch() works out how many UserData there are, from its copy
+ of Tail and then from Tail itself if the copy does not show MaxItems,
+ copies out as many as there are up to MaxItems and moves Head on once
+*/
+int SPSC_DequeueBatch (SPSCQueue Q, UserData *Items, int MaxItems)
+{
+    assert ( (Q != NULL) && (Items != NULL) && (MaxItems >= 0) );
+    size_t Head = atomic_load_explicit (&Q->Head, memory_order_relaxed);
+    size_t Ready = Q->CachedTail - Head;
+    if (Ready < (size_t) MaxItems) {
+        Q->CachedTail = atomic_load_explicit (&Q->Tail, memory_order_acquire);
+        Ready = Q->CachedTail - Head;
+    }
+    int Count = (Ready < (size_t) MaxItems) ? (int) Ready : MaxItems;
+    if (Count == 0)
+        return 0;
+    CopyRing (Q, Head, Items, Count, false);
+    atomic_store_explicit (&Q->Head, Head + Count, memory_order_release);
+    return Count;
+}
+
+/*
+ SPSC_Capacity() returns the number of slots in the ring
+*/
+int SPSC_Capacity (SPSCQueue Q)
+{
+    assert (Q != NULL);
+    return (int) (Q->Mask + 1);
+}
+
+/*
+ CopyRing copies the part up to the end of the ring and then, if the
+ UserData wrap round, the rest from the start of the ring
+*/
+void CopyRing (SPSCQueue Q, size_t Index, UserData *Items, int NumItems, bool ToRing)
+{
+    size_t Slot = Index & Q->Mask;
+    size_t First = Q->Mask + 1 - Slot;
+    if (First > (size_t) NumItems)
+        First = NumItems;
+    if (ToRing) {
+        memcpy (&Q->Items[Slot], Items, First * sizeof (UserData));
+        memcpy (Q->Items, Items + First, (NumItems - First) * sizeof (UserData));
+    }
+    else {
+        memcpy (Items, &Q->Items[Slot], First * sizeof (UserData));
+        memcpy (Items + First, Q->Items, (NumItems - First) * sizeof (UserData));
+    }
+}
@@ -0,0 +1,84 @@
+//
+//  SPSCQueue.h
+//
+
+#ifndef SPSCQueue_h
+#define SPSCQueue_h
+
+// SPSCQueue.h declares a bounded queue of UserData for exactly one
+// producer thread and one consumer thread.  Neither ever waits for the
+// other: every call finishes in a fixed number of steps, reporting a full
+// or empty queue instead of blocking, so it is wait-free.  There is no
+// lock, and no compare-and-swap either, since each index has only one
+// thread that writes it.
+//
+//      SPSCQueue Q = SPSC_Init (1024);            // before the threads
+//      ...
+//      if (!SPSC_TryEnqueue (Q, D)) ...           // only in the producer
+//      if (SPSC_TryDequeue (Q, &D)) ...           // only in the consumer
+//      ...
+//      Q = SPSC_Delete (Q);                       // after the threads
+
+// The calls on a queue need to pass or return UserData
+#include "UserData.h"
+// The try calls return a boolean
+#include <stdbool.h>
+// size_t is defined in stddef.h
+#include <stddef.h>
+// the indices are atomics
+#include <stdatomic.h>
+// Verifying allocation / deallocation of dynamic memory is done through
+// the memory account, which also provides AllocationCount for reading
+#include "MemoryAccount.h"
+
+// SPSC_CACHE_LINE is the size of a cache line.  The producer's and the
+// consumer's fields are kept this far apart so that a write by one does
+// not take the cache line away from the other
+#ifndef SPSC_CACHE_LINE
+#define SPSC_CACHE_LINE 64
+#endif
+
+// This is the layout of an SPSC queue.  The UserData are in a ring of
+// Mask + 1 slots.  Head counts the UserData ever dequeued and Tail those
+// ever enqueued, so the queue holds Tail - Head and the next slot to use
+// is the count masked with Mask.  Only the consumer writes Head and only
+// the producer writes Tail.  Each also keeps the last value it read of
+// the other's index, CachedTail and CachedHead, and only reads the
+// other's cache line again when that copy says the queue is empty or full.
+
+typedef struct {
+    // the consumer's cache line
+    _Alignas (SPSC_CACHE_LINE) atomic_size_t Head;
+    size_t                                   CachedTail;
+    // the producer's cache line
+    _Alignas (SPSC_CACHE_LINE) atomic_size_t Tail;
+    size_t                                   CachedHead;
+    // read by both, written by neither after SPSC_Init
+    _Alignas (SPSC_CACHE_LINE) UserData     *Items;
+    size_t                                   Mask;
+} SPSCQueueInfo, *SPSCQueue;
+
+// SPSC_Init() allocates an empty queue with room for Capacity UserData,
+// rounded up to a power of two
+SPSCQueue   SPSC_Init           (int Capacity);
+// SPSC_Delete() frees the queue.  It returns NULL
+SPSCQueue   SPSC_Delete         (SPSCQueue Q);
+// SPSC_TryEnqueue() adds D at the end of the queue and returns true, or
+// returns false if the queue is full.  Only the producer may call it
+bool        SPSC_TryEnqueue     (SPSCQueue Q, UserData D);
+// SPSC_TryDequeue() takes the UserData at the front of the queue into D
+// and returns true, or returns false if the queue is empty.  Only the
+// consumer may call it
+bool        SPSC_TryDequeue     (SPSCQueue Q, UserData *D);
+// SPSC_EnqueueBatch() adds as many of the NumItems UserData in Items as
+// there is room for, in order, and returns how many it added.  Only the
+// producer may call it
+int         SPSC_EnqueueBatch   (SPSCQueue Q, const UserData *Items, int NumItems);
+// SPSC_DequeueBatch() takes up to MaxItems UserData from the front of the
+// queue into Items, in order, and returns how many it took.  Only the
+// consumer may call it
+int         SPSC_DequeueBatch   (SPSCQueue Q, UserData *Items, int MaxItems);
+// SPSC_Capacity() returns the number of UserData the queue has room for
+int         SPSC_Capacity       (SPSCQueue Q);
+
+#endif /* SPSCQueue_h */
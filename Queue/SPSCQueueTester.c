@@ -0,0 +1,147 @@
+//
+//  SPSCQueueTester
+//
+//  This tests the single-producer, single-consumer queue.  It checks that:
+//      On one thread the queue is first in, first out, reports full and
+//          empty, and keeps its order when the UserData wrap round the
+//          end of the ring - uses calls to SPSC_TryEnqueue(),
+//          SPSC_TryDequeue(), SPSC_EnqueueBatch() and SPSC_DequeueBatch()
+//      A producer thread and a consumer thread, each mixing single calls
+//          and batches of random sizes on a small ring, pass every
+//          taskNumber from 0 to NUM_ITEMS - 1 through in order
+//      Nothing is left allocated when the queues are deleted
+//  Each taskNumber that arrives out of turn, and each full or empty
+//  report that is wrong, is an error; with any errors, or a leak, the
+//  program exits with 1.
+
+// printf support
+#include <stdio.h>
+// we use rand_r from stdlib.h, which each thread can call on its own seed
+#include <stdlib.h>
+// the producer and consumer are pthreads
+#include <pthread.h>
+// sched_yield lets a thread that cannot go on give way to the other
+#include <sched.h>
+// we use the SPSC queue, so include its functions that we can call
+#include "SPSCQueue.h"
+
+// The UserData passed between the threads, the ring they use and the
+// largest batch
+#define NUM_ITEMS  2000000
+#define RING_SIZE  64
+#define MAX_BATCH  100
+
+// The queue the threads share and the mismatches found
+static SPSCQueue  TheQueue;
+static atomic_int Errors;
+
+// Producer enqueues the taskNumbers in order, singly and in batches
+static void *Producer (void *Arg);
+
+// Consumer dequeues them, singly and in batches, checking the order
+static void *Consumer (void *Arg);
+
+int main(int argc, const char * argv[]) {
+    // on one thread: fill, check it is full, empty it round the ring
+    SPSCQueue Q = SPSC_Init (5);
+    UserData D = {0};
+    UserData Batch[16];
+    if (SPSC_Capacity (Q) != 8 || SPSC_TryDequeue (Q, &D))
+        atomic_fetch_add (&Errors, 1);
+    int Next = 0, Expected = 0;
+    for (int round = 0; round < 100; round++) {
+        // a few singly, then a batch that may not all fit
+        for (int loop = 0; loop < round % 4; loop++) {
+            D.taskNumber = Next;
+            Next += SPSC_TryEnqueue (Q, D);
+        }
+        int NumBatch = round % 11;
+        for (int loop = 0; loop < NumBatch; loop++)
+            Batch[loop].taskNumber = Next + loop;
+        int Added = SPSC_EnqueueBatch (Q, Batch, NumBatch);
+        Next += Added;
+        if (Added < NumBatch) {
+            D.taskNumber = Next;
+            if (SPSC_TryEnqueue (Q, D))
+                atomic_fetch_add (&Errors, 1);
+        }
+        // take some back singly and some as a batch
+        if (SPSC_TryDequeue (Q, &D) && D.taskNumber != Expected++)
+            atomic_fetch_add (&Errors, 1);
+        int Taken = SPSC_DequeueBatch (Q, Batch, round % 7);
+        for (int loop = 0; loop < Taken; loop++)
+            if (Batch[loop].taskNumber != Expected++)
+                atomic_fetch_add (&Errors, 1);
+    }
+    while (SPSC_TryDequeue (Q, &D))
+        if (D.taskNumber != Expected++)
+            atomic_fetch_add (&Errors, 1);
+    if (Expected != Next)
+        atomic_fetch_add (&Errors, 1);
+    Q = SPSC_Delete (Q);
+    printf ("One thread: %d UserData through, %d errors\n", Next, atomic_load (&Errors));
+
+    // two threads through a small ring, so it is often full and often empty
+    pthread_t ProducerThread, ConsumerThread;
+    TheQueue = SPSC_Init (RING_SIZE);
+    pthread_create (&ProducerThread, NULL, Producer, NULL);
+    pthread_create (&ConsumerThread, NULL, Consumer, NULL);
+    pthread_join (ProducerThread, NULL);
+    pthread_join (ConsumerThread, NULL);
+    TheQueue = SPSC_Delete (TheQueue);
+    printf ("Two threads: %d UserData through a ring of %d\n", NUM_ITEMS, RING_SIZE);
+
+    printf ("Errors: %d, the allocation count is now %d\n", atomic_load (&Errors), AllocationCount);
+    return (Errors == 0 && AllocationCount == 0) ? 0 : 1;
+}
+
+// function Producer sends the taskNumbers in order, each time choosing at
+// random between one at a time and a batch of up to MAX_BATCH.  When the
+// ring is full it yields, since the consumer may be waiting for a CPU
+void *Producer (void *Arg)
+{
+    unsigned int Seed = 1;
+    UserData Batch[MAX_BATCH];
+    int Next = 0;
+    while (Next < NUM_ITEMS) {
+        int Added;
+        if (rand_r (&Seed) % 2 == 0) {
+            UserData D = {Next};
+            Added = SPSC_TryEnqueue (TheQueue, D);
+        }
+        else {
+            int NumBatch = 1 + rand_r (&Seed) % MAX_BATCH;
+            if (NumBatch > NUM_ITEMS - Next)
+                NumBatch = NUM_ITEMS - Next;
+            for (int loop = 0; loop < NumBatch; loop++)
+                Batch[loop].taskNumber = Next + loop;
+            Added = SPSC_EnqueueBatch (TheQueue, Batch, NumBatch);
+        }
+        if (Added == 0)
+            sched_yield ();
+        Next += Added;
+    }
+    return NULL;
+}
+
+// function Consumer takes UserData until it has had them all, checking
+// each is the next taskNumber.  When the ring is empty it yields
+void *Consumer (void *Arg)
+{
+    unsigned int Seed = 2;
+    UserData Batch[MAX_BATCH];
+    int Expected = 0;
+    while (Expected < NUM_ITEMS) {
+        int Taken;
+        if (rand_r (&Seed) % 2 == 0)
+            Taken = SPSC_TryDequeue (TheQueue, &Batch[0]);
+        else
+            Taken = SPSC_DequeueBatch (TheQueue, Batch, 1 + rand_r (&Seed) % MAX_BATCH);
+        if (Taken == 0)
+            sched_yield ();
+        for (int loop = 0; loop < Taken; loop++)
+            if (Batch[loop].taskNumber != Expected++)
+                atomic_fetch_add (&Errors, 1);
+    }
+    return NULL;
+}
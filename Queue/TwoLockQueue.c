@@ -0,0 +1,155 @@
+//
+//  TwoLockQueue.c
+//
+//  The list starts with a dummy node, so it is never empty and the Head and
+//  Tail never have to change together:
+//      - TLQ_Enqueue() links a node after Tail and moves Tail to it, holding
+//        only TailLock
+//      - TLQ_Dequeue() reads the UserData in the node after Head, which
+//        becomes the new dummy, and moves Head to it, holding only HeadLock
+//  The old dummy goes onto the Freed list rather than back to the heap.  A
+//  producer holding TailLock takes nodes from its own Spare list, and when
+//  that runs out it swaps the whole of Freed for NULL and uses that.  Taking
+//  every node at once means a node can never be taken while another thread
+//  is part way through taking it, so the free list needs no ABA protection.
+//  Once the queue has been as long as it gets, it stops allocating.
+//
+
+// stdlib provides aligned_alloc, malloc and free
+#include <stdlib.h>
+// asserts are used for checking the arguments
+#include <assert.h>
+// the calls the queue supports are included for consistency checking
+#include "TwoLockQueue.h"
+
+// locally called function declarations follow..
+//
+// TakeNode returns a node to enqueue, from Spare, Freed or the heap.  It is
+// called with TailLock held
+static TLQNodePtr TakeNode (TwoLockQueue Q);
+
+// FreeChain frees a chain of nodes linked through next
+static void FreeChain (TLQNodePtr theNode);
+
+/*
+ TLQ_Init() allocates the queue on its own cache lines, with a dummy node
+ as both Head and Tail
+*/
+TwoLockQueue TLQ_Init (void)
+{
+    TwoLockQueue Q = (TwoLockQueue) aligned_alloc (TLQ_CACHE_LINE, sizeof (TwoLockQueueInfo));
+    assert (Q != NULL);
+    MA_Allocated (MA_QUEUE_INFO, sizeof (TwoLockQueueInfo));
+    pthread_mutex_init (&Q->HeadLock, NULL);
+    pthread_mutex_init (&Q->TailLock, NULL);
+    atomic_init (&Q->Freed, NULL);
+    Q->Spare = NULL;
+    Q->Head = Q->Tail = TakeNode (Q);
+    atomic_init (&Q->Head->next, NULL);
+    return Q;
+}
+
+/*
+ TLQ_Delete() frees the dummy and the nodes after it, then the free nodes,
+ then the queue.  It returns NULL to indicate that there is no longer a queue
+*/
+TwoLockQueue TLQ_Delete (TwoLockQueue Q)
+{
+    assert (Q != NULL);
+    FreeChain (Q->Head);
+    FreeChain (Q->Spare);
+    FreeChain (atomic_load (&Q->Freed));
+    pthread_mutex_destroy (&Q->HeadLock);
+    pthread_mutex_destroy (&Q->TailLock);
+    free (Q);
+    MA_Released (MA_QUEUE_INFO, sizeof (TwoLockQueueInfo));
+    return NULL;
+}
+
+/*
+ TLQ_Enqueue() fills a node and, holding TailLock, links it after Tail with
+ a release store, so a consumer that sees the link also sees the UserData
+*/
+void TLQ_Enqueue (TwoLockQueue Q, UserData D)
+{
+    assert (Q != NULL);
+    pthread_mutex_lock (&Q->TailLock);
+    TLQNodePtr NewNode = TakeNode (Q);
+    NewNode->Data = D;
+    atomic_store_explicit (&NewNode->next, NULL, memory_order_relaxed);
+    atomic_store_explicit (&Q->Tail->next, NewNode, memory_order_release);
+    Q->Tail = NewNode;
+    pthread_mutex_unlock (&Q->TailLock);
+}
+
+/*
+ TLQ_Dequeue() holds HeadLock while it reads the node after the dummy.  If
+ there is one, its UserData is copied out, it becomes the dummy and the
+ old dummy is pushed onto Freed
+*/
+bool TLQ_Dequeue (TwoLockQueue Q, UserData *D)
+{
+    assert ( (Q != NULL) && (D != NULL) );
+    pthread_mutex_lock (&Q->HeadLock);
+    TLQNodePtr Dummy = Q->Head;
+    TLQNodePtr First = atomic_load_explicit (&Dummy->next, memory_order_acquire);
+    if (First == NULL) {
+        pthread_mutex_unlock (&Q->HeadLock);
+        return false;
+    }
+    *D = First->Data;
+    Q->Head = First;
+    pthread_mutex_unlock (&Q->HeadLock);
+    // no thread can reach the old dummy now, so it can go on the free list
+    TLQNodePtr Freed = atomic_load_explicit (&Q->Freed, memory_order_relaxed);
+    do
+        atomic_store_explicit (&Dummy->next, Freed, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit (&Q->Freed, &Freed, Dummy,
+                                                   memory_order_release, memory_order_relaxed));
+    return true;
+}
+
+/*
+ TLQ_Empty() returns true if there is no node after the dummy
+*/
+bool TLQ_Empty (TwoLockQueue Q)
+{
+    assert (Q != NULL);
+    pthread_mutex_lock (&Q->HeadLock);
+    bool Empty = atomic_load (&Q->Head->next) == NULL;
+    pthread_mutex_unlock (&Q->HeadLock);
+    return Empty;
+}
+
+/*
+ TakeNode takes the first Spare node.  With none left it takes every node
+ on Freed as the new Spare list, and with none there either it mallocs one,
+ updating the memory account
+*/
+TLQNodePtr TakeNode (TwoLockQueue Q)
+{
+    if (Q->Spare == NULL)
+        Q->Spare = atomic_exchange_explicit (&Q->Freed, NULL, memory_order_acquire);
+    if (Q->Spare != NULL) {
+        TLQNodePtr theNode = Q->Spare;
+        Q->Spare = atomic_load_explicit (&theNode->next, memory_order_relaxed);
+        return theNode;
+    }
+    TLQNodePtr NewNode = (TLQNodePtr) malloc (sizeof (TLQNode));
+    assert (NewNode != NULL);
+    MA_Allocated (MA_LIST_NODE, sizeof (TLQNode));
+    return NewNode;
+}
+
+/*
+ FreeChain frees each node of a chain and takes it off the memory account
+*/
+void FreeChain (TLQNodePtr theNode)
+{
+    while (theNode != NULL) {
+        TLQNodePtr nextNode = atomic_load (&theNode->next);
+        free (theNode);
+        MA_Released (MA_LIST_NODE, sizeof (TLQNode));
+        theNode = nextNode;
+    }
+}
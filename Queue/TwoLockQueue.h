@@ -0,0 +1,82 @@
+//
+//  TwoLockQueue.h
+//
+
+#ifndef TwoLockQueue_h
+#define TwoLockQueue_h
+
+// TwoLockQueue.h declares an unbounded queue of UserData that any number
+// of threads can enqueue to and dequeue from at once.  It is the two-lock
+// queue of Michael and Scott: a singly linked list, added to at the Tail
+// and taken from at the Head like Queue.c's, with one lock for each end.
+// The list always starts with a dummy node, so the two ends never share a
+// node that either lock would have to guard, and producers only ever wait
+// for producers and consumers for consumers.
+//
+//      TwoLockQueue Q = TLQ_Init();                // before the threads
+//      ...                                          // in any thread:
+//      TLQ_Enqueue (Q, D);
+//      if (TLQ_Dequeue (Q, &D)) ...
+//      ...
+//      Q = TLQ_Delete (Q);                          // after the threads
+
+// The calls on a queue need to pass or return UserData
+#include "UserData.h"
+// The dequeue and empty calls return a boolean
+#include <stdbool.h>
+// the head and tail locks are pthread mutexes
+#include <pthread.h>
+// the links and the free list are atomics
+#include <stdatomic.h>
+// Verifying allocation / deallocation of dynamic memory is done through
+// the memory account, which also provides AllocationCount for reading
+#include "MemoryAccount.h"
+
+// TLQ_CACHE_LINE is the size of a cache line.  The head end and the tail
+// end are kept this far apart so that a producer and a consumer do not
+// take the same cache line away from each other
+#ifndef TLQ_CACHE_LINE
+#define TLQ_CACHE_LINE 64
+#endif
+
+// A queue node holds UserData and the link to the node behind it.  next is
+// atomic because, when the queue is empty, a consumer reads the dummy's
+// next while a producer sets it.  A node the consumers are done with is
+// kept on a free list, linked through next, for a later enqueue to reuse.
+typedef struct tlqnode
+{
+    UserData                   Data;
+    _Atomic (struct tlqnode *) next;
+} TLQNode, *TLQNodePtr;
+
+// This is the layout of a two-lock queue.  Head is the dummy node and the
+// UserData in the queue are in the nodes after it, up to Tail.  HeadLock
+// guards Head and TailLock guards Tail.  Consumers push the nodes they
+// free onto Freed; a producer that has run out of Spare nodes takes the
+// whole of Freed at once to be its Spare, so each end keeps to its own
+// lock and only meets the other in one atomic swap.
+
+typedef struct {
+    _Alignas (TLQ_CACHE_LINE) pthread_mutex_t HeadLock;
+    TLQNodePtr                               Head;
+    _Atomic (TLQNodePtr)                     Freed;
+    _Alignas (TLQ_CACHE_LINE) pthread_mutex_t TailLock;
+    TLQNodePtr                               Tail;
+    TLQNodePtr                               Spare;
+} TwoLockQueueInfo, *TwoLockQueue;
+
+// TLQ_Init() allocates an empty queue, which is its dummy node alone
+TwoLockQueue    TLQ_Init        (void);
+// TLQ_Delete() frees the queue, the UserData left in it and its free nodes.
+// No other thread may be using the queue.  It returns NULL
+TwoLockQueue    TLQ_Delete      (TwoLockQueue Q);
+// TLQ_Enqueue() adds D at the end of the queue
+void            TLQ_Enqueue     (TwoLockQueue Q, UserData D);
+// TLQ_Dequeue() takes the UserData at the front of the queue into D and
+// returns true, or returns false if the queue was empty
+bool            TLQ_Dequeue     (TwoLockQueue Q, UserData *D);
+// TLQ_Empty() returns true if the queue is empty.  Other threads may change
+// that as soon as it is read
+bool            TLQ_Empty       (TwoLockQueue Q);
+
+#endif /* TwoLockQueue_h */
@@ -0,0 +1,143 @@
+//
+//  TwoLockQueueBenchmark
+//
+//  This program times a producer-consumer workload on one queue shared by
+//  a growing number of threads: half the threads send UserData and the
+//  other half take them, each thread sending or taking OPS_PER_THREAD.
+//  It is run against
+//      the two-lock queue   - TLQ_Enqueue() and TLQ_Dequeue(), senders
+//                             holding the tail lock and takers the head
+//                             lock
+//      the Queue.h queue    - enqueue() and dequeue() with one mutex
+//                             around every call, on the layout picked by
+//                             QUEUE_BACKEND
+//  and reports how many sends and takes a second each way manages, and
+//  checks that the UserData taken add up to those sent.  With one mutex
+//  senders wait for takers and takers for senders; with two locks they
+//  only wait for their own kind, and once the queue has been as long as
+//  it gets neither end goes to malloc or free.
+
+// we use printf from stdio.h
+#include <stdio.h>
+// we use clock_gettime from time.h to time the runs by the wall clock
+#include <time.h>
+// the workers are pthreads
+#include <pthread.h>
+// sched_yield lets a taker that finds the queue empty give way
+#include <sched.h>
+// we use both queues, so include the functions that we can call
+#include "Queue.h"
+#include "TwoLockQueue.h"
+
+// The sends or takes per thread and the most threads
+#define OPS_PER_THREAD  500000
+#define MAX_THREADS     16
+
+// QueueKind says which queue a run uses
+typedef enum { TWO_LOCKS, ONE_MUTEX } QueueKind;
+
+// The queues and the mutex used by the threads of a run
+static TwoLockQueue    TheTwoLockQueue;
+static Queue           TheQueue;
+static pthread_mutex_t TheQueueMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// A Worker's argument says which queue it uses and whether it sends or
+// takes, and gets back the total of the taskNumbers it sent or took
+typedef struct {
+    QueueKind Kind;
+    bool      Sends;
+    long      Total;
+} WorkerArg;
+
+// Worker does OPS_PER_THREAD sends or takes
+static void *Worker (void *Arg);
+
+// TimeRun returns the sends and takes per second for NumThreads threads,
+// counting a mismatch if the totals sent and taken differ
+static double TimeRun (QueueKind Kind, int NumThreads, int *Mismatches);
+
+int main(int argc, const char * argv[]) {
+    int Mismatches = 0;
+    printf ("%8s %22s %22s\n", "threads", "two locks ops/s", "one mutex ops/s");
+    for (int NumThreads = 2; NumThreads <= MAX_THREADS; NumThreads *= 2)
+        printf ("%8d %22.0f %22.0f\n", NumThreads,
+                TimeRun (TWO_LOCKS, NumThreads, &Mismatches), TimeRun (ONE_MUTEX, NumThreads, &Mismatches));
+    if (Mismatches != 0)
+        printf ("%d runs took different UserData from those sent\n", Mismatches);
+    printf ("The allocation count is now %d\n", AllocationCount);
+    return 0;
+}
+
+// function TimeRun starts the threads, half sending and half taking, and
+// times them until they all finish
+double TimeRun (QueueKind Kind, int NumThreads, int *Mismatches)
+{
+    pthread_t Threads[MAX_THREADS];
+    WorkerArg Args[MAX_THREADS];
+    if (Kind == TWO_LOCKS)
+        TheTwoLockQueue = TLQ_Init();
+    else
+        TheQueue = initQueue();
+    struct timespec Start, End;
+    clock_gettime (CLOCK_MONOTONIC, &Start);
+    for (int loop = 0; loop < NumThreads; loop++) {
+        Args[loop].Kind = Kind;
+        Args[loop].Sends = (loop % 2 == 0);
+        Args[loop].Total = 0;
+        pthread_create (&Threads[loop], NULL, Worker, &Args[loop]);
+    }
+    long Sent = 0, Took = 0;
+    for (int loop = 0; loop < NumThreads; loop++) {
+        pthread_join (Threads[loop], NULL);
+        if (Args[loop].Sends)
+            Sent += Args[loop].Total;
+        else
+            Took += Args[loop].Total;
+    }
+    clock_gettime (CLOCK_MONOTONIC, &End);
+    *Mismatches += (Sent != Took);
+    if (Kind == TWO_LOCKS)
+        TheTwoLockQueue = TLQ_Delete (TheTwoLockQueue);
+    else
+        TheQueue = deleteQueue (TheQueue);
+    double Seconds = (End.tv_sec - Start.tv_sec) + (End.tv_nsec - Start.tv_nsec) / 1e9;
+    return (double) NumThreads * OPS_PER_THREAD / Seconds;
+}
+
+// function Worker sends or takes OPS_PER_THREAD UserData, adding up their
+// taskNumbers.  A taker that finds the queue empty yields and tries again.
+// There are as many takers as senders, so every taker gets its
+// OPS_PER_THREAD in the end.
+void *Worker (void *Arg)
+{
+    WorkerArg *Work = (WorkerArg *) Arg;
+    for (int loop = 0; loop < OPS_PER_THREAD; loop++) {
+        UserData D = {loop};
+        if (Work->Kind == TWO_LOCKS) {
+            if (Work->Sends)
+                TLQ_Enqueue (TheTwoLockQueue, D);
+            else
+                while (!TLQ_Dequeue (TheTwoLockQueue, &D))
+                    sched_yield ();
+        }
+        else {
+            bool Done = false;
+            while (!Done) {
+                pthread_mutex_lock (&TheQueueMutex);
+                if (Work->Sends) {
+                    enqueue (TheQueue, D);
+                    Done = true;
+                }
+                else if (!empty (TheQueue)) {
+                    D = dequeue (TheQueue);
+                    Done = true;
+                }
+                pthread_mutex_unlock (&TheQueueMutex);
+                if (!Done)
+                    sched_yield ();
+            }
+        }
+        Work->Total += D.taskNumber;
+    }
+    return NULL;
+}
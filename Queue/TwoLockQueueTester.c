@@ -0,0 +1,145 @@
+//
+//  TwoLockQueueTester
+//
+//  This is a stress test of the two-lock queue.  It checks that:
+//      On one thread the queue is first in, first out and reports empty -
+//          uses calls to TLQ_Enqueue(), TLQ_Dequeue() and TLQ_Empty()
+//      Producers each sending their own numbers to consumers get every
+//          number through exactly once, and each consumer gets each
+//          producer's numbers in the order they were sent
+//      The nodes are recycled - once the threads are done, no more nodes
+//          are live than the queue ever held at once, well short of one
+//          for each number sent
+//      Nothing is left allocated when the queues are deleted
+//  A number lost, doubled or out of order, a wrong empty report and too
+//  many live nodes each count against the queue.  The total is printed,
+//  and the exit status is 1 if it is not 0 or memory was leaked.
+
+// printf support
+#include <stdio.h>
+// the producers and consumers are pthreads
+#include <pthread.h>
+// sched_yield lets a thread that cannot go on give way
+#include <sched.h>
+// we use the two-lock queue, so include its functions that we can call
+#include "TwoLockQueue.h"
+
+// The threads and the numbers each producer sends.  A producer's numbers
+// are Producer * PER_PRODUCER up, and it lets the queue get no longer than
+// MAX_AHEAD numbers past what the consumers have taken
+#define NUM_PRODUCERS  3
+#define NUM_CONSUMERS  3
+#define PER_PRODUCER   300000
+#define NUM_NUMBERS    (NUM_PRODUCERS * PER_PRODUCER)
+#define MAX_AHEAD      1000
+
+// The queue the threads share, the numbers sent and taken and the
+// mismatches found
+static TwoLockQueue TheQueue;
+static atomic_char  Taken[NUM_NUMBERS];
+static atomic_int   NumSent;
+static atomic_int   NumTaken;
+static atomic_int   Errors;
+
+// Producer sends its numbers in order
+static void *Producer (void *Arg);
+
+// Consumer takes numbers until all have been taken
+static void *Consumer (void *Arg);
+
+int main(int argc, const char * argv[]) {
+    // on one thread: fill it, then empty it again, three times round
+    TwoLockQueue Q = TLQ_Init();
+    UserData D = {0};
+    if (!TLQ_Empty (Q) || TLQ_Dequeue (Q, &D))
+        atomic_fetch_add (&Errors, 1);
+    for (int round = 0; round < 3; round++) {
+        for (int loop = 0; loop < 100; loop++) {
+            D.taskNumber = round * 100 + loop;
+            TLQ_Enqueue (Q, D);
+        }
+        if (TLQ_Empty (Q))
+            atomic_fetch_add (&Errors, 1);
+        for (int loop = 0; loop < 100; loop++)
+            if (!TLQ_Dequeue (Q, &D) || D.taskNumber != round * 100 + loop)
+                atomic_fetch_add (&Errors, 1);
+        if (!TLQ_Empty (Q) || TLQ_Dequeue (Q, &D))
+            atomic_fetch_add (&Errors, 1);
+    }
+    // the dummy and the 100 nodes freed are all there is: rounds 2 and 3
+    // reused the nodes round 1 allocated
+    if (MA_LiveCount (MA_LIST_NODE) != 101)
+        atomic_fetch_add (&Errors, 1);
+    Q = TLQ_Delete (Q);
+    printf ("One thread: %d errors\n", atomic_load (&Errors));
+
+    pthread_t Threads[NUM_PRODUCERS + NUM_CONSUMERS];
+    unsigned int Ids[NUM_PRODUCERS + NUM_CONSUMERS];
+    printf ("%d threads send %d numbers to %d threads\n", NUM_PRODUCERS, NUM_NUMBERS, NUM_CONSUMERS);
+    TheQueue = TLQ_Init();
+    for (int loop = 0; loop < NUM_PRODUCERS + NUM_CONSUMERS; loop++) {
+        Ids[loop] = (loop < NUM_PRODUCERS) ? loop : loop - NUM_PRODUCERS;
+        pthread_create (&Threads[loop], NULL, loop < NUM_PRODUCERS ? Producer : Consumer, &Ids[loop]);
+    }
+    for (int loop = 0; loop < NUM_PRODUCERS + NUM_CONSUMERS; loop++)
+        pthread_join (Threads[loop], NULL);
+    int NeverTaken = 0;
+    for (int loop = 0; loop < NUM_NUMBERS; loop++)
+        NeverTaken += (atomic_load (&Taken[loop]) == 0);
+    int LiveNodes = MA_LiveCount (MA_LIST_NODE);
+    printf ("Numbers never taken: %d, nodes live: %d\n", NeverTaken, LiveNodes);
+    if (NeverTaken != 0 || !TLQ_Empty (TheQueue))
+        atomic_fetch_add (&Errors, 1);
+    // a node is only allocated when every node is in the queue or on its
+    // way to the free list: each producer may be one past MAX_AHEAD, each
+    // consumer may be pushing its old dummy, and there is the dummy itself
+    if (LiveNodes > MAX_AHEAD + NUM_PRODUCERS + NUM_CONSUMERS + 1)
+        atomic_fetch_add (&Errors, 1);
+    TheQueue = TLQ_Delete (TheQueue);
+
+    printf ("Errors: %d, the allocation count is now %d\n", atomic_load (&Errors), AllocationCount);
+    return (Errors == 0 && AllocationCount == 0) ? 0 : 1;
+}
+
+// function Producer sends its numbers, yielding whenever the queue is
+// MAX_AHEAD numbers ahead of the consumers
+void *Producer (void *Arg)
+{
+    int First = *(unsigned int *) Arg * PER_PRODUCER;
+    for (int loop = 0; loop < PER_PRODUCER; loop++) {
+        while (atomic_load (&NumSent) - atomic_load (&NumTaken) >= MAX_AHEAD)
+            sched_yield ();
+        UserData D = {First + loop};
+        atomic_fetch_add (&NumSent, 1);
+        TLQ_Enqueue (TheQueue, D);
+    }
+    return NULL;
+}
+
+// function Consumer takes numbers until every number has been taken.  It
+// checks that each number has not been taken before and that the numbers
+// it gets from each producer keep going up
+void *Consumer (void *Arg)
+{
+    int Last[NUM_PRODUCERS];
+    for (int loop = 0; loop < NUM_PRODUCERS; loop++)
+        Last[loop] = -1;
+    while (atomic_load (&NumTaken) < NUM_NUMBERS) {
+        UserData D;
+        if (!TLQ_Dequeue (TheQueue, &D)) {
+            sched_yield ();
+            continue;
+        }
+        atomic_fetch_add (&NumTaken, 1);
+        int Number = D.taskNumber;
+        if (Number < 0 || Number >= NUM_NUMBERS || atomic_fetch_add (&Taken[Number], 1) != 0) {
+            atomic_fetch_add (&Errors, 1);
+            continue;
+        }
+        int From = Number / PER_PRODUCER;
+        if (Number <= Last[From])
+            atomic_fetch_add (&Errors, 1);
+        Last[From] = Number;
+    }
+    return NULL;
+}
@@ -0,0 +1,144 @@
+//
+//  ArrayStack.c
+//
+//  The array stack provides the same calls as Stack.c, declared in Stack.h,
+//  and is used in its place when the stack is built with STACK_ARRAY defined.
+//  Instead of a list node per UserData, the UserData are kept side by side in
+//  one array with the top of the stack at the end, so
+//      - push() checks there is room and stores the UserData after the top
+//      - pop() reads the top and counts it off
+//  The array doubles when it fills and, unless built with STACK_SHRINK_AT set
+//  to 0, halves once it is mostly empty.  Either way it is a realloc, counted
+//  in the memory account as list node storage (the same as the deque's ring
+//  array), so a stack that stays about the same size allocates nothing.
+//
+
+#include <stdlib.h> // stdlib provides malloc, realloc and free
+#include <stdbool.h> // stdbool defines bool
+#include <assert.h> // asserts are used for checking that the stack exists
+#include "Stack.h" // calls the stack supports are included for consistency checking
+
+// Resize is a local function that moves the UserData into an array with
+// room for NewCapacity of them
+static void Resize (Stack S, int NewCapacity);
+
+/*
+ initStack() allocates a stack structure and initializes its contents.
+ The array is not allocated until the first push (or reserveStack) needs it
+*/
+Stack initStack()
+{
+    // allocate a stack structure and abort if the allocation failed
+    Stack S = (Stack) malloc(sizeof(StackInfo));
+    assert (S!= NULL);
+    MA_Allocated (MA_STACK_INFO, sizeof (StackInfo));
+    // we are empty and have no array until an item is pushed
+    S->Items = NULL;
+    S->Count = 0;
+    S->Capacity = 0;
+    S->Reserved = 0;
+    // return the stack to the caller
+    return S;
+}
+
+/*
+ deleteStack() frees the array, if there is one, and then the stack itself.
+ It returns NULL to indicate that there is no longer a stack.
+ */
+Stack deleteStack(Stack S)
+{
+    assert (S != NULL);
+    if (S->Items != NULL) {
+        free (S->Items);
+        MA_Released (MA_LIST_NODE, S->Capacity * sizeof (UserData));
+    }
+    free (S);
+    MA_Released (MA_STACK_INFO, sizeof (StackInfo));
+    return NULL;
+}
+
+/*
+  empty() returns true when there is nothing on the stack
+ */
+bool empty (Stack S)
+{
+    assert (S != NULL);
+    return S->Count == 0;
+}
+
+/* push() stores the UserData just after the top, first doubling the array
+   if it is full
+*/
+void push (Stack S, UserData D)
+{
+    assert (S != NULL);
+    if (S->Count == S->Capacity)
+        Resize (S, (S->Capacity == 0) ? STACK_INITIAL_CAPACITY : S->Capacity * 2);
+    S->Items[S->Count++] = D;
+}
+
+/*
+   pop() returns the UserData at the top and counts it off the stack.  If that
+   leaves the array no more than 1 / STACK_SHRINK_AT full, the array is halved,
+   but never below STACK_INITIAL_CAPACITY or the room reserved by the caller.
+*/
+UserData pop (Stack S)
+{
+    assert ( (S != NULL) && (S->Count > 0) );
+    UserData D = S->Items[--S->Count];
+    if (STACK_SHRINK_AT > 0 && S->Count <= S->Capacity / STACK_SHRINK_AT) {
+        int NewCapacity = S->Capacity / 2;
+        if (NewCapacity >= STACK_INITIAL_CAPACITY && NewCapacity >= S->Reserved)
+            Resize (S, NewCapacity);
+    }
+    return D;
+}
+/*
+   peek() returns the UserData at the top of the stack, leaving it there
+*/
+UserData    peek (Stack S)
+{
+    assert ( (S != NULL) && (S->Count > 0) );
+    return S->Items[S->Count - 1];
+}
+
+/*
+   peekPtr() returns the address of the UserData at the top of the stack
+   without copying it.  A push may move the array, so the address is only
+   good until the next push or pop
+*/
+UserData   *peekPtr (Stack S)
+{
+    assert ( (S != NULL) && (S->Count > 0) );
+    return &S->Items[S->Count - 1];
+}
+
+/*
+   reserveStack() grows the array to room for at least n UserData, so the
+   next pushes up to n need no allocation, and stops pop() from shrinking it
+   below that
+*/
+void        reserveStack (Stack S, int n)
+{
+    assert ( (S != NULL) && (n >= 0) );
+    S->Reserved = n;
+    if (n > S->Capacity)
+        Resize (S, n);
+}
+
+/*
+   Resize moves the UserData into an array of NewCapacity, which is a realloc
+   of the one there is (or a first allocation), and updates the memory account
+*/
+void Resize (Stack S, int NewCapacity)
+{
+    assert (NewCapacity >= S->Count);
+    UserData *NewItems = (UserData *) realloc (S->Items, NewCapacity * sizeof (UserData));
+    assert (NewItems != NULL);
+    if (S->Items == NULL)
+        MA_Allocated (MA_LIST_NODE, NewCapacity * sizeof (UserData));
+    else
+        MA_Resized (MA_LIST_NODE, S->Capacity * sizeof (UserData), NewCapacity * sizeof (UserData));
+    S->Items = NewItems;
+    S->Capacity = NewCapacity;
+}
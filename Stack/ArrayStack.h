@@ -0,0 +1,49 @@
+//
+//  ArrayStack.h
+//
+
+#ifndef ArrayStack_h
+#define ArrayStack_h
+
+// ArrayStack.h is included by Stack.h when the stack is built with
+// STACK_ARRAY defined.  It describes how the array stack stores UserData;
+// the functions used to work with the stack are still the ones declared
+// in Stack.h
+
+#include "UserData.h" // The stack holds UserData
+#include <stdbool.h> // The stack empty() call returns a boolean
+// Verifying allocation / deallocation of dynamic memory is done through
+// the memory account, which also provides AllocationCount for reading
+#include "MemoryAccount.h"
+
+// STACK_INITIAL_CAPACITY is the number of UserData the array first has
+// room for; it doubles each time it fills.  It can be changed at build
+// time with -DSTACK_INITIAL_CAPACITY=n
+#ifndef STACK_INITIAL_CAPACITY
+#define STACK_INITIAL_CAPACITY 16
+#endif
+
+// STACK_SHRINK_AT controls giving memory back: once a pop leaves no more
+// than 1 / STACK_SHRINK_AT of the array in use, the array is halved.
+// Halving at a quarter full leaves the array half full, so pushing and
+// popping around that point cannot grow and shrink it on every call.
+// Building with -DSTACK_SHRINK_AT=0 never shrinks the array.
+#ifndef STACK_SHRINK_AT
+#define STACK_SHRINK_AT 4
+#endif
+
+/*
+ *This is the layout of an array stack.  The UserData are kept side by
+ *side in Items, with the top of the stack at Items[Count - 1].  Capacity
+ *is the number of UserData Items has room for.  Reserved is the room
+ *last asked for with reserveStack(); the array never shrinks below it.
+*/
+
+typedef struct {
+    UserData *Items;
+    int       Count;
+    int       Capacity;
+    int       Reserved;
+} StackInfo, *Stack;
+
+#endif /* ArrayStack_h */
@@ -65,17 +65,14 @@ nodes in the linked list started by "head" and ending at "tail".
 */
 #include "LinkedList.h"
 
-// To make sure we are allocating and deallocating dynamic memory,
-// variable AllocationCount is declared within the LinkedList code
-// and is referenced by any other code that does dynamic memory
-// allocation and deallocation
-int AllocationCount = 0;
-
 // Locally called function declarations to follow
 
 // MakeNode are called to allocate and initialize a node using the UserData
 static NodePtr MakeNode (UserData theData);
 
+// MakeEmptyNode is called to allocate a node whose UserData the caller fills in
+static NodePtr MakeEmptyNode (void);
+
 // GetNodeAddress is used to return a pointer of an LL node, given an index
 // It will return the address of the node w/o changing its value
 static NodePtr GetNodeAddress (LLInfoPtr LLI_Ptr, int FetchIndex);
@@ -84,7 +81,7 @@ static NodePtr GetNodeAddress (LLInfoPtr LLI_Ptr, int FetchIndex);
 
 /*
 // LL_Init is used to allocate and initialize a LinkedList
-// Information structure.  It will update the AllocationCount
+// Information structure.  It will update the memory account
 // to reflect the malloc of the struct and return the pointer
 // to the struct for the caller to use when calling any
 // other function in the linked list
@@ -98,8 +95,8 @@ LLInfoPtr LL_Init()
     LLI_Ptr->Head = NULL;
     LLI_Ptr->Tail = NULL;
     LLI_Ptr->NumNodesInList = 0;
-    // update AllocationCount to reflect the malloc
-    AllocationCount++;
+    // update the memory account to reflect the malloc
+    MA_Allocated (MA_LL_INFO, sizeof (LLInfo));
     // return the pointer to the allocated struct to the caller
     return LLI_Ptr;
 }
@@ -110,7 +107,7 @@ LLInfoPtr LL_Init()
 // It does so by simply calling LL_GetFront to read
 // each node with a delete option.  Once all the nodes
 // have been deleted, it frees the memory associated with
-// the LinkedList information struct and updates the AllocationCount
+// the LinkedList information struct and updates the memory account
 // to reflect the memory release.
 /////////////
 LLInfoPtr LL_Delete(LLInfoPtr LLI_Ptr)
@@ -127,9 +124,9 @@ LLInfoPtr LL_Delete(LLInfoPtr LLI_Ptr)
     // structure itself
     free(LLI_Ptr);
     LLI_Ptr = NULL;
-    // Update the AllocationCount to reflect the
+    // Update the memory account to reflect the
     // dealloction of the Information structure
-    AllocationCount--;
+    MA_Released (MA_LL_INFO, sizeof (LLInfo));
     // return a NULL because the list structure no longer exists
     return NULL;
 
@@ -251,8 +248,8 @@ UserData LL_GetFront (LLInfoPtr LLI_Ptr, ShouldDelete Choice)
         if (LLI_Ptr->NumNodesInList == 0)
             LLI_Ptr->Head = LLI_Ptr->Tail = NULL;
         // because a node has been freed, update the
-        // allocation count in the list
-        AllocationCount--;
+        // memory account
+        MA_Released (MA_LIST_NODE, sizeof (Node));
     }
     // return the user data that has been read from the start
     // of the linked list
@@ -336,26 +333,103 @@ void  LL_Swap (LLInfoPtr LLI_Ptr, int Index1, int Index2)
     return;
 }
 
+/////////////
+// LL_PeekFrontPtr returns the address of the UserData at the front
+// of the LL instead of a copy of it, so a large UserData is not copied
+// just to be looked at.  The caller may read or update the UserData
+// through the address, which is good until that node is deleted.
+/////////////
+UserData *LL_PeekFrontPtr (LLInfoPtr LLI_Ptr)
+{
+    // Make sure the LL exists and has a node at the front
+    assert (LLI_Ptr != NULL);
+    assert (LLI_Ptr->Head != NULL);
+    return &LLI_Ptr->Head->Data;
+}
+
+/////////////
+// LL_AtIndexPtr returns the address of the UserData at the specified
+// index in the underlying LL, instead of a copy of it.  Like
+// LL_PeekFrontPtr, the address is good until that node is deleted.
+/////////////
+UserData *LL_AtIndexPtr (LLInfoPtr LLI_Ptr, int FetchIndex)
+{
+    // Make sure the LL exists and the index is valid
+    assert (LLI_Ptr != NULL);
+    assert ((FetchIndex >= 0) && (FetchIndex < LLI_Ptr->NumNodesInList) );
+    return &GetNodeAddress(LLI_Ptr, FetchIndex)->Data;
+}
+
+/////////////
+// LL_EmplaceFront adds a node to the front of the LL, like
+// LL_AddAtFront, but rather than copying in UserData passed by value
+// it returns the address of the new node's UserData for the caller to
+// fill in place.  Until the caller does, the UserData holds whatever
+// was in the node's memory.
+/////////////
+UserData *LL_EmplaceFront (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    NodePtr NewNode = MakeEmptyNode();
+    NewNode->next = LLI_Ptr->Head;
+    if (LLI_Ptr->Head != NULL)
+        LLI_Ptr->Head->prev = NewNode;
+    else
+        LLI_Ptr->Tail = NewNode;
+    LLI_Ptr->Head = NewNode;
+    LLI_Ptr->NumNodesInList++;
+    return &NewNode->Data;
+}
+
+/////////////
+// LL_EmplaceEnd adds a node to the end of the LL, like LL_AddAtEnd,
+// and returns the address of its UserData for the caller to fill in
+/////////////
+UserData *LL_EmplaceEnd (LLInfoPtr LLI_Ptr)
+{
+    assert (LLI_Ptr != NULL);
+    NodePtr NewNode = MakeEmptyNode();
+    NewNode->prev = LLI_Ptr->Tail;
+    if (LLI_Ptr->Tail != NULL)
+        LLI_Ptr->Tail->next = NewNode;
+    else
+        LLI_Ptr->Head = NewNode;
+    LLI_Ptr->Tail = NewNode;
+    LLI_Ptr->NumNodesInList++;
+    return &NewNode->Data;
+}
+
 /////////////
 // Local function MakeNode allocates and initializes a Node for placement
 // in the LL.  It copies over the user data into the allocated node and NULLs the
 // node's "next" link.
 /////////////
 NodePtr MakeNode (UserData theData)
+{
+    // get an unlinked node, then copy in the user data without
+    // copying field by field.
+    NodePtr NewNode = MakeEmptyNode();
+    NewNode->Data = theData;
+    return NewNode;
+}
+
+/////////////
+// Local function MakeEmptyNode allocates a Node for placement in the
+// LL and NULLs its "next" and "prev" links.  Its UserData is left for
+// the caller to fill in.
+/////////////
+NodePtr MakeEmptyNode (void)
 {
     // allocate a node to contain the user's data
     // and abort if the allocation fails
     NodePtr NewNode = (NodePtr) malloc (sizeof (Node));
     assert (NewNode != NULL);
-    // allocation worked, copy in the user data without
-    // copying field by field.
-    NewNode->Data = theData;
-    // unless updated by the caller of MakeNode, the "next"
+    // unless updated by the caller, the "next"
     // and "prev" default to NULL
     NewNode->next = NULL;
     NewNode->prev = NULL;
-    // Update the number of allocations to reflect the malloc
-    AllocationCount++;
+    // Update the memory account to reflect the malloc
+    MA_Allocated (MA_LIST_NODE, sizeof (Node));
     // return the pointer to the node ready to link in
     return NewNode;
 }
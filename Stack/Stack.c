@@ -20,7 +20,7 @@ Stack initStack()
     // allocate a stack structure and abort if the allocation failed
     Stack S = (Stack) malloc(sizeof(StackInfo));
     assert (S!= NULL);
-    AllocationCount++;
+    MA_Allocated (MA_STACK_INFO, sizeof (StackInfo));
     // allocate and initialize the underlying linked list
     S->LL = LL_Init();
     // we are empty until an item is pushed
@@ -39,7 +39,7 @@ Stack deleteStack(Stack S)
     assert (S != NULL);
     LL_Delete(S->LL);
     free (S);
-    AllocationCount--;
+    MA_Released (MA_STACK_INFO, sizeof (StackInfo));
     return NULL;
 }
 
@@ -83,3 +83,23 @@ UserData    peek (Stack S)
     assert ( (S != NULL) && (S->empty != true) );
     return LL_GetFront(S->LL, RETAIN_NODE);
 }
+
+/*
+   peekPtr() returns the address of the UserData at the front of the stack
+   without copying it, by calling the linked list LL_PeekFrontPtr()
+*/
+UserData   *peekPtr (Stack S)
+{
+    assert ( (S != NULL) && (S->empty != true) );
+    return LL_PeekFrontPtr(S->LL);
+}
+
+/*
+   reserveStack() has nothing to do for a stack on a linked list, since each
+   push makes room for itself.  It is here so that the same code can use
+   either stack layout.
+*/
+void        reserveStack (Stack S, int n)
+{
+    assert ( (S != NULL) && (n >= 0) );
+}
@@ -6,9 +6,18 @@
 #define Stack_h
 
 #include "UserData.h" // The calls on a stack need to pass or return UserData
-#include "LinkedList.h" // Our stack will use a linked list, so we need to resolve LLInfoPtr
 #include <stdbool.h> // The stack empty() call returns a boolean
 
+// Building with STACK_ARRAY defined selects the array stack, which keeps
+// the UserData in one growable array instead of a linked list, so a push
+// or pop does not allocate or free anything once the array is big enough.
+// Its layout is in ArrayStack.h.  Every function declared below works the
+// same way with either layout.
+#if defined (STACK_ARRAY)
+#include "ArrayStack.h"
+#else
+#include "LinkedList.h" // Our stack will use a linked list, so we need to resolve LLInfoPtr
+
 /*
  *This is the layout of a stack.  Notice that it contains
  *a pointer to our underlying linked list and a simple boolean
@@ -19,6 +28,7 @@ typedef struct {
     LLInfoPtr LL;
     bool empty;
 } StackInfo, *Stack;
+#endif // STACK_ARRAY
 
 // initStack() allocates a stack and initializes it
 Stack       initStack();
@@ -37,6 +47,16 @@ UserData    pop (Stack S);
 // delete it from the stack
 UserData    peek (Stack S);
 
+// peekPtr() returns the address of the UserData on the top of the stack instead
+// of a copy, so a large UserData is not copied just to be looked at.  The address
+// is good until that UserData is popped or, with the deque or array layout, anything
+// else is pushed
+UserData   *peekPtr (Stack S);
+
+// reserveStack() makes sure the stack has room for n UserData without growing, and
+// keeps that room from then on.  A stack on a linked list has nothing to reserve
+void        reserveStack (Stack S, int n);
+
 // deleteStack() deletes the frees the storage that was allocated by the call
 // to initStack()
 Stack       deleteStack(Stack S);
@@ -58,6 +58,8 @@ int main(int argc, const char * argv[]) {
     PrintAllocations ("Before deleteStack called");
     S = deleteStack(S);
     PrintAllocations ("After deleteStack called");
+    // show how much memory the stack needed at its largest
+    MA_Report (stdout);
     return 0;
 }
 
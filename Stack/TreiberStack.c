@@ -0,0 +1,346 @@
+///////////////////////
+//
+// The Treiber stack is a singly linked list with the Top changed only by
+// compare-and-swap, so no thread ever waits for another:
+//      - A push links a node to the Top it read and swings the Top to the
+//        node, reading the Top again if another thread changed it first.
+//      - A pop reads the Top and the node below it and swings the Top to
+//        that node, the same way.
+// The danger in a pop is the ABA problem.  If the Top node is popped and
+// pushed again while a thread is between reading it and swinging the
+// Top, the swing succeeds with a stale node below.  Michael's hazard
+// pointers stop that: a popper publishes the Top node in its hazard
+// pointer and checks it is still the Top before reading it.  A popped
+// node waits on its popper's retired list until no hazard pointer holds
+// it, and only then can it be pushed again.
+//
+// Popped nodes are recycled rather than freed: a scan moves every node
+// no thread holds onto the popper's own Free list, and a push takes a
+// node from there, with no atomics at all, before it tries the shared
+// Spare list and then malloc.  A thread with more than TS_FREE_MAX free
+// nodes hands them to Spare, so threads that mostly pop feed threads
+// that mostly push.  Spare is itself a Treiber stack whose nodes only
+// come back through a scan, so it is safe from ABA the same way.  A stack
+// that stays about the same size soon stops allocating.
+//
+// TakeNode needs the hazard pointer as much as TS_Pop does.  A node a
+// pusher reads at the top of Spare may be taken by another pusher,
+// pushed on the stack, popped, recycled and given back to Spare before
+// the first pusher swings Spare, so popping Spare has the same ABA as
+// popping the stack, and is guarded the same way.  Each thread only ever
+// has one node to guard, so one hazard pointer per thread is enough.
+// The atomics keep the default, sequentially consistent, ordering, as
+// the rest of the code does.  Protect stores the hazard pointer and then
+// loads the Top, and Scan swings the Top and later loads the hazard
+// pointers: each is a store followed by a load of somewhere else, and
+// only sequential consistency stops the load being done first, which
+// would let a pop and a scan each miss what the other did.
+//
+///////////////////////
+
+// stdlib provides malloc and free
+#include <stdlib.h>
+// assert checks the arguments, like the rest of the stack code
+#include <assert.h>
+// TreiberStack.h defines TSNode, TStackInfo and the hazard records
+#include "TreiberStack.h"
+
+// locally called function declarations follow..
+//
+// Protect puts the node at the top of From in the thread's hazard pointer
+// and returns it once it is still the top, or returns NULL if From is empty
+static TSNodePtr Protect (TSHandle Me, _Atomic (TSNodePtr) *From);
+
+// TakeNode returns a node for a push, from the Free list, the Spare list
+// or the heap
+static TSNodePtr TakeNode (TSHandle Me);
+
+// Scan moves every retired node that no hazard pointer holds to Free
+static void Scan (TSHandle Me);
+
+// GiveToSpare pushes the thread's whole Free list onto Spare
+static void GiveToSpare (TSHandle Me);
+
+// FreeChain frees the nodes linked from theNode through next or RetiredNext
+static void FreeChain (TSNodePtr theNode, bool Retired);
+
+/////////////
+// TS_Init allocates and initializes an empty stack.
+// It updates the memory account to reflect the malloc.
+/////////////
+TStack TS_Init (void)
+{
+    TStack S = (TStack) malloc (sizeof (TStackInfo));
+    assert (S != NULL);
+    atomic_init (&S->Top, NULL);
+    atomic_init (&S->Spare, NULL);
+    atomic_init (&S->Records, NULL);
+    MA_Allocated (MA_STACK_INFO, sizeof (TStackInfo));
+    return S;
+}
+
+/////////////
+// TS_Delete frees the nodes still on the stack and on Spare, then every
+// hazard record with the nodes retired and free on it, then the stack
+// itself.  It is only called once every thread has detached, so every
+// hazard pointer is clear and the chains can be freed as they stand.
+/////////////
+TStack TS_Delete (TStack S)
+{
+    assert (S != NULL);
+    FreeChain (atomic_load (&S->Top), false);
+    FreeChain (atomic_load (&S->Spare), false);
+    TSHandle Record = atomic_load (&S->Records);
+    while (Record != NULL) {
+        assert (!atomic_load (&Record->Active));
+        TSHandle nextRecord = Record->next;
+        FreeChain (Record->Retired, true);
+        FreeChain (Record->Free, false);
+        free (Record);
+        MA_Released (MA_STACK_INFO, sizeof (TSRecord));
+        Record = nextRecord;
+    }
+    free (S);
+    MA_Released (MA_STACK_INFO, sizeof (TStackInfo));
+    return NULL;
+}
+
+/////////////
+// TS_Attach hands the calling thread a hazard record, claiming the first
+// one a detached thread gave back, along with any popped nodes and free
+// nodes it left there, or else pushing a new record onto the stack's
+// records.  Scan walks the records without a lock, so they stay until
+// TS_Delete.
+/////////////
+TSHandle TS_Attach (TStack S)
+{
+    assert (S != NULL);
+    for (TSHandle Record = atomic_load (&S->Records); Record != NULL; Record = Record->next) {
+        bool Idle = false;
+        if (!atomic_load (&Record->Active)
+                && atomic_compare_exchange_strong (&Record->Active, &Idle, true))
+            return Record;
+    }
+    TSHandle Record = (TSHandle) malloc (sizeof (TSRecord));
+    assert (Record != NULL);
+    atomic_init (&Record->Hazard, NULL);
+    atomic_init (&Record->Active, true);
+    Record->S = S;
+    Record->Retired = NULL;
+    Record->NumRetired = 0;
+    Record->Free = NULL;
+    Record->NumFree = 0;
+    MA_Allocated (MA_STACK_INFO, sizeof (TSRecord));
+    Record->next = atomic_load (&S->Records);
+    while (!atomic_compare_exchange_weak (&S->Records, &Record->next, Record))
+        ;
+    return Record;
+}
+
+/////////////
+// TS_Detach clears the thread's hazard pointer, recycles the popped nodes
+// no other thread still guards and hands all of its free nodes to Spare,
+// where the threads still pushing can take them.  Popped nodes another
+// thread still guards stay on the record until it is claimed again or
+// the stack is deleted.
+/////////////
+void TS_Detach (TSHandle Me)
+{
+    assert (Me != NULL);
+    atomic_store (&Me->Hazard, NULL);
+    Scan (Me);
+    GiveToSpare (Me);
+    atomic_store (&Me->Active, false);
+}
+
+/////////////
+// TS_Push links a node holding D above the Top it read and swings the
+// Top to it, reading the Top again each time another thread got there
+// first.  The new node is not shared until the swing succeeds, so the
+// Top it links to needs no protection.
+/////////////
+void TS_Push (TSHandle Me, UserData D)
+{
+    assert (Me != NULL);
+    TSNodePtr NewNode = TakeNode (Me);
+    NewNode->Data = D;
+    TSNodePtr Top = atomic_load (&Me->S->Top);
+    do
+        atomic_store (&NewNode->next, Top);
+    while (!atomic_compare_exchange_weak (&Me->S->Top, &Top, NewNode));
+}
+
+/////////////
+// TS_Pop protects the Top node, reads the node below it and swings the
+// Top down to that node.  The hazard pointer keeps the Top node from
+// being recycled, so if the swing succeeds the node below was really
+// below it.  The popped node's UserData is copied out, and the node then
+// waits on the thread's retired list, which is scanned every TS_SCAN_AT
+// pops.
+/////////////
+bool TS_Pop (TSHandle Me, UserData *D)
+{
+    assert ( (Me != NULL) && (D != NULL) );
+    for (;;) {
+        TSNodePtr Top = Protect (Me, &Me->S->Top);
+        if (Top == NULL)
+            return false;
+        TSNodePtr Below = atomic_load (&Top->next);
+        if (atomic_compare_exchange_strong (&Me->S->Top, &Top, Below)) {
+            *D = Top->Data;
+            atomic_store (&Me->Hazard, NULL);
+            Top->RetiredNext = Me->Retired;
+            Me->Retired = Top;
+            if (++Me->NumRetired >= TS_SCAN_AT)
+                Scan (Me);
+            return true;
+        }
+    }
+}
+
+/////////////
+// TS_Peek copies the UserData of the Top node while its hazard pointer
+// still protects it
+/////////////
+bool TS_Peek (TSHandle Me, UserData *D)
+{
+    assert ( (Me != NULL) && (D != NULL) );
+    TSNodePtr Top = Protect (Me, &Me->S->Top);
+    if (Top != NULL)
+        *D = Top->Data;
+    atomic_store (&Me->Hazard, NULL);
+    return Top != NULL;
+}
+
+/////////////
+// TS_Empty returns true if there is no Top node
+/////////////
+bool TS_Empty (TStack S)
+{
+    assert (S != NULL);
+    return atomic_load (&S->Top) == NULL;
+}
+
+/////////////
+// Local function Protect reads the node at the top of From, puts it in
+// the hazard pointer and reads From again.  Only if it is still the same
+// node was it published before anyone could retire it, so it is safe to
+// read until the hazard pointer is cleared; if not, it tries again.
+/////////////
+TSNodePtr Protect (TSHandle Me, _Atomic (TSNodePtr) *From)
+{
+    TSNodePtr theNode = atomic_load (From);
+    for (;;) {
+        if (theNode == NULL) {
+            atomic_store (&Me->Hazard, NULL);
+            return NULL;
+        }
+        atomic_store (&Me->Hazard, theNode);
+        TSNodePtr Again = atomic_load (From);
+        if (Again == theNode)
+            return theNode;
+        theNode = Again;
+    }
+}
+
+/////////////
+// Local function TakeNode takes the first node of the thread's Free list.
+// If that is empty it pops a node off the Spare list, the same way TS_Pop
+// takes one off the stack, or mallocs one if Spare is empty too.
+// It updates the memory account to reflect a malloc.
+/////////////
+TSNodePtr TakeNode (TSHandle Me)
+{
+    if (Me->Free != NULL) {
+        TSNodePtr theNode = Me->Free;
+        Me->Free = atomic_load (&theNode->next);
+        Me->NumFree--;
+        return theNode;
+    }
+    for (;;) {
+        TSNodePtr theNode = Protect (Me, &Me->S->Spare);
+        if (theNode == NULL)
+            break;
+        TSNodePtr Below = atomic_load (&theNode->next);
+        if (atomic_compare_exchange_strong (&Me->S->Spare, &theNode, Below)) {
+            atomic_store (&Me->Hazard, NULL);
+            return theNode;
+        }
+    }
+    TSNodePtr NewNode = (TSNodePtr) malloc (sizeof (TSNode));
+    assert (NewNode != NULL);
+    NewNode->RetiredNext = NULL;
+    MA_Allocated (MA_LIST_NODE, sizeof (TSNode));
+    return NewNode;
+}
+
+/////////////
+// Local function Scan goes through the records once.  A record guards
+// at most one node, so the node each hazard pointer holds is taken out
+// of the retired list and kept back.  Every node left on the retired
+// list then has no thread that can still reach it from the stack or
+// Spare, so the lot moves onto Free.  If that makes Free longer than
+// TS_FREE_MAX, it is all handed to Spare.
+/////////////
+void Scan (TSHandle Me)
+{
+    TSNodePtr Held = NULL;
+    int NumHeld = 0;
+    for (TSHandle Record = atomic_load (&Me->S->Records); Record != NULL; Record = Record->next) {
+        TSNodePtr Guarded = atomic_load (&Record->Hazard);
+        if (Guarded == NULL)
+            continue;
+        for (TSNodePtr *Link = &Me->Retired; *Link != NULL; Link = &(*Link)->RetiredNext)
+            if (*Link == Guarded) {
+                *Link = Guarded->RetiredNext;
+                Guarded->RetiredNext = Held;
+                Held = Guarded;
+                NumHeld++;
+                break;
+            }
+    }
+    while (Me->Retired != NULL) {
+        TSNodePtr theNode = Me->Retired;
+        Me->Retired = theNode->RetiredNext;
+        atomic_store (&theNode->next, Me->Free);
+        Me->Free = theNode;
+        Me->NumFree++;
+    }
+    Me->Retired = Held;
+    Me->NumRetired = NumHeld;
+    if (Me->NumFree > TS_FREE_MAX)
+        GiveToSpare (Me);
+}
+
+/////////////
+// Local function GiveToSpare finds the last of the thread's free nodes
+// and links the whole Free list above the first Spare node in one swing
+/////////////
+void GiveToSpare (TSHandle Me)
+{
+    if (Me->Free == NULL)
+        return;
+    TSNodePtr Last = Me->Free;
+    while (atomic_load (&Last->next) != NULL)
+        Last = atomic_load (&Last->next);
+    TSNodePtr Spare = atomic_load (&Me->S->Spare);
+    do
+        atomic_store (&Last->next, Spare);
+    while (!atomic_compare_exchange_weak (&Me->S->Spare, &Spare, Me->Free));
+    Me->Free = NULL;
+    Me->NumFree = 0;
+}
+
+/////////////
+// Local function FreeChain frees a chain of nodes that no thread can
+// reach, following RetiredNext if Retired is true or next if not
+/////////////
+void FreeChain (TSNodePtr theNode, bool Retired)
+{
+    while (theNode != NULL) {
+        TSNodePtr nextNode = Retired ? theNode->RetiredNext : atomic_load (&theNode->next);
+        free (theNode);
+        MA_Released (MA_LIST_NODE, sizeof (TSNode));
+        theNode = nextNode;
+    }
+}
@@ -0,0 +1,121 @@
+//
+//  TreiberStack.h
+//
+
+#ifndef TreiberStack_h
+#define TreiberStack_h
+
+// TreiberStack.h declares a stack of UserData that any number of threads
+// can push onto, pop from and peek at at once without any locks.  It is a
+// Treiber stack: a singly linked list whose top is only ever changed by
+// compare-and-swap.
+//
+// A thread that uses the stack first attaches to it and then passes the
+// TSHandle it gets to every call; the handle holds the thread's hazard
+// pointer, which keeps the node it is looking at from being reused under
+// it.  That is also what stops the ABA problem: a node popped by one
+// thread cannot come back to the top while another thread is still about
+// to compare-and-swap against it.
+//
+//      TStack S = TS_Init();                        // before the threads
+//      ...                                          // in each thread:
+//      TSHandle Me = TS_Attach (S);
+//      TS_Push (Me, D);
+//      if (TS_Pop (Me, &D)) ...
+//      TS_Detach (Me);
+//      ...
+//      S = TS_Delete (S);                           // after the threads
+
+#include "UserData.h" // The calls on a stack need to pass or return UserData
+#include <stdbool.h> // The pop, peek and empty calls return a boolean
+#include <stdatomic.h> // the links and hazard pointers are atomics
+// Verifying allocation / deallocation of dynamic memory is done through
+// the memory account, which also provides AllocationCount for reading
+#include "MemoryAccount.h"
+
+// TS_SCAN_AT is the number of popped nodes a thread holds on to before
+// it checks the hazard pointers to see which it can recycle
+#ifndef TS_SCAN_AT
+#define TS_SCAN_AT 64
+#endif
+
+// TS_FREE_MAX is the number of recycled nodes a thread keeps for its own
+// pushes; past that they go to the Spare list for the other threads
+#ifndef TS_FREE_MAX
+#define TS_FREE_MAX (2 * TS_SCAN_AT)
+#endif
+
+/*
+ *A stack node holds UserData and the link to the node below it.  Popped
+ *nodes are not freed but recycled for later pushes: once no hazard
+ *pointer holds one, it goes onto its popper's Free list or the stack's
+ *Spare list, linked through next the same way.  RetiredNext chains a
+ *popped node into its popper's retired list until then.
+*/
+typedef struct tsnode
+{
+    UserData                  Data;
+    _Atomic (struct tsnode *) next;
+    struct tsnode            *RetiredNext;
+} TSNode, *TSNodePtr;
+
+/*
+ *Each attached thread has a hazard record while Active is set.  Hazard is
+ *the node at the top of the stack, or of Spare, that the thread is about
+ *to read, and no scan recycles it meanwhile.  The nodes the thread popped
+ *wait in Retired until no hazard pointer holds them, and then in Free
+ *until the thread pushes with them.
+*/
+typedef struct tsrecord
+{
+    _Atomic (TSNodePtr)  Hazard;
+    atomic_bool          Active;
+    struct tsrecord     *next;
+    struct tstackinfo   *S;
+    TSNodePtr            Retired;
+    int                  NumRetired;
+    TSNodePtr            Free;
+    int                  NumFree;
+} TSRecord, *TSHandle;
+
+/*
+ *This is the layout of a Treiber stack: the Top node, the Spare nodes
+ *ready to be pushed again and the hazard records of every thread that has
+ *attached
+*/
+typedef struct tstackinfo
+{
+    _Atomic (TSNodePtr)  Top;
+    _Atomic (TSNodePtr)  Spare;
+    _Atomic (TSHandle)   Records;
+} TStackInfo, *TStack;
+
+// TS_Init() allocates an empty stack
+TStack      TS_Init     (void);
+
+// TS_Delete() frees the stack, its nodes and its hazard records.  Every
+// thread must have detached.  It returns NULL
+TStack      TS_Delete   (TStack S);
+
+// TS_Attach() returns the calling thread's handle on the stack
+TSHandle    TS_Attach   (TStack S);
+
+// TS_Detach() gives the handle back; the thread must not use it again
+void        TS_Detach   (TSHandle Me);
+
+// TS_Push() places the UserData on the top of the stack
+void        TS_Push     (TSHandle Me, UserData D);
+
+// TS_Pop() takes the UserData off the top of the stack into D and returns
+// true, or returns false if the stack was empty
+bool        TS_Pop      (TSHandle Me, UserData *D);
+
+// TS_Peek() copies the UserData on the top of the stack into D, leaving it
+// there, and returns true, or returns false if the stack was empty
+bool        TS_Peek     (TSHandle Me, UserData *D);
+
+// TS_Empty() returns true if the stack is empty.  Other threads may change
+// that as soon as it is read
+bool        TS_Empty    (TStack S);
+
+#endif /* TreiberStack_h */
@@ -0,0 +1,116 @@
+//
+//  TreiberStackBenchmark
+//
+//  This program times a free-work pool on one stack shared by 1 up to
+//  MAX_THREADS threads: each thread pushes an item and pops one, over and
+//  over, the way workers hand work back and take it out again.  It is
+//  run against
+//      the Treiber stack - TS_Push() and TS_Pop(), which never lock
+//      the Stack.h stack - push() and pop() with one mutex around every
+//                          call, on the layout picked by STACK_BACKEND
+//  The stack starts with PREFILL items so that a pop always finds one,
+//  and the run reports how many pushes and pops a second each way
+//  manages.  With the mutex a thread that is switched out while holding
+//  it holds up every other thread; the Treiber stack's threads only ever
+//  retry a compare-and-swap.  After its first pushes the Treiber stack
+//  takes recycled nodes rather than allocating new ones.
+
+// we use printf from stdio.h
+#include <stdio.h>
+// we use clock_gettime from time.h to time the runs by the wall clock
+#include <time.h>
+// the workers are pthreads
+#include <pthread.h>
+// we use both stacks, so include the functions that we can call
+#include "Stack.h"
+#include "TreiberStack.h"
+
+// The items on the stack to start with and the push and pop pairs per thread
+#define PREFILL            1000
+#define PAIRS_PER_THREAD   500000
+#define MAX_THREADS        8
+
+// StackKind says which stack a run uses
+typedef enum { TREIBER, ONE_MUTEX } StackKind;
+
+// The stacks and the mutex used by the threads of a run
+static TStack          TheTStack;
+static Stack           TheStack;
+static pthread_mutex_t TheStackMutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Worker does PAIRS_PER_THREAD pushes and pops on the stack of its kind
+static void *Worker (void *Arg);
+
+// TimeRun returns the pushes and pops per second for NumThreads threads
+static double TimeRun (StackKind Kind, int NumThreads);
+
+int main(int argc, const char * argv[]) {
+    printf ("%8s %22s %22s\n", "threads", "Treiber ops/s", "one mutex ops/s");
+    for (int NumThreads = 1; NumThreads <= MAX_THREADS; NumThreads *= 2)
+        printf ("%8d %22.0f %22.0f\n", NumThreads,
+                TimeRun (TREIBER, NumThreads), TimeRun (ONE_MUTEX, NumThreads));
+    printf ("The allocation count is now %d\n", AllocationCount);
+    return 0;
+}
+
+// function TimeRun fills a stack with PREFILL items, starts the threads
+// and times them until they all finish
+double TimeRun (StackKind Kind, int NumThreads)
+{
+    pthread_t Threads[MAX_THREADS];
+    StackKind Kinds[MAX_THREADS];
+    UserData D = {0};
+    if (Kind == TREIBER) {
+        TheTStack = TS_Init();
+        TSHandle Me = TS_Attach (TheTStack);
+        for (int loop = 0; loop < PREFILL; loop++)
+            TS_Push (Me, D);
+        TS_Detach (Me);
+    }
+    else {
+        TheStack = initStack();
+        for (int loop = 0; loop < PREFILL; loop++)
+            push (TheStack, D);
+    }
+    struct timespec Start, End;
+    clock_gettime (CLOCK_MONOTONIC, &Start);
+    for (int loop = 0; loop < NumThreads; loop++) {
+        Kinds[loop] = Kind;
+        pthread_create (&Threads[loop], NULL, Worker, &Kinds[loop]);
+    }
+    for (int loop = 0; loop < NumThreads; loop++)
+        pthread_join (Threads[loop], NULL);
+    clock_gettime (CLOCK_MONOTONIC, &End);
+    if (Kind == TREIBER)
+        TheTStack = TS_Delete (TheTStack);
+    else
+        TheStack = deleteStack (TheStack);
+    double Seconds = (End.tv_sec - Start.tv_sec) + (End.tv_nsec - Start.tv_nsec) / 1e9;
+    return 2.0 * NumThreads * PAIRS_PER_THREAD / Seconds;
+}
+
+// function Worker pushes an item and pops one PAIRS_PER_THREAD times.
+// Every thread pushes before it pops, so the stack never runs dry.
+void *Worker (void *Arg)
+{
+    StackKind Kind = *(StackKind *) Arg;
+    UserData D = {0};
+    if (Kind == TREIBER) {
+        TSHandle Me = TS_Attach (TheTStack);
+        for (int loop = 0; loop < PAIRS_PER_THREAD; loop++) {
+            TS_Push (Me, D);
+            TS_Pop (Me, &D);
+        }
+        TS_Detach (Me);
+    }
+    else
+        for (int loop = 0; loop < PAIRS_PER_THREAD; loop++) {
+            pthread_mutex_lock (&TheStackMutex);
+            push (TheStack, D);
+            pthread_mutex_unlock (&TheStackMutex);
+            pthread_mutex_lock (&TheStackMutex);
+            D = pop (TheStack);
+            pthread_mutex_unlock (&TheStackMutex);
+        }
+    return NULL;
+}
@@ -0,0 +1,144 @@
+//
+//  TreiberStackTester
+//
+//  This is a stress test of the Treiber stack, run from several threads
+//  at once on one stack.  It checks that:
+//      One thread on its own gets the UserData back last in, first out -
+//          uses calls to TS_Push(), TS_Peek(), TS_Pop() and TS_Empty()
+//      Threads each pushing their own nums and popping at random - uses
+//          calls to TS_Push() and TS_Pop() - between them pop every num
+//          exactly once, counting the ones left on the stack at the end.
+//          A node reused while another thread still held it would show
+//          up as a num popped twice and another never popped
+//      Threads peeking at the same time - uses call to TS_Peek() - only
+//          ever see a num that was pushed
+//      Nodes are recycled, so far fewer are allocated than nums pushed
+//      Nothing is left allocated when the stack is deleted
+//  Every num popped twice or never, and every peek at a num that was
+//  never pushed, is an error.  The errors are printed with the number of
+//  nodes allocated, and the exit status is 1 when there were errors or
+//  the stack leaked.
+
+// we use printf from stdio.h
+#include <stdio.h>
+// we use rand_r from stdlib.h, which each thread can call on its own seed
+#include <stdlib.h>
+// the workers are pthreads
+#include <pthread.h>
+// we use the Treiber stack, so include its functions that we can call
+#include "TreiberStack.h"
+
+// The number of threads and the nums each pusher pushes
+#define NUM_PUSHERS        4
+#define NUM_PEEKERS        2
+#define PUSHES_PER_THREAD  200000
+#define NUM_NUMS           (NUM_PUSHERS * PUSHES_PER_THREAD)
+
+// The stack and counts shared by the threads
+static TStack      TheStack;
+static atomic_char Popped[NUM_NUMS];
+static atomic_int  PushersDone;
+static atomic_int  Errors;
+
+// Pusher pushes its own nums, popping one after nearly every push
+static void *Pusher (void *Arg);
+
+// Peeker peeks at the top until the pushers are done
+static void *Peeker (void *Arg);
+
+// CountPop marks a popped num, counting an error if it was popped before
+static void CountPop (UserData D);
+
+int main(int argc, const char * argv[]) {
+    // on its own, the stack gives the UserData back in reverse
+    TheStack = TS_Init();
+    TSHandle Me = TS_Attach (TheStack);
+    UserData D = {0};
+    if (!TS_Empty (TheStack) || TS_Pop (Me, &D) || TS_Peek (Me, &D))
+        atomic_fetch_add (&Errors, 1);
+    for (int loop = 0; loop < 1000; loop++) {
+        D.num = loop;
+        TS_Push (Me, D);
+    }
+    for (int loop = 999; loop >= 0; loop--)
+        if (!TS_Peek (Me, &D) || D.num != loop || !TS_Pop (Me, &D) || D.num != loop)
+            atomic_fetch_add (&Errors, 1);
+    if (!TS_Empty (TheStack))
+        atomic_fetch_add (&Errors, 1);
+    TS_Detach (Me);
+    printf ("One thread: %d errors\n", atomic_load (&Errors));
+
+    pthread_t Threads[NUM_PUSHERS + NUM_PEEKERS];
+    unsigned int Seeds[NUM_PUSHERS + NUM_PEEKERS];
+    printf ("%d threads push and pop %d nums while %d threads peek\n",
+            NUM_PUSHERS, NUM_NUMS, NUM_PEEKERS);
+    int NodesBefore = MA_LiveCount (MA_LIST_NODE);
+    for (int loop = 0; loop < NUM_PUSHERS + NUM_PEEKERS; loop++) {
+        Seeds[loop] = loop;
+        pthread_create (&Threads[loop], NULL, loop < NUM_PUSHERS ? Pusher : Peeker, &Seeds[loop]);
+    }
+    for (int loop = 0; loop < NUM_PUSHERS + NUM_PEEKERS; loop++)
+        pthread_join (Threads[loop], NULL);
+    int NodesAllocated = MA_LiveCount (MA_LIST_NODE) - NodesBefore;
+
+    // pop what is left, then every num has to have been popped once
+    Me = TS_Attach (TheStack);
+    int Left = 0;
+    while (TS_Pop (Me, &D)) {
+        CountPop (D);
+        Left++;
+    }
+    TS_Detach (Me);
+    int NeverPopped = 0;
+    for (int loop = 0; loop < NUM_NUMS; loop++)
+        if (atomic_load (&Popped[loop]) == 0)
+            NeverPopped++;
+    printf ("Left on the stack: %d, never popped: %d, nodes allocated: %d\n",
+            Left, NeverPopped, NodesAllocated);
+    if (NeverPopped != 0 || NodesAllocated >= NUM_NUMS / 4)
+        atomic_fetch_add (&Errors, 1);
+    TheStack = TS_Delete (TheStack);
+
+    printf ("Errors: %d, the allocation count is now %d\n", atomic_load (&Errors), AllocationCount);
+    return (Errors == 0 && AllocationCount == 0) ? 0 : 1;
+}
+
+// function Pusher pushes the nums from its Seed * PUSHES_PER_THREAD up
+// and pops after all but about one push in 16, so the stack grows slowly
+// while its top is fought over
+void *Pusher (void *Arg)
+{
+    unsigned int Seed = *(unsigned int *) Arg;
+    int First = Seed * PUSHES_PER_THREAD;
+    TSHandle Me = TS_Attach (TheStack);
+    for (int loop = 0; loop < PUSHES_PER_THREAD; loop++) {
+        UserData D = {0};
+        D.num = First + loop;
+        TS_Push (Me, D);
+        if (rand_r (&Seed) % 16 != 0 && TS_Pop (Me, &D))
+            CountPop (D);
+    }
+    TS_Detach (Me);
+    atomic_fetch_add (&PushersDone, 1);
+    return NULL;
+}
+
+// function Peeker checks that whatever it sees on top is a num pushed
+void *Peeker (void *Arg)
+{
+    TSHandle Me = TS_Attach (TheStack);
+    while (atomic_load (&PushersDone) < NUM_PUSHERS) {
+        UserData D;
+        if (TS_Peek (Me, &D) && (D.num < 0 || D.num >= NUM_NUMS))
+            atomic_fetch_add (&Errors, 1);
+    }
+    TS_Detach (Me);
+    return NULL;
+}
+
+// function CountPop marks D's num popped
+void CountPop (UserData D)
+{
+    if (D.num < 0 || D.num >= NUM_NUMS || atomic_fetch_add (&Popped[D.num], 1) != 0)
+        atomic_fetch_add (&Errors, 1);
+}
@@ -0,0 +1,210 @@
+//
+//  WorkStealingBenchmark
+//
+//  This program times a depth-first traversal of a binary tree, where
+//  visiting a node does a little work and then hands on its two children.
+//  The tree is the complete one of NUM_NODES nodes, node i having
+//  children 2i + 1 and 2i + 2, so it needs no memory of its own.  It is
+//  traversed
+//      by one thread with a Stack.h stack - push() and pop(), the way a
+//          program without threads would
+//      by the work-stealing pool - each worker pushes and pops its own
+//          deque and only steals when it runs out
+//      by threads sharing one Stack.h stack - push() and pop() with one
+//          mutex around every call, the way a pool without stealing would
+//  with 1 up to MAX_THREADS threads.  Every way of traversing adds up the
+//  same checksum over the nodes, which is checked, and the run reports
+//  the nodes visited a second.  With the shared stack every push and pop
+//  waits for the mutex; with the pool a worker only touches another's
+//  deque when it has nothing left of its own.
+
+// we use printf from stdio.h
+#include <stdio.h>
+// we use clock_gettime from time.h to time the runs by the wall clock
+#include <time.h>
+// sched_yield lets a thread with nothing to do give way
+#include <sched.h>
+// we use the pool and the stack, so include the functions we can call
+#include "Stack.h"
+#include "WorkStealingPool.h"
+
+// The nodes in the tree, the work done visiting each and the most threads
+#define NUM_NODES          (1 << 21)
+#define WORK_PER_NODE      64
+#define MAX_THREADS        8
+
+// Each thread adds up its own checksum, padded so that two threads'
+// checksums are never in the same cache line
+typedef struct {
+    unsigned long Sum;
+    char          Padding[64 - sizeof (unsigned long)];
+} Checksum;
+
+// The checksums, and the stack, mutex and count the shared-stack threads use
+static Checksum        Sums[MAX_THREADS];
+static Stack           TheStack;
+static pthread_mutex_t TheStackMutex = PTHREAD_MUTEX_INITIALIZER;
+static atomic_long     Pending;
+
+// Work returns the value of visiting the node num
+static unsigned long Work (int num);
+
+// PoolVisit visits a node for the pool and spawns its children
+static void PoolVisit (WSPool Pool, int Worker, UserData Node);
+
+// SharedWorker pops nodes off the shared stack and pushes their children
+static void *SharedWorker (void *Arg);
+
+// TimeOneThread, TimePool and TimeSharedStack traverse the tree and return
+// the nodes visited a second, leaving the checksum in *Total
+static double TimeOneThread (unsigned long *Total);
+static double TimePool (int NumThreads, unsigned long *Total);
+static double TimeSharedStack (int NumThreads, unsigned long *Total);
+
+// Seconds returns the wall clock time from Start to End
+static double Seconds (struct timespec Start, struct timespec End);
+
+int main(int argc, const char * argv[]) {
+    unsigned long Expected, Total;
+    printf ("%d nodes, one thread with a stack: %.0f nodes/s\n", NUM_NODES, TimeOneThread (&Expected));
+    printf ("%8s %22s %22s\n", "threads", "work-stealing nodes/s", "shared stack nodes/s");
+    int Mismatches = 0;
+    for (int NumThreads = 1; NumThreads <= MAX_THREADS; NumThreads *= 2) {
+        double PoolRate = TimePool (NumThreads, &Total);
+        Mismatches += (Total != Expected);
+        double SharedRate = TimeSharedStack (NumThreads, &Total);
+        Mismatches += (Total != Expected);
+        printf ("%8d %22.0f %22.0f\n", NumThreads, PoolRate, SharedRate);
+    }
+    if (Mismatches != 0)
+        printf ("%d traversals did not visit every node once\n", Mismatches);
+    printf ("The allocation count is now %d\n", AllocationCount);
+    return 0;
+}
+
+// function Work runs a short xorshift from the node's num
+unsigned long Work (int num)
+{
+    unsigned int x = num + 1;
+    for (int loop = 0; loop < WORK_PER_NODE; loop++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+    }
+    return x;
+}
+
+// function TimeOneThread traverses the tree from a stack, on its own
+double TimeOneThread (unsigned long *Total)
+{
+    struct timespec Start, End;
+    clock_gettime (CLOCK_MONOTONIC, &Start);
+    Stack S = initStack();
+    UserData D = {0};
+    unsigned long Sum = 0;
+    push (S, D);
+    while (!empty (S)) {
+        D = pop (S);
+        Sum += Work (D.num);
+        int Child = 2 * D.num + 1;
+        for (D.num = Child + 1; D.num >= Child; D.num--)
+            if (D.num < NUM_NODES)
+                push (S, D);
+    }
+    S = deleteStack (S);
+    clock_gettime (CLOCK_MONOTONIC, &End);
+    *Total = Sum;
+    return NUM_NODES / Seconds (Start, End);
+}
+
+// function PoolVisit adds the node's work to its worker's checksum and
+// spawns the children
+void PoolVisit (WSPool Pool, int Worker, UserData Node)
+{
+    Sums[Worker].Sum += Work (Node.num);
+    int Child = 2 * Node.num + 1;
+    for (Node.num = Child + 1; Node.num >= Child; Node.num--)
+        if (Node.num < NUM_NODES)
+            WSP_Spawn (Pool, Worker, Node);
+}
+
+// function TimePool traverses the tree with a pool of NumThreads workers
+double TimePool (int NumThreads, unsigned long *Total)
+{
+    for (int loop = 0; loop < NumThreads; loop++)
+        Sums[loop].Sum = 0;
+    struct timespec Start, End;
+    clock_gettime (CLOCK_MONOTONIC, &Start);
+    WSPool Pool = WSP_Init (NumThreads, PoolVisit);
+    UserData Root = {0};
+    WSP_Run (Pool, Root);
+    Pool = WSP_Delete (Pool);
+    clock_gettime (CLOCK_MONOTONIC, &End);
+    *Total = 0;
+    for (int loop = 0; loop < NumThreads; loop++)
+        *Total += Sums[loop].Sum;
+    return NUM_NODES / Seconds (Start, End);
+}
+
+// function SharedWorker pops a node, visits it and pushes its children,
+// holding the mutex for each push and pop.  Pending counts the nodes
+// pushed and not yet visited, so the threads stop when it reaches 0.
+void *SharedWorker (void *Arg)
+{
+    Checksum *Mine = (Checksum *) Arg;
+    for (;;) {
+        pthread_mutex_lock (&TheStackMutex);
+        bool Got = !empty (TheStack);
+        UserData D;
+        if (Got)
+            D = pop (TheStack);
+        pthread_mutex_unlock (&TheStackMutex);
+        if (!Got) {
+            if (atomic_load (&Pending) == 0)
+                return NULL;
+            sched_yield ();
+            continue;
+        }
+        Mine->Sum += Work (D.num);
+        int Child = 2 * D.num + 1;
+        for (D.num = Child + 1; D.num >= Child; D.num--)
+            if (D.num < NUM_NODES) {
+                atomic_fetch_add (&Pending, 1);
+                pthread_mutex_lock (&TheStackMutex);
+                push (TheStack, D);
+                pthread_mutex_unlock (&TheStackMutex);
+            }
+        atomic_fetch_sub (&Pending, 1);
+    }
+}
+
+// function TimeSharedStack traverses the tree with NumThreads threads
+// sharing one stack
+double TimeSharedStack (int NumThreads, unsigned long *Total)
+{
+    pthread_t Threads[MAX_THREADS];
+    for (int loop = 0; loop < NumThreads; loop++)
+        Sums[loop].Sum = 0;
+    struct timespec Start, End;
+    clock_gettime (CLOCK_MONOTONIC, &Start);
+    TheStack = initStack();
+    UserData Root = {0};
+    push (TheStack, Root);
+    atomic_store (&Pending, 1);
+    for (int loop = 0; loop < NumThreads; loop++)
+        pthread_create (&Threads[loop], NULL, SharedWorker, &Sums[loop]);
+    for (int loop = 0; loop < NumThreads; loop++)
+        pthread_join (Threads[loop], NULL);
+    TheStack = deleteStack (TheStack);
+    clock_gettime (CLOCK_MONOTONIC, &End);
+    *Total = 0;
+    for (int loop = 0; loop < NumThreads; loop++)
+        *Total += Sums[loop].Sum;
+    return NUM_NODES / Seconds (Start, End);
+}
+
+// function Seconds converts the time between Start and End to seconds
+double Seconds (struct timespec Start, struct timespec End)
+{
+    return (End.tv_sec - Start.tv_sec) + (End.tv_nsec - Start.tv_nsec) / 1e9;
+}
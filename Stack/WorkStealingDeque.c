@@ -0,0 +1,182 @@
+///////////////////////
+//
+// The work-stealing deque is the one of Chase and Lev, with the C11
+// memory orderings worked out for it by Lê, Pop, Cohen and Zappa Nardelli:
+//      - The owner pushes by writing the slot at Bottom and then moving
+//        Bottom up.  The release fence between the two makes sure a thief
+//        that sees the new Bottom also sees the UserData in the slot.
+//      - A thief reads Top, then Bottom, and if there is a UserData
+//        between them reads it and moves Top up by compare-and-swap.  If
+//        the swap fails, the owner or another thief got there first.
+//      - The owner pops by moving Bottom down first and then reading Top.
+//        The full fence between them makes sure that a thief and the owner
+//        cannot both miss each other's move: if only one UserData is
+//        left, both go for it with a compare-and-swap on Top.
+// Unlike the rest of the code the orderings are not all the default,
+// sequentially consistent one: the point of the deque is that the owner
+// pays for a fence only on a pop, so the orderings used are the weakest
+// the proof allows.
+//
+///////////////////////
+
+// stdlib provides malloc and free
+#include <stdlib.h>
+// assert checks the arguments, like the rest of the stack code
+#include <assert.h>
+// WorkStealingDeque.h defines WSDequeInfo and WSDArray
+#include "WorkStealingDeque.h"
+
+// locally called function declarations follow..
+//
+// MakeArray allocates an array with room for Size UserData
+static WSDArrayPtr MakeArray (long Size);
+
+// Grow copies the UserData from Top to Bottom into an array twice the size
+// of Old and publishes it, returning the new array
+static WSDArrayPtr Grow (WSDeque Q, WSDArrayPtr Old, long Top, long Bottom);
+
+/////////////
+// WSD_Init allocates and initializes an empty deque with its first array.
+// It updates the memory account to reflect the mallocs.
+/////////////
+WSDeque WSD_Init (void)
+{
+    assert ( (WSD_INITIAL_CAPACITY & (WSD_INITIAL_CAPACITY - 1)) == 0 );
+    WSDeque Q = (WSDeque) malloc (sizeof (WSDequeInfo));
+    assert (Q != NULL);
+    atomic_init (&Q->Top, 0);
+    atomic_init (&Q->Bottom, 0);
+    atomic_init (&Q->Array, MakeArray (WSD_INITIAL_CAPACITY));
+    MA_Allocated (MA_STACK_INFO, sizeof (WSDequeInfo));
+    return Q;
+}
+
+/////////////
+// WSD_Delete frees the array in use, every older array and then the deque
+// itself.  No other thread may be using the deque.
+/////////////
+WSDeque WSD_Delete (WSDeque Q)
+{
+    assert (Q != NULL);
+    WSDArrayPtr Array = atomic_load (&Q->Array);
+    while (Array != NULL) {
+        WSDArrayPtr Older = Array->Older;
+        MA_Released (MA_LIST_NODE, sizeof (WSDArray) + Array->Size * sizeof (_Atomic (UserData)));
+        free (Array);
+        Array = Older;
+    }
+    free (Q);
+    MA_Released (MA_STACK_INFO, sizeof (WSDequeInfo));
+    return NULL;
+}
+
+/////////////
+// WSD_Push writes D at Bottom, growing the array first if it is full, and
+// then moves Bottom past it
+/////////////
+void WSD_Push (WSDeque Q, UserData D)
+{
+    assert (Q != NULL);
+    long Bottom = atomic_load_explicit (&Q->Bottom, memory_order_relaxed);
+    long Top = atomic_load_explicit (&Q->Top, memory_order_acquire);
+    WSDArrayPtr Array = atomic_load_explicit (&Q->Array, memory_order_relaxed);
+    if (Bottom - Top > Array->Size - 1)
+        Array = Grow (Q, Array, Top, Bottom);
+    atomic_store_explicit (&Array->Slot[Bottom & (Array->Size - 1)], D, memory_order_relaxed);
+    atomic_thread_fence (memory_order_release);
+    atomic_store_explicit (&Q->Bottom, Bottom + 1, memory_order_relaxed);
+}
+
+/////////////
+// WSD_Pop moves Bottom down to claim the last UserData and then checks
+// Top.  If a thief has taken everything, Bottom goes back; if the claimed
+// UserData is also the last one a thief could take, the owner and the
+// thieves race for it with a compare-and-swap on Top.
+/////////////
+bool WSD_Pop (WSDeque Q, UserData *D)
+{
+    assert ( (Q != NULL) && (D != NULL) );
+    long Bottom = atomic_load_explicit (&Q->Bottom, memory_order_relaxed) - 1;
+    WSDArrayPtr Array = atomic_load_explicit (&Q->Array, memory_order_relaxed);
+    atomic_store_explicit (&Q->Bottom, Bottom, memory_order_relaxed);
+    atomic_thread_fence (memory_order_seq_cst);
+    long Top = atomic_load_explicit (&Q->Top, memory_order_relaxed);
+    if (Top > Bottom) {
+        // it was empty
+        atomic_store_explicit (&Q->Bottom, Bottom + 1, memory_order_relaxed);
+        return false;
+    }
+    *D = atomic_load_explicit (&Array->Slot[Bottom & (Array->Size - 1)], memory_order_relaxed);
+    if (Top < Bottom)
+        return true;
+    // the last one: a thief may be after it too
+    bool Won = atomic_compare_exchange_strong_explicit (&Q->Top, &Top, Top + 1,
+                                                        memory_order_seq_cst, memory_order_relaxed);
+    atomic_store_explicit (&Q->Bottom, Bottom + 1, memory_order_relaxed);
+    return Won;
+}
+
+/////////////
+// WSD_Steal reads Top and then Bottom and, if there is a UserData between
+// them, reads it and tries to move Top past it.  It gives up rather than
+// trying again if another thread moves Top first, so a thief can go and
+// look at another deque instead.
+/////////////
+bool WSD_Steal (WSDeque Q, UserData *D)
+{
+    assert ( (Q != NULL) && (D != NULL) );
+    long Top = atomic_load_explicit (&Q->Top, memory_order_acquire);
+    atomic_thread_fence (memory_order_seq_cst);
+    long Bottom = atomic_load_explicit (&Q->Bottom, memory_order_acquire);
+    if (Top >= Bottom)
+        return false;
+    WSDArrayPtr Array = atomic_load_explicit (&Q->Array, memory_order_acquire);
+    UserData Stolen = atomic_load_explicit (&Array->Slot[Top & (Array->Size - 1)], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit (&Q->Top, &Top, Top + 1,
+                                                  memory_order_seq_cst, memory_order_relaxed))
+        return false;
+    *D = Stolen;
+    return true;
+}
+
+/////////////
+// WSD_Size returns Bottom less Top, or 0 while a pop has Bottom below Top
+/////////////
+long WSD_Size (WSDeque Q)
+{
+    assert (Q != NULL);
+    long Size = atomic_load (&Q->Bottom) - atomic_load (&Q->Top);
+    return (Size > 0) ? Size : 0;
+}
+
+/////////////
+// Local function MakeArray allocates an array of Size slots.
+// It updates the memory account to reflect the malloc.
+/////////////
+WSDArrayPtr MakeArray (long Size)
+{
+    WSDArrayPtr Array = (WSDArrayPtr) malloc (sizeof (WSDArray) + Size * sizeof (_Atomic (UserData)));
+    assert (Array != NULL);
+    Array->Size = Size;
+    Array->Older = NULL;
+    MA_Allocated (MA_LIST_NODE, sizeof (WSDArray) + Size * sizeof (_Atomic (UserData)));
+    return Array;
+}
+
+/////////////
+// Local function Grow copies the UserData into an array twice the size,
+// at the same indices, and publishes it.  Only the owner grows the deque,
+// so the UserData from Top to Bottom cannot change while they are
+// copied; thieves still reading Old find the same UserData there.
+/////////////
+WSDArrayPtr Grow (WSDeque Q, WSDArrayPtr Old, long Top, long Bottom)
+{
+    WSDArrayPtr New = MakeArray (Old->Size * 2);
+    for (long loop = Top; loop < Bottom; loop++)
+        atomic_store_explicit (&New->Slot[loop & (New->Size - 1)],
+                               atomic_load_explicit (&Old->Slot[loop & (Old->Size - 1)], memory_order_relaxed),
+                               memory_order_relaxed);
+    New->Older = Old;
+    atomic_store_explicit (&Q->Array, New, memory_order_release);
+    return New;
+}
@@ -0,0 +1,88 @@
+//
+//  WorkStealingDeque.h
+//
+
+#ifndef WorkStealingDeque_h
+#define WorkStealingDeque_h
+
+// WorkStealingDeque.h declares a Chase-Lev work-stealing deque of
+// UserData.  One thread owns each deque and uses its bottom end as a
+// stack: it pushes and pops there, last in, first out, without locks and
+// almost always without a compare-and-swap.  Any other thread may steal
+// from the top end at the same time, taking the oldest UserData, which in
+// depth-first work is the biggest piece left.  The owner and a thief only
+// compete with a compare-and-swap for the very last UserData.
+//
+//      WSDeque Q = WSD_Init();                 // before the threads
+//      ...
+//      WSD_Push (Q, D);                        // only in the owner
+//      if (WSD_Pop (Q, &D)) ...                // only in the owner
+//      if (WSD_Steal (Q, &D)) ...              // in any other thread
+//      ...
+//      Q = WSD_Delete (Q);                     // after the threads
+
+#include "UserData.h" // The calls on a deque need to pass or return UserData
+#include <stdbool.h> // The pop and steal calls return a boolean
+#include <stdatomic.h> // the ends, the array and its slots are atomics
+// Verifying allocation / deallocation of dynamic memory is done through
+// the memory account, which also provides AllocationCount for reading
+#include "MemoryAccount.h"
+
+// WSD_INITIAL_CAPACITY is the number of UserData the deque first has room
+// for; it doubles each time it fills.  It has to be a power of two
+#ifndef WSD_INITIAL_CAPACITY
+#define WSD_INITIAL_CAPACITY 64
+#endif
+
+/*
+ *The UserData are kept in a ring array.  The array holding index i of the
+ *deque holds it in Slot[i & (Size - 1)].  Each slot is atomic because a
+ *thief may read it while the owner writes it; a thief that does loses its
+ *compare-and-swap and throws what it read away.  When the deque grows,
+ *thieves may still be reading the old array, so it is kept, linked from
+ *Older, until the deque is deleted.  Each array is at most half the size
+ *of the next, so together they take no more room than the newest.
+*/
+typedef struct wsdarray
+{
+    long               Size;
+    struct wsdarray   *Older;
+    _Atomic (UserData) Slot[];
+} WSDArray, *WSDArrayPtr;
+
+/*
+ *This is the layout of a work-stealing deque.  The UserData in it are the
+ *indices from Top up to, but not including, Bottom.  The owner moves
+ *Bottom; thieves, and the owner taking the last UserData, move Top up.
+*/
+typedef struct
+{
+    atomic_long             Top;
+    atomic_long             Bottom;
+    _Atomic (WSDArrayPtr)   Array;
+} WSDequeInfo, *WSDeque;
+
+// WSD_Init() allocates an empty deque
+WSDeque     WSD_Init    (void);
+
+// WSD_Delete() frees the deque and its arrays.  It returns NULL
+WSDeque     WSD_Delete  (WSDeque Q);
+
+// WSD_Push() places the UserData at the bottom.  Only the owner may call it
+void        WSD_Push    (WSDeque Q, UserData D);
+
+// WSD_Pop() takes the UserData at the bottom, the one pushed last, into D
+// and returns true, or returns false if the deque was empty.  Only the
+// owner may call it
+bool        WSD_Pop     (WSDeque Q, UserData *D);
+
+// WSD_Steal() takes the UserData at the top, the oldest one, into D and
+// returns true.  It returns false if the deque was empty or another
+// thread took that UserData first
+bool        WSD_Steal   (WSDeque Q, UserData *D);
+
+// WSD_Size() returns the number of UserData in the deque.  Other threads
+// may change that as soon as it is read
+long        WSD_Size    (WSDeque Q);
+
+#endif /* WorkStealingDeque_h */
@@ -0,0 +1,141 @@
+///////////////////////
+//
+// The work-stealing pool gives each worker thread a work-stealing deque.
+// A worker pops its own deque, newest task first, and runs the task,
+// which spawns its follow-on tasks onto the same deque.  Only when its
+// deque is empty does it look at the others, starting from one picked at
+// random so that idle workers do not all go for the same victim, and
+// steal the oldest task there.  A worker that finds nothing anywhere
+// yields its CPU to the workers that still have tasks.
+//
+// Pending counts every task spawned and not yet finished.  A task's
+// spawns are counted before the task itself is counted off, so Pending
+// can only reach 0 once the last task has finished, which is when the
+// workers stop.
+//
+///////////////////////
+
+// stdlib provides malloc, free and rand_r
+#include <stdlib.h>
+// assert checks the arguments, like the rest of the stack code
+#include <assert.h>
+// sched_yield lets a worker with nothing to do give way
+#include <sched.h>
+// WorkStealingPool.h defines WSPoolInfo
+#include "WorkStealingPool.h"
+
+// A Worker's argument says which pool it works for and which worker it is
+typedef struct {
+    WSPool Pool;
+    int    Worker;
+} WorkerArg;
+
+// locally called function declarations follow..
+//
+// Worker runs tasks from its own deque, or stolen, until none are pending
+static void *Worker (void *Arg);
+
+// StealTask tries each of the other workers' deques once, starting from
+// a random one, and returns true if it stole a task into Task
+static bool StealTask (WSPool Pool, int Thief, unsigned int *Seed, UserData *Task);
+
+/////////////
+// WSP_Init allocates a pool and a deque for each of its workers.
+// It updates the memory account to reflect the malloc.
+/////////////
+WSPool WSP_Init (int NumWorkers, WSPTask Run)
+{
+    assert ( (NumWorkers > 0) && (NumWorkers <= WSP_MAX_WORKERS) && (Run != NULL) );
+    WSPool Pool = (WSPool) malloc (sizeof (WSPoolInfo));
+    assert (Pool != NULL);
+    Pool->NumWorkers = NumWorkers;
+    Pool->Run = Run;
+    for (int loop = 0; loop < NumWorkers; loop++)
+        Pool->Deque[loop] = WSD_Init();
+    atomic_init (&Pool->Pending, 0);
+    MA_Allocated (MA_STACK_INFO, sizeof (WSPoolInfo));
+    return Pool;
+}
+
+/////////////
+// WSP_Delete frees the workers' deques and then the pool
+/////////////
+WSPool WSP_Delete (WSPool Pool)
+{
+    assert ( (Pool != NULL) && (atomic_load (&Pool->Pending) == 0) );
+    for (int loop = 0; loop < Pool->NumWorkers; loop++)
+        Pool->Deque[loop] = WSD_Delete (Pool->Deque[loop]);
+    free (Pool);
+    MA_Released (MA_STACK_INFO, sizeof (WSPoolInfo));
+    return NULL;
+}
+
+/////////////
+// WSP_Run puts Root on the first worker's deque before any worker is
+// started, then starts them all and waits for them to stop
+/////////////
+void WSP_Run (WSPool Pool, UserData Root)
+{
+    assert ( (Pool != NULL) && (atomic_load (&Pool->Pending) == 0) );
+    WorkerArg Args[WSP_MAX_WORKERS];
+    atomic_store (&Pool->Pending, 1);
+    WSD_Push (Pool->Deque[0], Root);
+    for (int loop = 0; loop < Pool->NumWorkers; loop++) {
+        Args[loop].Pool = Pool;
+        Args[loop].Worker = loop;
+        pthread_create (&Pool->Threads[loop], NULL, Worker, &Args[loop]);
+    }
+    for (int loop = 0; loop < Pool->NumWorkers; loop++)
+        pthread_join (Pool->Threads[loop], NULL);
+}
+
+/////////////
+// WSP_Spawn counts the task as pending and pushes it on the worker's deque
+/////////////
+void WSP_Spawn (WSPool Pool, int Worker, UserData Task)
+{
+    assert ( (Pool != NULL) && (Worker >= 0) && (Worker < Pool->NumWorkers) );
+    atomic_fetch_add (&Pool->Pending, 1);
+    WSD_Push (Pool->Deque[Worker], Task);
+}
+
+/////////////
+// Local function Worker takes a task from its own deque or, failing that,
+// from another worker's, runs it and counts it off.  With no task to be
+// had it stops if none are pending and yields if some still are.
+/////////////
+void *Worker (void *Arg)
+{
+    WSPool Pool = ((WorkerArg *) Arg)->Pool;
+    int Me = ((WorkerArg *) Arg)->Worker;
+    unsigned int Seed = Me + 1;
+    for (;;) {
+        UserData Task;
+        if (WSD_Pop (Pool->Deque[Me], &Task) || StealTask (Pool, Me, &Seed, &Task)) {
+            Pool->Run (Pool, Me, Task);
+            atomic_fetch_sub (&Pool->Pending, 1);
+        }
+        else if (atomic_load (&Pool->Pending) == 0)
+            return NULL;
+        else
+            sched_yield ();
+    }
+}
+
+/////////////
+// Local function StealTask goes round the other workers once from a
+// random starting point
+/////////////
+bool StealTask (WSPool Pool, int Thief, unsigned int *Seed, UserData *Task)
+{
+    int NumWorkers = Pool->NumWorkers;
+    if (NumWorkers == 1)
+        return false;
+    int First = rand_r (Seed) % NumWorkers;
+    for (int loop = 0; loop < NumWorkers; loop++) {
+        int Victim = (First + loop) % NumWorkers;
+        if (Victim != Thief && WSD_Steal (Pool->Deque[Victim], Task))
+            return true;
+    }
+    return false;
+}
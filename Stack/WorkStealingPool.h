@@ -0,0 +1,65 @@
+//
+//  WorkStealingPool.h
+//
+
+#ifndef WorkStealingPool_h
+#define WorkStealingPool_h
+
+// WorkStealingPool.h declares a small work-stealing executor.  A pool runs
+// tasks, each described by a UserData, on a fixed number of worker threads.
+// A task may spawn more tasks, which go on its own worker's deque, so a
+// worker goes depth first through its own work the way a program using a
+// Stack would.  A worker with nothing left steals the oldest task from
+// another worker's deque, which in a recursive workload is the root of the
+// biggest subtree still waiting.
+//
+//      void Visit (WSPool Pool, int Worker, UserData Task)
+//      {
+//          ...                                  // do the work for Task
+//          WSP_Spawn (Pool, Worker, Child);     // for each piece of it left
+//      }
+//      ...
+//      WSPool Pool = WSP_Init (NumWorkers, Visit);
+//      WSP_Run (Pool, Root);                    // returns when all is done
+//      Pool = WSP_Delete (Pool);
+
+#include "UserData.h" // Tasks are described by UserData
+#include <pthread.h> // the workers are pthreads
+#include "WorkStealingDeque.h" // each worker keeps its tasks in a deque
+
+// WSP_MAX_WORKERS is the most worker threads a pool may have
+#define WSP_MAX_WORKERS 64
+
+// A WSPTask runs one task on the worker numbered Worker
+typedef struct wspoolinfo *WSPool;
+typedef void (*WSPTask) (WSPool Pool, int Worker, UserData Task);
+
+/*
+ *This is the layout of a pool.  Deque[w] holds the tasks waiting on
+ *worker w.  Pending counts the tasks spawned and not yet finished; the
+ *workers stop when it reaches 0.
+*/
+typedef struct wspoolinfo
+{
+    int          NumWorkers;
+    WSPTask      Run;
+    WSDeque      Deque[WSP_MAX_WORKERS];
+    atomic_long  Pending;
+    pthread_t    Threads[WSP_MAX_WORKERS];
+} WSPoolInfo;
+
+// WSP_Init() allocates a pool of NumWorkers workers that run tasks with Run
+WSPool      WSP_Init    (int NumWorkers, WSPTask Run);
+
+// WSP_Delete() frees the pool.  It returns NULL
+WSPool      WSP_Delete  (WSPool Pool);
+
+// WSP_Run() starts the workers on the task Root and returns once Root and
+// every task spawned from it have finished
+void        WSP_Run     (WSPool Pool, UserData Root);
+
+// WSP_Spawn() adds the task described by Task to the deque of the worker
+// numbered Worker.  It may only be called from a task running on that worker
+void        WSP_Spawn   (WSPool Pool, int Worker, UserData Task);
+
+#endif /* WorkStealingPool_h */
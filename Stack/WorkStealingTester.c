@@ -0,0 +1,152 @@
+//
+//  WorkStealingTester
+//
+//  This is a stress test of the work-stealing deque and the pool built on
+//  it.  It checks that:
+//      The owner on its own gets the UserData back last in, first out and
+//          a thief gets them first in, first out - uses calls to
+//          WSD_Push(), WSD_Pop(), WSD_Steal() and WSD_Size()
+//      While the owner pushes nums, growing the array many times, and
+//          pops some of them back, thieves stealing at the same time -
+//          uses calls to WSD_Push(), WSD_Pop() and WSD_Steal() - take
+//          every num exactly once between them
+//      A pool visiting a tree of tasks - uses calls to WSP_Run() and
+//          WSP_Spawn() - runs each task exactly once, for every number
+//          of workers
+//      Nothing is left allocated when the deque and pools are deleted
+//  A num or task taken twice, or never, or out of order on one thread,
+//  adds to the error count printed at the end; any error, or anything
+//  still allocated, makes the exit status 1.
+
+// we use printf from stdio.h
+#include <stdio.h>
+// we use rand_r from stdlib.h, which each thread can call on its own seed
+#include <stdlib.h>
+// the thieves are pthreads
+#include <pthread.h>
+// we use the deque and the pool, so include the functions we can call
+#include "WorkStealingDeque.h"
+#include "WorkStealingPool.h"
+
+// The thieves, the nums the owner pushes and the tasks in the tree
+#define NUM_THIEVES  3
+#define NUM_NUMS     1000000
+#define NUM_TASKS    200000
+
+// The deque, the counts shared by the threads and the tasks run
+static WSDeque     TheDeque;
+static atomic_char Taken[NUM_NUMS];
+static atomic_char Run[NUM_TASKS];
+static atomic_bool OwnerDone;
+static atomic_int  Errors;
+
+// Thief steals from the deque until the owner is done and it is empty
+static void *Thief (void *Arg);
+
+// CountTake marks a num taken, counting an error if it was taken before
+static void CountTake (UserData D, atomic_char *Counts, int NumCounts);
+
+// VisitTask marks its task run and spawns the task's children in a tree
+// of NUM_TASKS tasks, where task i has children 2i + 1 and 2i + 2
+static void VisitTask (WSPool Pool, int Worker, UserData Task);
+
+int main(int argc, const char * argv[]) {
+    // on its own, the owner's end is a stack and the thief's a queue
+    TheDeque = WSD_Init();
+    UserData D = {0};
+    if (WSD_Pop (TheDeque, &D) || WSD_Steal (TheDeque, &D))
+        atomic_fetch_add (&Errors, 1);
+    for (int loop = 0; loop < 1000; loop++) {
+        D.num = loop;
+        WSD_Push (TheDeque, D);
+    }
+    if (WSD_Size (TheDeque) != 1000)
+        atomic_fetch_add (&Errors, 1);
+    for (int loop = 0; loop < 500; loop++) {
+        if (!WSD_Pop (TheDeque, &D) || D.num != 999 - loop)
+            atomic_fetch_add (&Errors, 1);
+        if (!WSD_Steal (TheDeque, &D) || D.num != loop)
+            atomic_fetch_add (&Errors, 1);
+    }
+    if (WSD_Size (TheDeque) != 0 || WSD_Pop (TheDeque, &D))
+        atomic_fetch_add (&Errors, 1);
+    printf ("One thread: %d errors\n", atomic_load (&Errors));
+
+    // the owner pushes every num, popping about one in four back, while
+    // the thieves steal
+    pthread_t Threads[NUM_THIEVES];
+    printf ("The owner pushes %d nums while %d threads steal\n", NUM_NUMS, NUM_THIEVES);
+    for (int loop = 0; loop < NUM_THIEVES; loop++)
+        pthread_create (&Threads[loop], NULL, Thief, NULL);
+    unsigned int Seed = 1;
+    int Popped = 0;
+    for (int loop = 0; loop < NUM_NUMS; loop++) {
+        D.num = loop;
+        WSD_Push (TheDeque, D);
+        if (rand_r (&Seed) % 4 == 0 && WSD_Pop (TheDeque, &D)) {
+            CountTake (D, Taken, NUM_NUMS);
+            Popped++;
+        }
+    }
+    atomic_store (&OwnerDone, true);
+    for (int loop = 0; loop < NUM_THIEVES; loop++)
+        pthread_join (Threads[loop], NULL);
+    int NeverTaken = 0;
+    for (int loop = 0; loop < NUM_NUMS; loop++)
+        if (atomic_load (&Taken[loop]) == 0)
+            NeverTaken++;
+    printf ("Popped by the owner: %d, stolen: %d, never taken: %d\n",
+            Popped, NUM_NUMS - Popped - NeverTaken, NeverTaken);
+    if (NeverTaken != 0)
+        atomic_fetch_add (&Errors, 1);
+    TheDeque = WSD_Delete (TheDeque);
+
+    // a pool of each size runs every task of the tree once
+    for (int NumWorkers = 1; NumWorkers <= 4; NumWorkers++) {
+        for (int loop = 0; loop < NUM_TASKS; loop++)
+            atomic_store (&Run[loop], 0);
+        WSPool Pool = WSP_Init (NumWorkers, VisitTask);
+        D.num = 0;
+        WSP_Run (Pool, D);
+        Pool = WSP_Delete (Pool);
+        int NeverRun = 0;
+        for (int loop = 0; loop < NUM_TASKS; loop++)
+            if (atomic_load (&Run[loop]) == 0)
+                NeverRun++;
+        printf ("%d workers: %d of %d tasks never run\n", NumWorkers, NeverRun, NUM_TASKS);
+        if (NeverRun != 0)
+            atomic_fetch_add (&Errors, 1);
+    }
+
+    printf ("Errors: %d, the allocation count is now %d\n", atomic_load (&Errors), AllocationCount);
+    return (Errors == 0 && AllocationCount == 0) ? 0 : 1;
+}
+
+// function Thief steals until the owner has finished pushing and the
+// deque is empty
+void *Thief (void *Arg)
+{
+    UserData D;
+    while (!atomic_load (&OwnerDone) || WSD_Size (TheDeque) > 0)
+        if (WSD_Steal (TheDeque, &D))
+            CountTake (D, Taken, NUM_NUMS);
+    return NULL;
+}
+
+// function CountTake marks D's num in Counts
+void CountTake (UserData D, atomic_char *Counts, int NumCounts)
+{
+    if (D.num < 0 || D.num >= NumCounts || atomic_fetch_add (&Counts[D.num], 1) != 0)
+        atomic_fetch_add (&Errors, 1);
+}
+
+// function VisitTask runs task i by marking it and spawning its children
+void VisitTask (WSPool Pool, int Worker, UserData Task)
+{
+    CountTake (Task, Run, NUM_TASKS);
+    for (int Child = 2 * Task.num + 1; Child <= 2 * Task.num + 2 && Child < NUM_TASKS; Child++) {
+        UserData D = {0};
+        D.num = Child;
+        WSP_Spawn (Pool, Worker, D);
+    }
+}